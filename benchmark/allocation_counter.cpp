@@ -0,0 +1,26 @@
+#include <benchmark.hpp>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+   // counts allocations made by the calling thread; the benchmark binary is the only user of these replacements
+   thread_local uint64_t thread_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+   ++thread_allocations;
+   if (void* p = std::malloc(size ? size : 1))
+      return p;
+   throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace sysio::benchmark {
+
+uint64_t get_thread_allocations() {
+   return thread_allocations;
+}
+
+} // namespace sysio::benchmark
@@ -1,6 +1,7 @@
 #include <fc/crypto/private_key.hpp>
 #include <sysio/chain/authority.hpp>
 #include <sysio/chain/authority_checker.hpp>
+#include <sysio/chain/authority_check_cache.hpp>
 
 #include <benchmark.hpp>
 
@@ -183,6 +184,19 @@ void auth_benchmarking() {
          auto checker = make_auth_checker(get_auth, 4, provided);
          checker.satisfied(auth);
       });
+
+      // Same check answered by authorization_manager's check cache, as for repeated transactions from one signer
+      authority_check_cache cache;
+      const permission_level alice_active{name("alice"), name("active")};
+      const flat_set<permission_level> no_permissions;
+      cache.store_satisfied(alice_active, 4, provided, no_permissions,
+                            authority_check_cache::hash_provided(provided, no_permissions), provided);
+
+      benchmarking("auth_recursive_3_level_cached", [&]() {
+         flat_set<fc::crypto::public_key> used_keys;
+         const size_t provided_hash = authority_check_cache::hash_provided(provided, no_permissions);
+         cache.find_satisfied(alice_active, 4, provided, no_permissions, provided_hash, used_keys);
+      });
    }
 }
 
@@ -17,7 +17,13 @@ std::map<std::string, std::function<void()>> features {
    { "blake2", blake2_benchmarking },
    { "bls", bls_benchmarking },
    { "merkle", merkle_benchmarking },
-   { "auth", auth_benchmarking }
+   { "auth", auth_benchmarking },
+   { "ingress", ingress_benchmarking },
+   { "histogram", histogram_benchmarking },
+   { "block_unpack", block_unpack_benchmarking },
+   { "json", json_benchmarking },
+   { "block_to_variant", block_to_variant_benchmarking },
+   { "raw_pack", raw_pack_benchmarking }
 };
 
 // values to control cout format
@@ -16,6 +16,8 @@ uint32_t get_num_runs();
 std::map<std::string, std::function<void()>> get_features();
 void print_header();
 bytes to_bytes(const std::string& source);
+/// allocations made so far by the calling thread
+uint64_t get_thread_allocations();
 
 void alt_bn_128_benchmarking();
 void modexp_benchmarking();
@@ -25,6 +27,12 @@ void blake2_benchmarking();
 void bls_benchmarking();
 void merkle_benchmarking();
 void auth_benchmarking();
+void ingress_benchmarking();
+void histogram_benchmarking();
+void block_unpack_benchmarking();
+void json_benchmarking();
+void block_to_variant_benchmarking();
+void raw_pack_benchmarking();
 
 void benchmarking(const std::string& name, const std::function<void()>& func, std::optional<size_t> num_runs = {});
 
@@ -0,0 +1,78 @@
+#include <sysio/chain/abi_serializer.hpp>
+#include <sysio/chain/asset.hpp>
+#include <sysio/chain/block.hpp>
+
+#include <fc/crypto/private_key.hpp>
+
+#include <benchmark.hpp>
+
+#include <iostream>
+
+using namespace sysio::chain;
+
+namespace sysio::benchmark {
+
+namespace {
+   const fc::microseconds max_serialization_time = fc::seconds(10);
+
+   abi_def token_abi() {
+      abi_def abi;
+      abi.version = "sysio::abi/1.2";
+      abi.structs.emplace_back("transfer", "", vector<field_def>{
+         {"from", "name"}, {"to", "name"}, {"quantity", "asset"}, {"memo", "string"}});
+      abi.actions.emplace_back("transfer"_n, "transfer", "");
+      return abi;
+   }
+
+   // a block of num_trxs signed sysio.token transfers, as get_block converts it
+   signed_block_ptr make_transfer_block(const abi_serializer& token, uint32_t num_trxs) {
+      const auto key      = fc::crypto::private_key::generate();
+      const auto chain_id = chain_id_type::empty_chain_id();
+
+      mutable_block_ptr b = signed_block::create_mutable_block(signed_block_header{});
+      for (uint32_t i = 0; i < num_trxs; ++i) {
+         const auto data = token.variant_to_binary("transfer", fc::mutable_variant_object()
+            ("from", "alice")
+            ("to", "bob")
+            ("quantity", asset(10000 + i).to_string())
+            ("memo", "invoice " + std::to_string(i)),
+            max_serialization_time);
+
+         signed_transaction trx;
+         trx.expiration = fc::time_point_sec{fc::time_point::now() + fc::seconds(60)};
+         trx.actions.emplace_back(vector<permission_level>{{"alice"_n, config::active_name}},
+                                  "sysio.token"_n, "transfer"_n, data);
+         trx.sign(key, chain_id);
+         auto& r = b->transactions.emplace_back(packed_transaction(std::move(trx)));
+         r.cpu_usage_us = {fc::unsigned_int(100 + i % 50)};
+      }
+      return signed_block::create_signed_block(std::move(b));
+   }
+
+   void benchmark_block(uint32_t num_trxs) {
+      abi_serializer_cache_t serializers;
+      serializers.emplace("sysio.token"_n, abi_serializer(token_abi(), max_serialization_time));
+      const abi_resolver resolver(std::move(serializers));
+      const abi_serializer& token = resolver("sysio.token"_n)->get();
+      const signed_block_ptr block = make_transfer_block(token, num_trxs);
+      const uint32_t runs = std::max(1u, get_num_runs() / 10);
+
+      uint64_t allocations = 0;
+      benchmarking("signed_block to_variant, " + std::to_string(num_trxs) + " transfers", [&]() {
+         const uint64_t before = get_thread_allocations();
+         fc::variant v;
+         abi_serializer::to_variant(*block, v, resolver, max_serialization_time);
+         allocations = get_thread_allocations() - before;
+      }, runs);
+      std::cout << "   " << allocations << " allocations per block, "
+                << (num_trxs ? allocations / num_trxs : 0) << " per trx" << std::endl;
+   }
+}
+
+void block_to_variant_benchmarking() {
+   benchmark_block(1);
+   benchmark_block(100);
+   benchmark_block(2000);
+}
+
+} // namespace sysio::benchmark
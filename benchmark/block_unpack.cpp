@@ -0,0 +1,61 @@
+#include <sysio/chain/block.hpp>
+
+#include <fc/crypto/private_key.hpp>
+#include <fc/io/raw.hpp>
+
+#include <benchmark.hpp>
+
+#include <iostream>
+
+using namespace sysio::chain;
+
+namespace sysio::benchmark {
+
+namespace {
+   // a block of num_trxs transfer-sized trxs, one action and one signature each, as received from the network
+   bytes make_packed_block(uint32_t num_trxs) {
+      const auto key      = fc::crypto::private_key::generate();
+      const auto chain_id = chain_id_type::empty_chain_id();
+
+      mutable_block_ptr b = signed_block::create_mutable_block(signed_block_header{});
+      for (uint32_t i = 0; i < num_trxs; ++i) {
+         signed_transaction trx;
+         trx.expiration = fc::time_point_sec{fc::time_point::now() + fc::seconds(60)};
+         trx.actions.emplace_back(vector<permission_level>{{"alice"_n, config::active_name}},
+                                  "sysio.token"_n, "transfer"_n, bytes(40 + i % 24, static_cast<char>(i)));
+         trx.sign(key, chain_id);
+         auto& r = b->transactions.emplace_back(packed_transaction(std::move(trx)));
+         r.cpu_usage_us = {fc::unsigned_int(100 + i % 50)};
+      }
+      return signed_block::create_signed_block(std::move(b))->packed_signed_block();
+   }
+
+   // Per trx, unpacking allocates the signature and packed_trx vectors of the packed_transaction, then for its
+   // unpacked copy the action and authorization vectors, every action's data and a copy of the signatures. An
+   // arena or views into the block buffer would remove these, but action::data and the transaction vectors are
+   // plain vectors shared with the ABI serializer, state history, trace_api and the host functions, so that is a
+   // type change across the tree; this only measures them.
+   void benchmark_unpack(uint32_t num_trxs) {
+      const bytes packed = make_packed_block(num_trxs);
+      const uint32_t runs = std::max(1u, get_num_runs() / 10);
+
+      uint64_t allocations = 0;
+      benchmarking("signed_block unpack, " + std::to_string(num_trxs) + " trxs", [&]() {
+         const uint64_t before = get_thread_allocations();
+         signed_block block;
+         fc::datastream<const char*> ds(packed.data(), packed.size());
+         fc::raw::unpack(ds, block);
+         allocations = get_thread_allocations() - before;
+      }, runs);
+      std::cout << "   " << allocations << " allocations per block, "
+                << (num_trxs ? allocations / num_trxs : 0) << " per trx, " << packed.size() << " bytes" << std::endl;
+   }
+}
+
+void block_unpack_benchmarking() {
+   benchmark_unpack(1);
+   benchmark_unpack(100);
+   benchmark_unpack(2000);
+}
+
+} // namespace sysio::benchmark
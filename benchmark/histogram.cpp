@@ -0,0 +1,80 @@
+#include <benchmark.hpp>
+
+#include <fc/crypto/sha256.hpp>
+#include <fc/latency_histogram.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sysio::benchmark {
+
+namespace {
+   constexpr uint32_t values_per_thread = 1'000'000;
+
+   // spread of values across the buckets a block phase or http request lands in
+   uint64_t sample_ns(uint32_t i) {
+      return (uint64_t{i} * 2654435761u) % 50'000'000;
+   }
+
+   template <typename Record>
+   void run_threads(uint32_t threads, Record&& record) {
+      std::vector<std::thread> ts;
+      ts.reserve(threads);
+      for (uint32_t t = 0; t < threads; ++t) {
+         ts.emplace_back([&]() {
+            for (uint32_t i = 0; i < values_per_thread; ++i)
+               record(sample_ns(i));
+         });
+      }
+      for (auto& t : ts)
+         t.join();
+   }
+
+   void benchmark_record(uint32_t threads) {
+      const uint32_t runs = std::max(1u, get_num_runs() / 100);
+      const auto suffix = std::to_string(threads) + " threads, 1M values each";
+
+      // naive alternative: one set of counters shared by every thread
+      benchmarking("shared atomic buckets, " + suffix, [&]() {
+         static std::array<std::atomic<uint64_t>, fc::latency_histogram::bucket_count> counts{};
+         static std::atomic<uint64_t> sum{0};
+         run_threads(threads, [](uint64_t ns) {
+            counts[fc::latency_histogram::bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(ns, std::memory_order_relaxed);
+         });
+      }, runs);
+
+      fc::latency_histogram h("benchmark_record_seconds", "benchmark");
+      benchmarking("latency_histogram record, " + suffix, [&]() {
+         run_threads(threads, [&](uint64_t ns) { h.record(ns); });
+      }, runs);
+   }
+}
+
+void histogram_benchmarking() {
+   benchmark_record(1);
+   benchmark_record(4);
+   benchmark_record(16);
+
+   // overhead of a scoped_timer around a small unit of work; a trx apply or http request is far larger
+   std::vector<char> data(1024, 'a');
+   benchmarking("sha256 1KB", [&]() {
+      fc::sha256::hash(data.data(), data.size());
+   });
+   fc::latency_histogram h("benchmark_timer_seconds", "benchmark");
+   benchmarking("sha256 1KB with scoped_timer", [&]() {
+      fc::latency_histogram::scoped_timer t(h);
+      fc::sha256::hash(data.data(), data.size());
+   });
+
+   fc::latency_histogram big("benchmark_snapshot_seconds", "benchmark");
+   run_threads(4, [&](uint64_t ns) { big.record(ns); });
+   benchmarking("latency_histogram snapshot, 4 shards", [&]() {
+      big.snapshot();
+   });
+}
+
+} // namespace sysio::benchmark
@@ -0,0 +1,112 @@
+#include <benchmark.hpp>
+#include <sysio/chain/exec_pri_queue.hpp>
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace sysio::benchmark {
+
+using appbase::exec_pri_queue;
+using appbase::exec_queue;
+using appbase::handler_id;
+
+// Stand-in for producer_plugin's trx_executor: a few pointers of state and a trivial body, so the numbers are
+// the cost of moving trxs from the recovering threads to the main thread.
+struct fake_trx {
+   std::shared_ptr<int>     meta;
+   std::atomic<uint64_t>*   executed = nullptr;
+   bool                     api_trx = false;
+   void operator()() { executed->fetch_add(1, std::memory_order_relaxed); }
+};
+
+// the submission path exec_pri_queue had before handler pooling: one mutex, std::function handlers
+struct function_queue {
+   struct entry {
+      int                   priority;
+      size_t                order;
+      std::function<void()> f;
+      bool operator<(const entry& o) const { return priority < o.priority || (priority == o.priority && order < o.order); }
+   };
+   std::mutex                 mtx;
+   std::priority_queue<entry> que;
+
+   void push(int priority, size_t order, std::function<void()> f) {
+      std::scoped_lock g(mtx);
+      que.push(entry{priority, order, std::move(f)});
+   }
+   void execute_highest_locked(exec_queue) {
+      std::unique_lock g(mtx);
+      if (que.empty())
+         return;
+      auto f = std::move(que.top().f);
+      que.pop();
+      g.unlock();
+      f();
+   }
+};
+
+// producer threads push num_trxs trxs at a spread of priorities while the calling thread drains them as
+// the main thread does, one highest-priority trx at a time.
+template <typename Queue, typename Push>
+void run_ingress(uint32_t producers, uint32_t num_trxs, Queue& que, Push&& push) {
+   std::atomic<uint64_t> executed{0};
+   std::atomic<size_t>   order{std::numeric_limits<size_t>::max()};
+   std::vector<std::thread> threads;
+   threads.reserve(producers);
+   for (uint32_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p]() {
+         auto meta = std::make_shared<int>(0);
+         for (uint32_t i = p; i < num_trxs; i += producers)
+            push(que, static_cast<int>(i % 4), --order, fake_trx{meta, &executed, (i & 1) != 0});
+      });
+   }
+   while (executed.load(std::memory_order_relaxed) < num_trxs)
+      que.execute_highest_locked(exec_queue::trx_read_write);
+   for (auto& t : threads)
+      t.join();
+}
+
+void benchmark_ingress(uint32_t producers) {
+   constexpr uint32_t num_trxs = 100'000;
+   const uint32_t runs = std::max(1u, get_num_runs() / 100);
+   const auto suffix = std::to_string(producers) + " producers, 100k trxs";
+
+   // original path: every push takes a mutex and heap allocates a std::function
+   benchmarking("ingress std::function heap, " + suffix, [&]() {
+      function_queue que;
+      run_ingress(producers, num_trxs, que, [](function_queue& q, int pri, size_t order, fake_trx&& t) {
+         q.push(pri, order, std::move(t));
+      });
+   }, runs);
+
+   // previous path: every push takes the queue mutex and inserts into the heap
+   benchmarking("ingress locked heap, " + suffix, [&]() {
+      exec_pri_queue que;
+      run_ingress(producers, num_trxs, que, [](exec_pri_queue& q, int pri, size_t order, fake_trx&& t) {
+         q.add(handler_id::unique, pri, exec_queue::trx_read_write, order, std::move(t));
+      });
+   }, runs);
+
+   // admission list: lock-free push, merged into the heap in batches by the consumer
+   benchmarking("ingress admission, " + suffix, [&]() {
+      exec_pri_queue que;
+      run_ingress(producers, num_trxs, que, [](exec_pri_queue& q, int pri, size_t order, fake_trx&& t) {
+         q.admit(exec_queue::trx_read_write, pri, order, std::move(t));
+      });
+   }, runs);
+}
+
+void ingress_benchmarking() {
+   benchmark_ingress(1);
+   benchmark_ingress(4);
+   benchmark_ingress(16);
+   benchmark_ingress(32);
+}
+
+} // namespace sysio::benchmark
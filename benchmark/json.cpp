@@ -0,0 +1,58 @@
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include <benchmark.hpp>
+
+using namespace fc;
+
+namespace sysio::benchmark {
+
+namespace {
+   // body of a /v1/chain/send_transaction2 request carrying a transfer
+   std::string send_transaction_body() {
+      return json::to_string(mutable_variant_object()
+         ("return_failure_trace", true)
+         ("retry_trx", false)
+         ("transaction", mutable_variant_object()
+            ("signatures", variants{"SIG_K1_KfQ57wLFEZgLYdbxQxZnuZFtWbGGCCqRuxyWnbYqqyCERz4CVGxbJczuumyYrU6e6ipFqeBTTDLG2L8dFgD5BbtzuBtpxR"})
+            ("compression", "none")
+            ("packed_context_free_data", "")
+            ("packed_trx", std::string(2 * 146, 'a'))),
+         fc::time_point::maximum());
+   }
+
+   // /v1/chain/get_table_rows response with num_rows token balance rows, with memo-like free text
+   std::string get_table_rows_response(uint32_t num_rows) {
+      variants rows;
+      for (uint32_t i = 0; i < num_rows; ++i) {
+         rows.emplace_back(mutable_variant_object()
+            ("owner", "account" + std::to_string(i))
+            ("balance", std::to_string(i) + ".0000 SYS")
+            ("memo", "payment for invoice #" + std::to_string(i) + ", \"net 30\" terms\nthank you")
+            ("last_claim", "2026-01-01T00:00:00.000"));
+      }
+      return json::to_string(mutable_variant_object()("rows", std::move(rows))("more", false)("next_key", ""),
+                             fc::time_point::maximum());
+   }
+
+   void benchmark_payload(const std::string& name, const std::string& json_str) {
+      const variant v = json::from_string(json_str);
+      benchmarking("json parse " + name + " (" + std::to_string(json_str.size()) + " bytes)", [&]() {
+         json::from_string(json_str);
+      });
+      benchmarking("json write " + name + " (" + std::to_string(json_str.size()) + " bytes)", [&]() {
+         json::to_string(v, fc::time_point::maximum());
+      });
+   }
+}
+
+void json_benchmarking() {
+   benchmark_payload("send_transaction", send_transaction_body());
+   benchmark_payload("get_table_rows 10", get_table_rows_response(10));
+   benchmark_payload("get_table_rows 1000", get_table_rows_response(1000));
+
+   const std::string long_string = "\"" + std::string(64 * 1024, 'x') + "\"";
+   benchmark_payload("64KiB string", long_string);
+}
+
+} // namespace sysio::benchmark
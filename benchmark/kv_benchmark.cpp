@@ -2,8 +2,10 @@
 
 #include <chainbase/chainbase.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_context.hpp>
 
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
@@ -259,4 +261,138 @@ BOOST_AUTO_TEST_CASE(full_intrinsic_path_benchmark) {
    std::cout << "=================================================\n\n";
 }
 
+// Host-side work of reading N consecutive rows: per-row kv_it_next + kv_it_key + kv_it_value (each call re-finds
+// the current row by cached id) versus one kv_it_read_batch that walks the index once and packs into a buffer.
+// WASM->host transition cost is not included; it adds to the per-row column only.
+BOOST_AUTO_TEST_CASE(batched_read_path_benchmark) {
+   temp_db_dir dir;
+   chainbase::database db(dir.path, chainbase::database::read_write, 1024 * 1024 * 256);
+
+   db.add_index<kv_index>();
+
+   std::mt19937 rng(42);
+   auto value = random_bytes(rng, 128);
+
+   const int N = 10000;
+   const int batch = 64;
+   auto session = db.start_undo_session(true);
+   for (int i = 0; i < N; ++i) {
+      char key_buf[8];
+      uint64_t k = static_cast<uint64_t>(i);
+      for (int j = 7; j >= 0; --j) { key_buf[j] = static_cast<char>(k & 0xFF); k >>= 8; }
+      db.create<kv_object>([&](auto& o) {
+         o.code = "kvbench"_n;
+         o.key.assign(key_buf, 8);
+         o.value.assign(value.data(), value.size());
+      });
+   }
+
+   auto& kv_idx = db.get_index<kv_index, by_code_key>();
+   std::vector<char> dest(batch * (8 + 8 + value.size()));
+
+   std::cout << "\n===== KV Batched Read Path Benchmark =====\n";
+   std::cout << std::left << std::setw(25) << "Operation"
+             << std::setw(10) << "Rows"
+             << std::setw(15) << "ns/row" << "\n";
+   std::cout << std::string(50, '-') << "\n";
+
+   double per_row = measure_ns([&](int) {
+      auto itr = kv_idx.lower_bound(boost::make_tuple(name("kvbench"), uint16_t(0)));
+      int64_t cached_id = itr->id._id;
+      for (int r = 0; r < N; ++r) {
+         // kv_it_key and kv_it_value: each re-finds the current row
+         for (int call = 0; call < 2; ++call) {
+            const auto* obj = db.find<kv_object>(kv_object::id_type(cached_id));
+            BOOST_REQUIRE(obj);
+            memcpy(dest.data(), call == 0 ? obj->key.data() : obj->value.data(), call == 0 ? obj->key.size() : obj->value.size());
+         }
+         // kv_it_next: re-find, advance, remember the new row
+         const auto* obj = db.find<kv_object>(kv_object::id_type(cached_id));
+         auto next = kv_idx.iterator_to(*obj);
+         ++next;
+         if (next == kv_idx.end()) break;
+         cached_id = next->id._id;
+      }
+   }, 1);
+
+   std::cout << std::setw(25) << "Per-row intrinsics"
+             << std::setw(10) << N
+             << std::setw(15) << fmt_ns(per_row / N) << "\n";
+
+   double batched = measure_ns([&](int) {
+      auto itr = kv_idx.lower_bound(boost::make_tuple(name("kvbench"), uint16_t(0)));
+      int rows = 0;
+      while (itr != kv_idx.end() && rows < N) {
+         // one kv_it_read_batch call: find once, then walk and pack
+         const auto* obj = db.find<kv_object>(itr->id);
+         BOOST_REQUIRE(obj);
+         size_t used = 0;
+         for (int r = 0; r < batch && itr != kv_idx.end(); ++r, ++rows, ++itr) {
+            uint32_t ks = itr->key.size(), vs = itr->value.size();
+            memcpy(dest.data() + used, &ks, sizeof(ks));       used += sizeof(ks);
+            memcpy(dest.data() + used, itr->key.data(), ks);   used += ks;
+            memcpy(dest.data() + used, &vs, sizeof(vs));       used += sizeof(vs);
+            memcpy(dest.data() + used, itr->value.data(), vs); used += vs;
+         }
+      }
+      BOOST_REQUIRE_EQUAL(rows, N);
+   }, 1);
+
+   std::cout << std::setw(25) << "kv_it_read_batch (64)"
+             << std::setw(10) << N
+             << std::setw(15) << fmt_ns(batched / N) << "\n";
+   std::cout << "=================================================\n\n";
+
+   session.undo();
+}
+
+// Iterate-and-update pattern on a secondary index: every kv_idx_update invalidates the cached id of the row the
+// iterator sits on, then kv_idx_next re-caches the following row. Compares a scan of all max_kv_iterators slots per
+// invalidation against the pool's reverse map, with a few live iterators as a typical contract holds.
+BOOST_AUTO_TEST_CASE(secondary_iterator_invalidation_benchmark) {
+   const int N = 100000;
+   const uint16_t table_id = 1;
+
+   std::cout << "\n===== KV Secondary Iterator Invalidation Benchmark =====\n";
+   std::cout << std::left << std::setw(25) << "Operation"
+             << std::setw(10) << "Live its"
+             << std::setw(15) << "ns/row" << "\n";
+   std::cout << std::string(50, '-') << "\n";
+
+   for (int live : {1, 8, 64}) {
+      // Baseline: linear scan over the full slot array per invalidation.
+      std::vector<kv_secondary_slot> slots(config::max_kv_iterators);
+      for (int i = 0; i < live; ++i) {
+         slots[i].in_use   = true;
+         slots[i].code     = "kvbench"_n;
+         slots[i].table_id = table_id;
+      }
+      double scan = measure_ns([&](int i) {
+         slots[0].cached_id = i;
+         for (auto& s : slots) {
+            if (s.in_use && s.code == "kvbench"_n && s.table_id == table_id && s.cached_id == i)
+               s.cached_id = -1;
+         }
+      }, N);
+
+      kv_secondary_iterator_pool pool;
+      std::vector<uint32_t> handles;
+      for (int i = 0; i < live; ++i)
+         handles.push_back(pool.allocate("kvbench"_n, table_id));
+      auto& iterating = pool.get(handles[0]);
+      double mapped = measure_ns([&](int i) {
+         pool.set_cached_id(iterating, i);
+         pool.invalidate_cache("kvbench"_n, table_id, i);
+      }, N);
+
+      std::cout << std::setw(25) << "Full slot scan"
+                << std::setw(10) << live
+                << std::setw(15) << fmt_ns(scan) << "\n";
+      std::cout << std::setw(25) << "Reverse map"
+                << std::setw(10) << live
+                << std::setw(15) << fmt_ns(mapped) << "\n";
+   }
+   std::cout << "=================================================\n\n";
+}
+
 BOOST_AUTO_TEST_SUITE_END()
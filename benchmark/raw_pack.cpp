@@ -0,0 +1,55 @@
+#include <sysio/chain/action_receipt.hpp>
+#include <sysio/chain/block_header.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <benchmark.hpp>
+
+using namespace sysio::chain;
+
+namespace sysio::benchmark {
+
+namespace {
+   template <typename T>
+   void benchmark_pack_unpack(const std::string& name, const T& value) {
+      const bytes packed = fc::raw::pack(value);
+      bytes buffer(packed.size());
+
+      benchmarking(name + " pack", [&]() {
+         fc::datastream<char*> ds(buffer.data(), buffer.size());
+         fc::raw::pack(ds, value);
+      });
+      benchmarking(name + " unpack", [&]() {
+         T result;
+         fc::datastream<const char*> ds(packed.data(), packed.size());
+         fc::raw::unpack(ds, result);
+      });
+   }
+}
+
+void raw_pack_benchmarking() {
+   action_receipt receipt;
+   receipt.receiver        = "sysio.token"_n;
+   receipt.act_digest      = fc::sha256::hash(std::string("transfer"));
+   receipt.global_sequence = 123456789;
+   receipt.recv_sequence   = 4321;
+   receipt.auth_sequence.emplace("alice"_n, 17);
+   receipt.code_sequence   = 1;
+   receipt.abi_sequence    = 1;
+   benchmark_pack_unpack("action_receipt", receipt);
+
+   signed_block_header header;
+   header.timestamp         = block_timestamp_type(fc::time_point::now());
+   header.producer          = "producer1"_n;
+   header.previous          = fc::sha256::hash(std::string("previous"));
+   header.transaction_mroot = fc::sha256::hash(std::string("transactions"));
+   header.finality_mroot    = fc::sha256::hash(std::string("finality"));
+   benchmark_pack_unpack("signed_block_header", header);
+
+   std::vector<fc::sha256> ids(1000);
+   for (size_t i = 0; i < ids.size(); ++i)
+      ids[i] = fc::sha256::hash(std::to_string(i));
+   benchmark_pack_unpack("vector<sha256> 1000", ids);
+}
+
+} // namespace sysio::benchmark
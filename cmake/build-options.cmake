@@ -28,6 +28,9 @@ else()
 endif()
 option(ENABLE_JEMALLOC "link jemalloc statically into nodeop (via vcpkg)" ${SYSIO_DEFAULT_ENABLE_JEMALLOC})
 
+# io_uring as the boost::asio reactor for all io_contexts (p2p, http, thread pools); Linux only, requires liburing
+option(ENABLE_IO_URING "use io_uring instead of epoll for boost::asio (requires liburing)" OFF)
+
 # Build Artifact Flags
 option(BUILD_DOXYGEN "Build doxygen documentation on every make" OFF)
 option(BUILD_OPP_BUNDLES "Build OPP bundles for supported platforms" ON)
@@ -97,3 +97,14 @@ if(ENABLE_TCMALLOC)
   find_package(Gperftools REQUIRED)
   message(STATUS "tcmalloc: ${GPERFTOOLS_TCMALLOC}")
 endif()
+
+# io_uring (liburing) is a system dependency; only required when selected.
+# boost::asio is header-only, so the reactor selection must be identical in every translation unit: define it globally.
+if(ENABLE_IO_URING)
+  if(NOT CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    message(FATAL_ERROR "ENABLE_IO_URING is only supported on Linux")
+  endif()
+  find_package(Liburing REQUIRED)
+  message(STATUS "liburing: ${LIBURING_LIBRARIES}")
+  add_compile_definitions(BOOST_ASIO_HAS_IO_URING BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+endif()
@@ -522,6 +522,7 @@ namespace sysio::chain {
       if( st.base != type_name() ) {
          _binary_to_variant(resolve_type(st.base), stream, obj, ctx);
       }
+      obj.reserve(obj.size() + st.fields.size());
       bool encountered_extension = false;
       for( uint32_t i = 0; i < st.fields.size(); ++i ) {
          const auto& field = st.fields[i];
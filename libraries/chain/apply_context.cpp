@@ -10,6 +10,7 @@
 #include <sysio/chain/code_object.hpp>
 #include <sysio/chain/global_property_object.hpp>
 #include <sysio/chain/deep_mind.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <boost/container/flat_set.hpp>
 
 using boost::container::flat_set;
@@ -21,8 +22,8 @@ namespace sysio::chain {
 static inline int64_t kv_object_ram(uint64_t key_size, uint64_t value_size) {
    return static_cast<int64_t>(key_size + value_size + config::billable_size_v<kv_object>);
 }
-static inline int64_t kv_object_ram(const kv_object& o) {
-   return kv_object_ram(o.key.size(), o.value.size());
+static inline int64_t kv_object_ram(const chainbase::database& db, const kv_object& o) {
+   return kv_object_ram(o.key.size(), kv_value_size(db, o));
 }
 static inline int64_t kv_index_object_ram(uint64_t sec_key_size, uint64_t pri_key_size) {
    return static_cast<int64_t>(sec_key_size + pri_key_size + config::billable_size_v<kv_index_object>);
@@ -614,6 +615,20 @@ static std::optional<std::string> byte_successor(std::string_view bytes) {
    return std::nullopt;
 }
 
+// Point lookup of a primary row through the transaction's kv_lookup_cache. An index hit fills the cache so later
+// reads and writes of the same row in this transaction, from any action, skip the by_code_key walk.
+static const kv_object* find_kv_row(const chainbase::database& db, kv_lookup_cache& cache,
+                                    name code, uint16_t table_id, std::string_view key) {
+   if (const kv_object* obj = cache.find(code, table_id, key))
+      return obj;
+   const auto& idx = db.get_index<kv_index, by_code_key>();
+   auto itr = idx.find(boost::make_tuple(code, table_id, key));
+   if (itr == idx.end())
+      return nullptr;
+   cache.store(*itr);
+   return &*itr;
+}
+
 // --- Primary KV operations ---
 
 int64_t apply_context::kv_set(uint16_t table_id, uint64_t payer_val, const char* key, uint32_t key_size, const char* value, uint32_t value_size) {
@@ -630,12 +645,11 @@ int64_t apply_context::kv_set(uint16_t table_id, uint64_t payer_val, const char*
    // the existing payer. A new row has no existing payer to keep, so 0 is rejected on insert below --
    // matching the classic db_store_i64 / generic_index::store `invalid_table_payer` assert.
    auto sv_key = to_sv(key, key_size);
-   const auto& idx = db.get_index<kv_index, by_code_key>();
-   auto itr = idx.find(boost::make_tuple(receiver, table_id, sv_key));
+   const kv_object* itr = find_kv_row(db, trx_context.kv_row_cache, receiver, table_id, sv_key);
 
-   if (itr != idx.end()) {
+   if (itr) {
       // Update existing
-      int64_t old_billable = kv_object_ram(*itr);
+      int64_t old_billable = kv_object_ram(db, *itr);
       int64_t new_billable = kv_object_ram(key_size, value_size);
 
       // `same_payer` (payer_val == 0) must KEEP the existing payer, not move the row's RAM onto the
@@ -657,9 +671,10 @@ int64_t apply_context::kv_set(uint16_t table_id, uint64_t payer_val, const char*
       auto dm_logger = control.get_deep_mind_logger(trx_context.is_transient());
       std::string old_value_copy;
       if (dm_logger) {
-         old_value_copy.assign(itr->value.data(), itr->value.size());
+         old_value_copy = kv_value(db, *itr);
       }
 
+      control.get_mutable_kv_cold_store().on_write(*itr, value_size);
       db.modify(*itr, [&](auto& o) {
          o.payer = payer;
          o.value.assign(value, value_size);
@@ -682,6 +697,8 @@ int64_t apply_context::kv_set(uint16_t table_id, uint64_t payer_val, const char*
          o.key.assign(key, key_size);
          o.value.assign(value, value_size);
       });
+      trx_context.kv_row_cache.store(obj);
+      control.get_mutable_kv_cold_store().on_write(obj, value_size);
 
       if (auto dm_logger = control.get_deep_mind_logger(trx_context.is_transient())) {
          dm_logger->on_kv_set(obj, true);
@@ -694,18 +711,17 @@ int64_t apply_context::kv_set(uint16_t table_id, uint64_t payer_val, const char*
 }
 
 int32_t apply_context::kv_get(uint16_t table_id, name code, const char* key, uint32_t key_size, char* value, uint32_t value_size) {
-   auto sv_key = to_sv(key, key_size);
-   const auto& idx = db.get_index<kv_index, by_code_key>();
-   auto itr = idx.find(boost::make_tuple(code, table_id, sv_key));
+   const kv_object* itr = find_kv_row(db, trx_context.kv_row_cache, code, table_id, to_sv(key, key_size));
 
-   if (itr == idx.end()) return -1;
+   if (!itr) return -1;
 
-   auto s = static_cast<uint32_t>(itr->value.size());
+   const std::string_view v = kv_value(db, *itr);
+   auto s = static_cast<uint32_t>(v.size());
    if (value_size == 0) return static_cast<int32_t>(s);
 
    auto copy_size = std::min(value_size, s);
    if (copy_size > 0)
-      memcpy(value, itr->value.data(), copy_size);
+      memcpy(value, v.data(), copy_size);
    return static_cast<int32_t>(s);
 }
 
@@ -714,28 +730,110 @@ int64_t apply_context::kv_erase(uint16_t table_id, const char* key, uint32_t key
                "cannot erase a KV record when executing a readonly transaction" );
    SYS_ASSERT( key_size > 0, kv_key_too_large, "KV key must not be empty" );
 
-   auto sv_key = to_sv(key, key_size);
-   const auto& idx = db.get_index<kv_index, by_code_key>();
-   auto itr = idx.find(boost::make_tuple(receiver, table_id, sv_key));
+   const kv_object* itr = find_kv_row(db, trx_context.kv_row_cache, receiver, table_id, to_sv(key, key_size));
 
-   SYS_ASSERT( itr != idx.end(), kv_key_not_found, "KV key not found for erase" );
+   SYS_ASSERT( itr, kv_key_not_found, "KV key not found for erase" );
 
-   int64_t delta = -kv_object_ram(*itr);
+   int64_t delta = -kv_object_ram(db, *itr);
 
    if (auto dm_logger = control.get_deep_mind_logger(trx_context.is_transient())) {
-      dm_logger->on_kv_erase(*itr);
+      const std::string_view value = kv_value(db, *itr);
+      dm_logger->on_kv_erase(*itr, value.data(), value.size());
    }
 
    update_db_usage(itr->payer, delta);
+   trx_context.kv_row_cache.erase(*itr);
    db.remove(*itr);
    return delta;
 }
 
 int32_t apply_context::kv_contains(uint16_t table_id, name code, const char* key, uint32_t key_size) {
-   auto sv_key = to_sv(key, key_size);
-   const auto& idx = db.get_index<kv_index, by_code_key>();
-   auto itr = idx.find(boost::make_tuple(code, table_id, sv_key));
-   return (itr != idx.end()) ? 1 : 0;
+   return find_kv_row(db, trx_context.kv_row_cache, code, table_id, to_sv(key, key_size)) ? 1 : 0;
+}
+
+// --- Batched primary KV operations ---
+//
+// Batches are a sequence of [u32 length][bytes] fields with unaligned little-endian lengths, so a contract
+// can pack them with plain memcpy. Each row behaves exactly like the single-row intrinsic it replaces,
+// including RAM billing; the batch only saves the per-call WASM/host crossing and table_id validation.
+// Rows are capped at config::max_kv_batch_rows per call and checktime() runs between rows so a large
+// batch cannot overrun the transaction deadline inside the host.
+
+namespace {
+   struct kv_batch_reader {
+      const char* pos;
+      const char* end;
+      uint32_t    rows = 0;
+
+      bool done() const { return pos == end; }
+
+      // Count a new row against the per-call limit.
+      void start_row(const transaction_context& trx_context) {
+         SYS_ASSERT( ++rows <= config::max_kv_batch_rows, kv_batch_malformed,
+                     "KV batch exceeds maximum of {} rows", config::max_kv_batch_rows );
+         trx_context.checktime();
+      }
+
+      std::string_view next_field() {
+         uint32_t len = 0;
+         SYS_ASSERT( static_cast<size_t>(end - pos) >= sizeof(len), kv_batch_malformed,
+                     "KV batch truncated in length prefix of row {}", rows );
+         memcpy(&len, pos, sizeof(len));
+         pos += sizeof(len);
+         SYS_ASSERT( static_cast<size_t>(end - pos) >= len, kv_batch_malformed,
+                     "KV batch field of {} bytes in row {} exceeds remaining {} bytes", len, rows, end - pos );
+         std::string_view field(pos, len);
+         pos += len;
+         return field;
+      }
+   };
+}
+
+int32_t apply_context::kv_get_many(uint16_t table_id, name code, const char* keys, uint32_t keys_size, char* dest, uint32_t dest_size) {
+   kv_batch_reader reader{keys, keys + keys_size};
+
+   // Output per key: [i32 value size or -1][value bytes]. Once an entry does not fit nothing further is
+   // written, but the full required size is still returned so the caller can size a buffer and retry.
+   uint32_t required = 0;
+   bool fits = true;
+   while (!reader.done()) {
+      reader.start_row(trx_context);
+      const kv_object* itr = find_kv_row(db, trx_context.kv_row_cache, code, table_id, reader.next_field());
+      const std::string_view v = itr ? kv_value(db, *itr) : std::string_view{};
+      const int32_t size = itr ? static_cast<int32_t>(v.size()) : -1;
+      const uint32_t need = sizeof(size) + (size > 0 ? static_cast<uint32_t>(size) : 0);
+      fits = fits && dest_size - required >= need;
+      if (fits) {
+         memcpy(dest + required, &size, sizeof(size));
+         if (size > 0)
+            memcpy(dest + required + sizeof(size), v.data(), size);
+      }
+      required += need;
+   }
+   return static_cast<int32_t>(required);
+}
+
+int64_t apply_context::kv_set_many(uint16_t table_id, uint64_t payer, const char* rows, uint32_t rows_size) {
+   kv_batch_reader reader{rows, rows + rows_size};
+   int64_t delta = 0;
+   while (!reader.done()) {
+      reader.start_row(trx_context);
+      auto key   = reader.next_field();
+      auto value = reader.next_field();
+      delta += kv_set(table_id, payer, key.data(), key.size(), value.data(), value.size());
+   }
+   return delta;
+}
+
+int64_t apply_context::kv_erase_many(uint16_t table_id, const char* keys, uint32_t keys_size) {
+   kv_batch_reader reader{keys, keys + keys_size};
+   int64_t delta = 0;
+   while (!reader.done()) {
+      reader.start_row(trx_context);
+      auto key = reader.next_field();
+      delta += kv_erase(table_id, key.data(), key.size());
+   }
+   return delta;
 }
 
 // --- Primary KV iterators ---
@@ -903,20 +1001,19 @@ int32_t apply_context::kv_it_lower_bound(uint32_t handle, const char* key, uint3
 
 // Helper: find the current primary row by cached ID (fast) or key bytes (slow).
 // Updates cached_id on success. Returns nullptr if the row was erased.
-static const kv_object* find_current_primary(const chainbase::database& db, kv_primary_slot& slot) {
+static const kv_object* find_current_primary(const chainbase::database& db, kv_lookup_cache& cache, kv_primary_slot& slot) {
    // Fast path: by cached chainbase ID
    if (slot.cached_id >= 0) {
       const auto* obj = db.find<kv_object>(kv_object::id_type(slot.cached_id));
       if (obj && obj->code == slot.code && obj->table_id == slot.table_id)
          return obj;
    }
-   // Slow path: by composite key (row may have been erased and reinserted with new ID)
-   const auto& idx = db.get_index<kv_index, by_code_key>();
+   // Slow path: by composite key (row may have been erased and reinserted with new ID). A row re-stored by
+   // kv_set since the erase is usually still in the transaction's lookup cache.
    auto sv_key = to_sv(slot.current_key.data(), slot.current_key.size());
-   auto itr = idx.find(boost::make_tuple(slot.code, slot.table_id, sv_key));
-   if (itr != idx.end()) {
-      slot.cached_id = itr->id._id;
-      return &*itr;
+   if (const kv_object* obj = find_kv_row(db, cache, slot.code, slot.table_id, sv_key)) {
+      slot.cached_id = obj->id._id;
+      return obj;
    }
    slot.cached_id = -1;
    return nullptr;
@@ -930,7 +1027,7 @@ int32_t apply_context::kv_it_key(uint32_t handle, uint32_t offset, char* dest, u
       return static_cast<int32_t>(slot.status);
    }
 
-   const kv_object* obj = find_current_primary(db, slot);
+   const kv_object* obj = find_current_primary(db, trx_context.kv_row_cache, slot);
    if (!obj) {
       slot.status = kv_it_stat::iterator_erased;
       actual_size = 0;
@@ -954,22 +1051,79 @@ int32_t apply_context::kv_it_value(uint32_t handle, uint32_t offset, char* dest,
       return static_cast<int32_t>(slot.status);
    }
 
-   const kv_object* obj = find_current_primary(db, slot);
+   const kv_object* obj = find_current_primary(db, trx_context.kv_row_cache, slot);
    if (!obj) {
       slot.status = kv_it_stat::iterator_erased;
       actual_size = 0;
       return static_cast<int32_t>(slot.status);
    }
 
-   actual_size = static_cast<uint32_t>(obj->value.size());
-   if (dest_size > 0 && offset < obj->value.size()) {
-      auto copy_size = std::min(static_cast<size_t>(dest_size), obj->value.size() - offset);
-      memcpy(dest, obj->value.data() + offset, copy_size);
+   const std::string_view v = kv_value(db, *obj);
+   actual_size = static_cast<uint32_t>(v.size());
+   if (dest_size > 0 && offset < v.size()) {
+      auto copy_size = std::min(static_cast<size_t>(dest_size), v.size() - offset);
+      memcpy(dest, v.data() + offset, copy_size);
    }
 
    return static_cast<int32_t>(kv_it_stat::iterator_ok);
 }
 
+int32_t apply_context::kv_it_read_batch(uint32_t handle, uint32_t max_rows, char* dest, uint32_t dest_size) {
+   auto& slot = kv_primary_iterators.get(validate_primary_handle(handle, "kv_it_read_batch"));
+
+   if (slot.status != kv_it_stat::iterator_ok) return 0;
+
+   const kv_object* obj = find_current_primary(db, trx_context.kv_row_cache, slot);
+   if (!obj) {
+      slot.status = kv_it_stat::iterator_erased;
+      return 0;
+   }
+
+   // Copy [u32 key size][key][u32 value size][value] per row starting at the current position, stopping at
+   // the end of the prefix range, after max_rows rows, or at the first row that does not fit. The iterator
+   // is left on the first row not copied, so a row larger than dest can still be read with kv_it_key /
+   // kv_it_value.
+   const auto& idx = db.get_index<kv_index, by_code_key>();
+   auto itr = idx.iterator_to(*obj);
+   max_rows = std::min(max_rows, config::max_kv_batch_rows);
+   uint32_t rows = 0;
+   uint32_t used = 0;
+   bool in_range = true;
+   while (rows < max_rows) {
+      const auto key_size   = static_cast<uint32_t>(itr->key.size());
+      const std::string_view value = kv_value(db, *itr);
+      const auto value_size = static_cast<uint32_t>(value.size());
+      const uint64_t need = 2 * sizeof(uint32_t) + uint64_t(key_size) + value_size;
+      if (dest_size - used < need) break;
+
+      trx_context.checktime();
+      memcpy(dest + used, &key_size, sizeof(key_size));
+      used += sizeof(key_size);
+      memcpy(dest + used, itr->key.data(), key_size);
+      used += key_size;
+      memcpy(dest + used, &value_size, sizeof(value_size));
+      used += sizeof(value_size);
+      memcpy(dest + used, value.data(), value_size);
+      used += value_size;
+      ++rows;
+
+      ++itr;
+      in_range = itr != idx.end() && itr->code == slot.code && itr->table_id == slot.table_id && key_has_prefix(*itr, slot.prefix);
+      if (!in_range) break;
+   }
+
+   if (in_range) {
+      slot.current_key.assign(itr->key.data(), itr->key.data() + itr->key.size());
+      slot.cached_id = itr->id._id;
+   } else {
+      slot.status = kv_it_stat::iterator_end;
+      slot.current_key.clear();
+      slot.cached_id = -1;
+   }
+
+   return static_cast<int32_t>(rows);
+}
+
 // --- Secondary KV index operations ---
 
 void apply_context::kv_idx_store(uint64_t payer_val, uint16_t table_id,
@@ -1083,7 +1237,7 @@ int32_t apply_context::kv_idx_find_secondary(name code, uint16_t table_id,
    slot.status = kv_it_stat::iterator_ok;
    slot.current_sec_key.assign(itr->sec_key.data(), itr->sec_key.data() + itr->sec_key.size());
    slot.current_pri_key.assign(itr->pri_key.data(), itr->pri_key.data() + itr->pri_key.size());
-   slot.cached_id = itr->id._id;
+   kv_secondary_iterators.set_cached_id(slot, itr->id._id);
    return static_cast<int32_t>(kv_make_secondary_handle(slot_index));
 }
 
@@ -1116,7 +1270,7 @@ int32_t apply_context::kv_idx_lower_bound(name code, uint16_t table_id,
    slot.status = kv_it_stat::iterator_ok;
    slot.current_sec_key.assign(itr->sec_key.data(), itr->sec_key.data() + itr->sec_key.size());
    slot.current_pri_key.assign(itr->pri_key.data(), itr->pri_key.data() + itr->pri_key.size());
-   slot.cached_id = itr->id._id;
+   kv_secondary_iterators.set_cached_id(slot, itr->id._id);
    return static_cast<int32_t>(kv_make_secondary_handle(slot_index));
 }
 
@@ -1153,12 +1307,12 @@ int32_t apply_context::kv_idx_next(uint32_t handle) {
       slot.status = kv_it_stat::iterator_ok;
       slot.current_sec_key.assign(itr->sec_key.data(), itr->sec_key.data() + itr->sec_key.size());
       slot.current_pri_key.assign(itr->pri_key.data(), itr->pri_key.data() + itr->pri_key.size());
-      slot.cached_id = itr->id._id;
+      kv_secondary_iterators.set_cached_id(slot, itr->id._id);
    } else {
       slot.status = kv_it_stat::iterator_end;
       slot.current_sec_key.clear();
       slot.current_pri_key.clear();
-      slot.cached_id = -1;
+      kv_secondary_iterators.set_cached_id(slot, -1);
    }
 
    return static_cast<int32_t>(slot.status);
@@ -1181,9 +1335,9 @@ int32_t apply_context::kv_idx_prev(uint32_t handle) {
          slot.status = kv_it_stat::iterator_ok;
          slot.current_sec_key.assign(itr->sec_key.data(), itr->sec_key.data() + itr->sec_key.size());
          slot.current_pri_key.assign(itr->pri_key.data(), itr->pri_key.data() + itr->pri_key.size());
-         slot.cached_id = itr->id._id;
+         kv_secondary_iterators.set_cached_id(slot, itr->id._id);
       } else {
-         slot.cached_id = -1;
+         kv_secondary_iterators.set_cached_id(slot, -1);
       }
    } else {
       // Fast path: find current entry by cached ID, then decrement
@@ -1206,7 +1360,7 @@ int32_t apply_context::kv_idx_prev(uint32_t handle) {
          slot.status = kv_it_stat::iterator_end;
          slot.current_sec_key.clear();
          slot.current_pri_key.clear();
-         slot.cached_id = -1;
+         kv_secondary_iterators.set_cached_id(slot, -1);
          return static_cast<int32_t>(slot.status);
       }
       --itr;
@@ -1215,12 +1369,12 @@ int32_t apply_context::kv_idx_prev(uint32_t handle) {
          slot.status = kv_it_stat::iterator_ok;
          slot.current_sec_key.assign(itr->sec_key.data(), itr->sec_key.data() + itr->sec_key.size());
          slot.current_pri_key.assign(itr->pri_key.data(), itr->pri_key.data() + itr->pri_key.size());
-         slot.cached_id = itr->id._id;
+         kv_secondary_iterators.set_cached_id(slot, itr->id._id);
       } else {
          slot.status = kv_it_stat::iterator_end;
          slot.current_sec_key.clear();
          slot.current_pri_key.clear();
-         slot.cached_id = -1;
+         kv_secondary_iterators.set_cached_id(slot, -1);
       }
    }
 
@@ -1228,7 +1382,8 @@ int32_t apply_context::kv_idx_prev(uint32_t handle) {
 }
 
 // Helper: find the current secondary entry by cached ID (fast) or key bytes (slow).
-static const kv_index_object* find_current_secondary(const chainbase::database& db, kv_secondary_slot& slot) {
+static const kv_index_object* find_current_secondary(const chainbase::database& db, kv_secondary_iterator_pool& pool,
+                                                      kv_secondary_slot& slot) {
    if (slot.cached_id >= 0) {
       const auto* obj = db.find<kv_index_object>(kv_index_object::id_type(slot.cached_id));
       if (obj && obj->code == slot.code && obj->table_id == slot.table_id)
@@ -1239,10 +1394,10 @@ static const kv_index_object* find_current_secondary(const chainbase::database&
    auto sv_pri = to_sv(slot.current_pri_key.data(), slot.current_pri_key.size());
    auto itr = idx.find(boost::make_tuple(slot.code, slot.table_id, sv_sec, sv_pri));
    if (itr != idx.end()) {
-      slot.cached_id = itr->id._id;
+      pool.set_cached_id(slot, itr->id._id);
       return &*itr;
    }
-   slot.cached_id = -1;
+   pool.set_cached_id(slot, -1);
    return nullptr;
 }
 
@@ -1254,7 +1409,7 @@ int32_t apply_context::kv_idx_key(uint32_t handle, uint32_t offset, char* dest,
       return static_cast<int32_t>(slot.status);
    }
 
-   const kv_index_object* obj = find_current_secondary(db, slot);
+   const kv_index_object* obj = find_current_secondary(db, kv_secondary_iterators, slot);
    if (!obj) {
       slot.status = kv_it_stat::iterator_erased;
       actual_size = 0;
@@ -1278,7 +1433,7 @@ int32_t apply_context::kv_idx_primary_key(uint32_t handle, uint32_t offset, char
       return static_cast<int32_t>(slot.status);
    }
 
-   const kv_index_object* obj = find_current_secondary(db, slot);
+   const kv_index_object* obj = find_current_secondary(db, kv_secondary_iterators, slot);
    if (!obj) {
       slot.status = kv_it_stat::iterator_erased;
       actual_size = 0;
@@ -0,0 +1,175 @@
+#include <sysio/chain/authority_check_cache.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <string_view>
+
+namespace sysio::chain {
+
+namespace {
+
+void hash_permission_level( size_t& seed, const permission_level& p ) {
+   boost::hash_combine( seed, p.actor.to_uint64_t() );
+   boost::hash_combine( seed, p.permission.to_uint64_t() );
+}
+
+} // namespace
+
+size_t authority_check_cache::hash_provided( const flat_set<public_key_type>& provided_keys,
+                                             const flat_set<permission_level>& provided_permissions ) {
+   size_t seed = provided_keys.size();
+   for( const auto& k : provided_keys ) {
+      const auto packed = fc::raw::pack( k );
+      boost::hash_combine( seed, std::hash<std::string_view>{}( std::string_view( packed.data(), packed.size() ) ) );
+   }
+   for( const auto& p : provided_permissions )
+      hash_permission_level( seed, p );
+   return seed;
+}
+
+size_t authority_check_cache::satisfied_hash( const permission_level& permission, uint16_t depth_limit, size_t provided_hash ) {
+   size_t seed = provided_hash;
+   hash_permission_level( seed, permission );
+   boost::hash_combine( seed, depth_limit );
+   return seed;
+}
+
+size_t authority_check_cache::relevant_key_hash::operator()( const relevant_key& k ) const {
+   size_t seed = 0;
+   hash_permission_level( seed, k.declared_auth );
+   boost::hash_combine( seed, k.code.to_uint64_t() );
+   boost::hash_combine( seed, k.act.to_uint64_t() );
+   return seed;
+}
+
+bool authority_check_cache::find_satisfied( const permission_level& permission, uint16_t depth_limit,
+                                            const flat_set<public_key_type>& provided_keys,
+                                            const flat_set<permission_level>& provided_permissions,
+                                            size_t provided_hash, flat_set<public_key_type>& used_keys ) const {
+   std::lock_guard g( _mtx );
+   auto [it, end] = _satisfied.equal_range( satisfied_hash( permission, depth_limit, provided_hash ) );
+   for( ; it != end; ++it ) {
+      const auto& e = it->second;
+      if( e.permission == permission && e.depth_limit == depth_limit &&
+          e.provided_keys == provided_keys && e.provided_permissions == provided_permissions ) {
+         used_keys.insert( e.used_keys.begin(), e.used_keys.end() );
+         return true;
+      }
+   }
+   return false;
+}
+
+void authority_check_cache::store_satisfied( const permission_level& permission, uint16_t depth_limit,
+                                             const flat_set<public_key_type>& provided_keys,
+                                             const flat_set<permission_level>& provided_permissions,
+                                             size_t provided_hash, flat_set<public_key_type> used_keys ) {
+   std::lock_guard g( _mtx );
+   if( _satisfied.size() + _relevant.size() >= max_entries )
+      clear_locked();
+   _satisfied.emplace( satisfied_hash( permission, depth_limit, provided_hash ),
+                       satisfied_entry{ permission, depth_limit, provided_keys, provided_permissions, std::move(used_keys) } );
+}
+
+bool authority_check_cache::is_relevant( const permission_level& declared_auth, account_name code, action_name act ) const {
+   std::lock_guard g( _mtx );
+   return _relevant.contains( relevant_key{ declared_auth, code, act } );
+}
+
+void authority_check_cache::store_relevant( const permission_level& declared_auth, account_name code, action_name act ) {
+   std::lock_guard g( _mtx );
+   if( _satisfied.size() + _relevant.size() >= max_entries )
+      clear_locked();
+   _relevant.insert( relevant_key{ declared_auth, code, act } );
+}
+
+void authority_check_cache::invalidate() {
+   std::lock_guard g( _mtx );
+   clear_locked();
+   if( !_dirty.empty() )
+      _dirty.back() = true;
+}
+
+size_t authority_check_cache::size() const {
+   std::lock_guard g( _mtx );
+   return _satisfied.size() + _relevant.size();
+}
+
+void authority_check_cache::clear_locked() {
+   _satisfied.clear();
+   _relevant.clear();
+}
+
+void authority_check_cache::add_undo_session() {
+   std::lock_guard g( _mtx );
+   ++_revision;
+   _dirty.push_back( false );
+}
+
+void authority_check_cache::squash() {
+   std::lock_guard g( _mtx );
+   if( _dirty.empty() )
+      return;
+   const bool dirty = _dirty.back();
+   _dirty.pop_back();
+   --_revision;
+   // the parent session now owns the invalidation; squashing the last session makes it permanent
+   if( dirty && !_dirty.empty() )
+      _dirty.back() = true;
+}
+
+void authority_check_cache::undo() {
+   std::lock_guard g( _mtx );
+   if( _dirty.empty() )
+      return;
+   // Entries cached since an auth write in this session describe state that no longer exists.
+   // A clean session changed no auth state, so entries cached during it are still valid.
+   if( _dirty.back() )
+      clear_locked();
+   _dirty.pop_back();
+   --_revision;
+}
+
+void authority_check_cache::undo_all() {
+   while( revision() > undo_stack_revision_range().first )
+      undo();
+}
+
+void authority_check_cache::commit( int64_t revision ) {
+   std::lock_guard g( _mtx );
+   // sessions at or below revision are irreversible and can never be undone
+   int64_t oldest = _revision - static_cast<int64_t>(_dirty.size()) + 1;
+   while( !_dirty.empty() && oldest <= revision ) {
+      _dirty.pop_front();
+      ++oldest;
+   }
+}
+
+void authority_check_cache::set_revision( uint64_t revision ) {
+   std::lock_guard g( _mtx );
+   SYS_ASSERT( _dirty.empty(), chain_exception,
+               "cannot set authority check cache revision while undo sessions are open" );
+   _revision = static_cast<int64_t>(revision);
+}
+
+int64_t authority_check_cache::revision() const {
+   std::lock_guard g( _mtx );
+   return _revision;
+}
+
+std::pair<uint64_t, uint64_t> authority_check_cache::undo_stack_revision_range() const {
+   std::lock_guard g( _mtx );
+   const int64_t begin = _revision - static_cast<int64_t>(_dirty.size());
+   return { static_cast<uint64_t>(begin), static_cast<uint64_t>(_revision) };
+}
+
+void authority_check_cache::align_to( std::pair<uint64_t, uint64_t> range ) {
+   std::lock_guard g( _mtx );
+   clear_locked();
+   _dirty.assign( range.second - range.first, true );
+   _revision = static_cast<int64_t>(range.second);
+}
+
+} // namespace sysio::chain
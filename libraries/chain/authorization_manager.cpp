@@ -198,6 +198,7 @@ namespace sysio { namespace chain {
             dm_logger->on_create_permission(p);
          }
       });
+      _check_cache.invalidate();
       return perm;
    }
 
@@ -231,6 +232,7 @@ namespace sysio { namespace chain {
             dm_logger->on_create_permission(p);
          }
       });
+      _check_cache.invalidate();
       return perm;
    }
 
@@ -256,6 +258,7 @@ namespace sysio { namespace chain {
             dm_logger->on_modify_permission(*old_permission, po);
          }
       });
+      _check_cache.invalidate();
    }
 
    void authorization_manager::remove_permission( const permission_object& permission, bool is_trx_transient ) {
@@ -269,6 +272,7 @@ namespace sysio { namespace chain {
       }
 
       _db.remove( permission );
+      _check_cache.invalidate();
    }
 
    const permission_object*  authorization_manager::find_permission( const permission_level& level )const
@@ -451,18 +455,7 @@ namespace sysio { namespace chain {
                                              )const
    {
       const auto& checktime = ( static_cast<bool>(_checktime) ? _checktime : _noop_checktime );
-
-      auto checker = make_auth_checker( [&](const permission_level& p) -> const shared_authority* {
-                                          if(const permission_object* po = find_permission(p))
-                                             return &po->auth;
-                                          else
-                                             return nullptr;
-                                        },
-                                        _control.get_global_properties().configuration.max_authority_depth,
-                                        provided_keys,
-                                        provided_permissions,
-                                        checktime
-                                      );
+      const uint16_t depth_limit = _control.get_global_properties().configuration.max_authority_depth;
 
       flat_set<permission_level> permissions_to_satisfy;
 
@@ -499,7 +492,7 @@ namespace sysio { namespace chain {
                continue;
             }
 
-            if( !special_case ) {
+            if( !special_case && !_check_cache.is_relevant(declared_auth, act.account, act.name) ) {
                auto min_permission_name = lookup_minimum_permission(declared_auth.actor, act.account, act.name);
                if( min_permission_name ) { // since special cases were already handled, it should only be false if the permission is sysio.any
                   // If the declared permission matches the minimum, it trivially satisfies — skip DB lookups and hierarchy walk
@@ -512,6 +505,7 @@ namespace sysio { namespace chain {
                                  declared_auth, permission_level{min_permission.owner, min_permission.name} );
                   }
                }
+               _check_cache.store_relevant(declared_auth, act.account, act.name);
             }
 
             if( satisfied_authorizations.find( declared_auth ) == satisfied_authorizations.end() ) {
@@ -539,9 +533,30 @@ namespace sysio { namespace chain {
       // for checking the set of declared authorizations.
       // The permission_levels are traversed in ascending order, which is:
       // ascending order of the actor name with ties broken by ascending order of the permission name.
+      //
+      // A satisfied() call never depends on the keys marked used by earlier calls, so each uncached permission is
+      // evaluated on its own checker: the keys it marks are then attributable to that permission alone and can be
+      // cached with it. The union over all permissions is exactly what a single shared checker would have marked.
+      const size_t provided_hash = authority_check_cache::hash_provided(provided_keys, provided_permissions);
+      flat_set<public_key_type> used_keys;
       for( const auto& p : permissions_to_satisfy ) {
          checktime(); // TODO: this should eventually move into authority_checker instead
-         SYS_ASSERT( checker.satisfied( p ) || check_but_dont_fail, unsatisfied_authorization,
+         if( _check_cache.find_satisfied(p, depth_limit, provided_keys, provided_permissions, provided_hash, used_keys) )
+            continue;
+
+         auto checker = make_auth_checker( [&](const permission_level& level) -> const shared_authority* {
+                                             if(const permission_object* po = find_permission(level))
+                                                return &po->auth;
+                                             else
+                                                return nullptr;
+                                           },
+                                           depth_limit,
+                                           provided_keys,
+                                           provided_permissions,
+                                           checktime
+                                         );
+         const bool satisfied = checker.satisfied( p );
+         SYS_ASSERT( satisfied || check_but_dont_fail, unsatisfied_authorization,
                      "transaction declares authority '{}', "
                      "but does not have signatures for it, "
                      "provided permissions {}, provided keys {}",
@@ -550,12 +565,21 @@ namespace sysio { namespace chain {
                      fc::json::to_log_string(provided_keys)
                    );
 
+         auto p_used_keys = checker.used_keys();
+         used_keys.insert(p_used_keys.begin(), p_used_keys.end());
+         if( satisfied )
+            _check_cache.store_satisfied(p, depth_limit, provided_keys, provided_permissions, provided_hash, std::move(p_used_keys));
       }
 
-      if( !allow_unused_keys ) {
-         SYS_ASSERT( checker.all_keys_used() || check_but_dont_fail, tx_irrelevant_sig,
+      if( !allow_unused_keys && used_keys.size() != provided_keys.size() ) {
+         flat_set<public_key_type> unused_keys;
+         for( const auto& k : provided_keys ) {
+            if( !used_keys.contains(k) )
+               unused_keys.insert(unused_keys.end(), k);
+         }
+         SYS_ASSERT( check_but_dont_fail, tx_irrelevant_sig,
                      "transaction bears irrelevant signatures from these keys: {}",
-                     fc::json::to_log_string(checker.unused_keys()) );
+                     fc::json::to_log_string(unused_keys) );
       }
    }
 
@@ -6,8 +6,13 @@
 #include <sysio/chain/log_index.hpp>
 #include <fc/bitutil.hpp>
 #include <fc/io/raw.hpp>
+#include <fc/log/logger_config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <string>
+#include <thread>
 
 #if defined(__BYTE_ORDER__)
 static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
@@ -1798,6 +1803,107 @@ namespace sysio { namespace chain {
       }
    }
 
+   // static
+   uint32_t block_log::full_validate(const std::filesystem::path& block_dir, uint32_t threads) {
+      block_log_bundle log_bundle(block_dir);
+
+      const uint32_t num_blocks      = log_bundle.log_index.num_blocks();
+      const uint32_t first_block_num = log_bundle.log_data.first_block_num();
+      const uint64_t end_of_blocks   = log_bundle.log_data.end_of_block_position();
+      if (num_blocks == 0)
+         return 0;
+
+      threads = std::clamp<uint32_t>(threads, 1, num_blocks);
+      ilog("validating {} blocks, {} to {}, on {} threads", num_blocks, first_block_num, first_block_num + num_blocks - 1, threads);
+
+      struct range_result {
+         block_id_type      first_previous;
+         block_id_type      last_id;
+         std::exception_ptr failure;
+      };
+      std::vector<range_result> results(threads);
+      std::atomic<uint64_t>     bytes = 0;
+
+      // every range opens its own handles, cfile positions are not shareable
+      auto validate_range = [&](uint32_t begin, uint32_t end, range_result& r) {
+         try {
+            block_log_data    data(log_bundle.block_file_name);
+            block_log_index   index(log_bundle.index_file_name);
+            std::vector<char> buf;
+            uint64_t          pos = index.nth_block_position(begin);
+            for (uint32_t i = begin; i < end; ++i) {
+               const uint32_t block_num = first_block_num + i;
+               const uint64_t next_pos  = i + 1 < num_blocks ? index.nth_block_position(i + 1) : end_of_blocks;
+               SYS_ASSERT(next_pos > pos + sizeof(uint64_t) && next_pos <= end_of_blocks, block_log_exception,
+                          "blocks.index position {} of block {} is not followed by a valid position, next is {}",
+                          pos, block_num, next_pos);
+
+               buf.resize(next_pos - pos);
+               data.ro_stream_at(pos).read(buf.data(), buf.size());
+
+               uint64_t trailing_pos = 0;
+               std::memcpy(&trailing_pos, buf.data() + buf.size() - sizeof(trailing_pos), sizeof(trailing_pos));
+               SYS_ASSERT(trailing_pos == pos, block_log_exception,
+                          "the block position for block {} at the end of a block entry is incorrect, expected {} found {}",
+                          block_num, pos, trailing_pos);
+
+               signed_block entry;
+               fc::datastream<const char*> ds(buf.data(), buf.size() - sizeof(trailing_pos));
+               fc::raw::unpack(ds, entry);
+               SYS_ASSERT(ds.remaining() == 0, block_log_exception,
+                          "block {} entry has {} trailing bytes", block_num, ds.remaining());
+
+               const auto id = entry.calculate_id();
+               SYS_ASSERT(block_header::num_from_id(id) == block_num, block_log_exception,
+                          "At position {} expected to find block number {} but found {}",
+                          pos, block_num, block_header::num_from_id(id));
+               if (i == begin) {
+                  r.first_previous = entry.previous;
+               } else {
+                  SYS_ASSERT(entry.previous == r.last_id, block_log_exception,
+                             "Block {} ({}) does not link back to previous block. Expected previous: {}. Actual previous: {}.",
+                             block_num, id, r.last_id, entry.previous);
+               }
+               r.last_id = id;
+               bytes += buf.size();
+               pos = next_pos;
+            }
+         } catch (...) {
+            r.failure = std::current_exception();
+         }
+      };
+
+      const auto start = fc::time_point::now();
+      std::vector<std::thread> workers;
+      workers.reserve(threads);
+      for (uint32_t t = 0; t < threads; ++t) {
+         const auto begin = static_cast<uint32_t>(uint64_t(num_blocks) * t / threads);
+         const auto end   = static_cast<uint32_t>(uint64_t(num_blocks) * (t + 1) / threads);
+         workers.emplace_back([&, t, begin, end]() {
+            fc::set_thread_name("blog-verify-" + std::to_string(t));
+            validate_range(begin, end, results[t]);
+         });
+      }
+      for (auto& w : workers)
+         w.join();
+
+      for (uint32_t t = 0; t < threads; ++t) {
+         if (results[t].failure)
+            std::rethrow_exception(results[t].failure);
+         if (t > 0) {
+            const uint32_t block_num = first_block_num + static_cast<uint32_t>(uint64_t(num_blocks) * t / threads);
+            SYS_ASSERT(results[t].first_previous == results[t - 1].last_id, block_log_exception,
+                       "Block {} does not link back to previous block. Expected previous: {}. Actual previous: {}.",
+                       block_num, results[t - 1].last_id, results[t].first_previous);
+         }
+      }
+
+      const double secs = std::max<int64_t>((fc::time_point::now() - start).count(), 1) / 1000000.0;
+      ilog("validated {} blocks ({} MiB) in {} sec, {} blocks/s, {} MiB/s",
+           num_blocks, bytes / (1024 * 1024), secs, num_blocks / secs, bytes / (1024.0 * 1024.0) / secs);
+      return num_blocks;
+   }
+
    std::pair<std::filesystem::path, std::filesystem::path> blocklog_files(const std::filesystem::path& dir, uint32_t start_block_num, uint32_t num_blocks) {
       const int bufsize = 64;
       char      buf[bufsize];
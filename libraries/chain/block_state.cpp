@@ -78,7 +78,7 @@ block_state::block_state(const block_header_state& prev, signed_block_ptr b, con
 
 block_state::block_state(const block_header_state&                bhs,
                          deque<transaction_metadata_ptr>&&        trx_metas,
-                         deque<transaction_receipt>&&             trx_receipts,
+                         vector<transaction_receipt>&&            trx_receipts,
                          const std::optional<valid_t>&            valid,
                          const std::optional<qc_t>&               qc,
                          const signer_callback_type&              signer,
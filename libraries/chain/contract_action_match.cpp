@@ -6,7 +6,7 @@ namespace sysio { namespace chain {
    using name = contract_action_match::name;
 
    contract_action_match::contract_action_match(const name& root_name, const name& contract_match_name, match_type type)
-   : root_name(root_name) {
+   : root_name(root_name), contract_match_name(contract_match_name), contract_match_type(type) {
       SYS_ASSERT(root_name != name(), chain::producer_exception, "root_name cannot be empty");
       SYS_ASSERT(contract_match_name != name(), chain::producer_exception, "contract_match_name cannot be empty");
       switch(type) {
@@ -68,4 +68,52 @@ namespace sysio { namespace chain {
         return false;
     }
 
+   contract_action_matcher::contract_action_matcher(std::vector<contract_action_match> matches)
+   : _matches(std::move(matches)) {
+      for (uint32_t i = 0; i < _matches.size(); ++i) {
+         const auto& m = _matches[i];
+         switch (m.contract_type()) {
+            case match_type::exact:  _by_exact[m.contract_name()].push_back(i);  break;
+            case match_type::prefix: _by_prefix[m.contract_name()].push_back(i); break;
+            case match_type::suffix: _by_suffix[m.contract_name()].push_back(i); break;
+            default: break; // rejected by contract_action_match
+         }
+      }
+   }
+
+   const contract_action_match* contract_action_matcher::find(const name& contract, const name& action) const {
+      if (_matches.empty())
+         return nullptr;
+      const key_type key{contract, action};
+      auto it = _memo.find(key);
+      if (it == _memo.end()) {
+         if (_memo.size() >= max_memoized)
+            _memo.clear();
+         it = _memo.emplace(key, evaluate(contract, action)).first;
+      }
+      return it->second ? &_matches[*it->second] : nullptr;
+   }
+
+   std::optional<uint32_t> contract_action_matcher::evaluate(const name& contract, const name& action) const {
+      std::optional<uint32_t> first;
+      auto consider = [&](const index_type& index, const name& k) {
+         auto it = index.find(k);
+         if (it == index.end())
+            return;
+         // indexes are in list order, so the first action match of each is the only candidate
+         for (uint32_t i : it->second) {
+            if (first && *first < i)
+               return;
+            if (_matches[i].is_action_match(action)) {
+               first = i;
+               return;
+            }
+         }
+      };
+      consider(_by_exact, contract);
+      consider(_by_prefix, contract.prefix());
+      consider(_by_suffix, contract.suffix());
+      return first;
+   }
+
 } } // namespace sysio::chain
@@ -12,6 +12,7 @@
 #include <sysio/chain/global_property_object.hpp>
 #include <sysio/chain/protocol_state_object.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain/transaction_dedup.hpp>
 #include <sysio/chain/transaction_dedup_undo_index.hpp>
 #include <sysio/chain/genesis_intrinsics.hpp>
@@ -36,14 +37,17 @@
 #include <sysio/chain/vote_message.hpp>
 #include <sysio/chain/vote_processor.hpp>
 #include <sysio/chain/peer_keys_db.hpp>
+#include <sysio/chain/wasm_profiler.hpp>
 
 #include <chainbase/chainbase.hpp>
 #include <sysio/vm/allocator.hpp>
 #include <fc/io/json.hpp>
+#include <fc/latency_histogram.hpp>
 #include <fc/log/logger_config.hpp>
 #include <fc/scoped_exit.hpp>
 #include <fc/variant_object.hpp>
 
+#include <deque>
 #include <future>
 #include <new>
 #include <shared_mutex>
@@ -72,6 +76,30 @@ using kv_database_index_set = index_set<
    kv_index_index
 >;
 
+namespace {
+   /// Wall time of each phase of building or validating a block, exported by prometheus_plugin.
+   /// finalize covers the resource limit and policy updates that precede assembling the block.
+   struct block_phase_histograms {
+      static fc::latency_histogram make(const char* phase) {
+         return {"nodeop_block_phase_seconds", "time spent in each phase of building or validating a block",
+                 {{"phase", phase}}};
+      }
+
+      fc::latency_histogram start_block = make("start_block");
+      fc::latency_histogram apply_trx   = make("apply_trx");
+      fc::latency_histogram finalize    = make("finalize");
+      fc::latency_histogram assemble    = make("assemble");
+      fc::latency_histogram complete    = make("complete");
+      fc::latency_histogram commit      = make("commit");
+      fc::latency_histogram apply_block = make("apply_block");
+   };
+
+   block_phase_histograms& block_phase_latency() {
+      static block_phase_histograms h;
+      return h;
+   }
+}
+
 namespace detail {
    // ------------------------------------------------------------------
    // snapshot_row_traits for kv_object  (shared_blob → vector<char>)
@@ -81,15 +109,15 @@ namespace detail {
       using value_type   = kv_object;
       using snapshot_type = snapshot_kv_object;
 
-      static snapshot_kv_object to_snapshot_row(const kv_object& obj, const chainbase::database&) {
+      static snapshot_kv_object to_snapshot_row(const kv_object& obj, const chainbase::database& db) {
          snapshot_kv_object row;
          row.code     = obj.code;
          row.payer    = obj.payer;
          row.table_id = obj.table_id;
          SYS_ASSERT(obj.key.size() > 0, snapshot_exception, "kv_object has empty key during snapshot write");
          row.key.assign(obj.key.data(), obj.key.data() + obj.key.size());
-         if (obj.value.size() > 0)
-            row.value.assign(obj.value.data(), obj.value.data() + obj.value.size());
+         const std::string_view value = kv_value(db, obj);
+         row.value.assign(value.begin(), value.end());
          return row;
       }
 
@@ -230,7 +258,7 @@ struct assembled_block {
       block_header_state                bhs;
       deque<transaction_metadata_ptr>   trx_metas;                 // Comes from building_block::pending_trx_metas
                                                                    // Carried over to put into block_state (optimization for fork reorgs)
-      deque<transaction_receipt>        trx_receipts;              // Comes from building_block::pending_trx_receipts
+      vector<transaction_receipt>       trx_receipts;              // Comes from building_block::pending_trx_receipts
       std::optional<valid_t>            valid;                     // Comes from assemble_block
       std::optional<qc_t>               qc;                        // QC to add as block extension to new block
       digest_type                       action_mroot;
@@ -302,9 +330,11 @@ struct building_block {
       const vector<digest_type>           new_protocol_feature_activations;
       size_t                              num_new_protocol_features_that_have_activated = 0;
       deque<transaction_metadata_ptr>     pending_trx_metas;
-      deque<transaction_receipt>          pending_trx_receipts;
+      vector<transaction_receipt>         pending_trx_receipts;
       checksum_or_digests                 trx_mroot_or_receipt_digests {digests_t{}};
       action_digests_t                    action_receipt_digests;
+      merkle_chunk_precompute             trx_receipt_merkle_chunks;    // hashed while the block is still being built
+      merkle_chunk_precompute             action_receipt_merkle_chunks; // so assemble_block only has the tail left
       deque<s_header>                     s_headers; // Added new functionality to pass many state headers to be included in block header extension
       trx_block_context                   trx_blk_context;
 
@@ -322,6 +352,14 @@ struct building_block {
          return (std::find(new_protocol_feature_activations.begin(), end, digest) != end);
       }
 
+      // Start hashing any receipt digest chunks completed since the last call.  Results are identical to
+      // calculating the merkle roots from scratch in assemble_block; only the timing of the work changes.
+      void precompute_merkle_chunks() {
+         if (std::holds_alternative<digests_t>(trx_mroot_or_receipt_digests))
+            trx_receipt_merkle_chunks.update(std::get<digests_t>(trx_mroot_or_receipt_digests));
+         action_receipt_merkle_chunks.update(action_receipt_digests.digests_s);
+      }
+
       auto make_block_restore_point() {
          auto orig_trx_receipts_size           = pending_trx_receipts.size();
          auto orig_trx_metas_size              = pending_trx_metas.size();
@@ -339,6 +377,8 @@ struct building_block {
             if (std::holds_alternative<digests_t>(trx_mroot_or_receipt_digests))
                std::get<digests_t>(trx_mroot_or_receipt_digests).resize(orig_trx_receipt_digests_size);
             action_receipt_digests.resize(orig_action_receipt_digests_size);
+            trx_receipt_merkle_chunks.truncate(orig_trx_receipt_digests_size);
+            action_receipt_merkle_chunks.truncate(orig_action_receipt_digests_size);
          };
       }
    };
@@ -456,7 +496,7 @@ struct building_block {
       return bb.pending_trx_metas;
    }
 
-   deque<transaction_receipt>& pending_trx_receipts() {
+   vector<transaction_receipt>& pending_trx_receipts() {
       return bb.pending_trx_receipts;
    }
 
@@ -468,6 +508,10 @@ struct building_block {
        return bb.action_receipt_digests;
    }
 
+   void precompute_merkle_chunks() {
+      bb.precompute_merkle_chunks();
+   }
+
    deque<s_header>& s_headers() {
       return bb.s_headers;
    }
@@ -516,15 +560,17 @@ struct building_block {
                                   const block_state_ptr& validating_bsp) {
       auto& action_receipts = action_receipt_digests();
       // compute the action_mroot and transaction_mroot
+      // calculate_merkle takes 3.2ms for 50,000 digests (legacy version took 11.1ms). Full chunks of both digest
+      // sequences were already hashed on the merkle thread pool while transactions were applied (see
+      // precompute_merkle_chunks), so only the incomplete tail chunk and the chunk roots are hashed here.
       auto [transaction_mroot, action_mroot] = std::visit(
          overloaded{[&](digests_t& trx_receipts) {
-                       // calculate_merkle takes 3.2ms for 50,000 digests (legacy version took 11.1ms)
-                       auto trx_f = post_async_task(ioc, [&]() { return calculate_merkle(trx_receipts); });
-                       auto act_mroot = calculate_merkle(action_receipts.digests_s);
+                       auto trx_f = post_async_task(ioc, [&]() { return bb.trx_receipt_merkle_chunks.root(trx_receipts); });
+                       auto act_mroot = bb.action_receipt_merkle_chunks.root(action_receipts.digests_s);
                        return std::make_pair(trx_f.get(), act_mroot);
                     },
                     [&](const checksum256_type& trx_checksum) {
-                       return std::make_pair(trx_checksum, calculate_merkle(action_receipts.digests_s));
+                       return std::make_pair(trx_checksum, bb.action_receipt_merkle_chunks.root(action_receipts.digests_s));
                     }},
          trx_mroot_or_receipt_digests());
 
@@ -727,6 +773,7 @@ struct controller_impl {
    subjective_billing              subjective_bill;
    authorization_manager           authorization;
    protocol_feature_manager        protocol_features;
+   kv_cold_store                   kv_cold;
    controller::config              conf;
    // persist chain_head after vote_processor shutdown, avoids concurrent access, after chain_head & conf since this uses them
    fc::scoped_exit<std::function<void()>> write_chain_head = [&]() { chain_head.write(conf.state_dir / config::chain_head_filename); };
@@ -770,6 +817,7 @@ struct controller_impl {
    thread_local static vm::wasm_allocator wasm_alloc; // a copy for main thread and each read-only thread
 #endif
    wasm_interface wasmif;
+   std::unique_ptr<wasm_profiler> wasm_prof;
    app_window_type app_window = app_window_type::write;
 
    typedef pair<scope_name,action_name>                   handler_key;
@@ -1019,6 +1067,7 @@ struct controller_impl {
     resource_limits( db, [&s](bool is_trx_transient) { return s.get_deep_mind_logger(is_trx_transient); }),
     authorization( s, db ),
     protocol_features( std::move(pfs), [&s](bool is_trx_transient) { return s.get_deep_mind_logger(is_trx_transient); } ),
+    kv_cold( db ),
     conf( cfg ),
     chain_id( chain_id ),
     read_mode( cfg.read_mode ),
@@ -1037,7 +1086,11 @@ struct controller_impl {
          if( shutdown ) shutdown();
       } );
 
+      if (!conf.wasm_profile_accounts.empty())
+         wasm_prof = std::make_unique<wasm_profiler>(conf.wasm_profile_accounts, conf.wasm_profile_interval);
+
       set_activation_handler<builtin_protocol_feature_t::reserved_first_protocol_feature>();
+      set_activation_handler<builtin_protocol_feature_t::kv_batch_intrinsics>();
 
       irreversible_block.connect([this](const block_signal_params& t) {
          const auto& [ block, id] = t;
@@ -1180,6 +1233,10 @@ struct controller_impl {
       // delete branch in thread pool
       boost::asio::post( thread_pool.get_executor(), [branch{std::move(branch)}]() {} );
 
+      // After the accepted_block signals of the blocks applied so far, so spilling, which changes no
+      // logical state, never shows up in state history deltas.
+      kv_cold.spill( fork_db_root_block_num() );
+
       return result;
    }
 
@@ -1211,6 +1268,48 @@ struct controller_impl {
       return should_replay;
    }
 
+   struct prefetched_block {
+      signed_block_ptr                                                          block;
+      boost::unordered_flat_map<transaction_id_type, transaction_metadata_ptr> trx_metas;
+
+      trx_meta_cache_lookup lookup() const {
+         if( trx_metas.empty() )
+            return {};
+         return [this]( const transaction_id_type& id ) -> transaction_metadata_ptr {
+            auto it = trx_metas.find( id );
+            return it != trx_metas.end() ? it->second : transaction_metadata_ptr{};
+         };
+      }
+   };
+
+   // Runs on the thread pool during replay. Signatures are only checked with force-all-checks, so
+   // keys are only recovered then; a transaction whose recovery fails is left for apply_block to
+   // recover again, which reports the failure in order.
+   prefetched_block prefetch_block( uint32_t block_num ) {
+      prefetched_block result;
+      auto data = blog.read_serialized_block_by_num( block_num );
+      if( data.empty() )
+         return result;
+      auto b = std::make_shared<signed_block>();
+      fc::datastream<const char*> ds( data.data(), data.size() );
+      fc::raw::unpack( ds, *b );
+      SYS_ASSERT( b->block_num() == block_num, block_log_exception,
+                  "Wrong block was read from block log, expected {}, got {}", block_num, b->block_num() );
+      if( conf.force_all_checks ) {
+         result.trx_metas.reserve( b->transactions.size() );
+         for( const auto& receipt : b->transactions ) {
+            try {
+               packed_transaction_ptr ptrx( b, &receipt.trx ); // alias signed_block_ptr
+               auto meta = transaction_metadata::recover_keys( std::move(ptrx), chain_id, fc::microseconds::maximum(),
+                                                               transaction_metadata::trx_type::input );
+               result.trx_metas.emplace( meta->id(), std::move(meta) );
+            } catch( ... ) {}
+         }
+      }
+      result.block = std::move(b);
+      return result;
+   }
+
    void replay_block_log() {
       auto blog_head = blog.head();
       assert(blog_head);
@@ -1222,15 +1321,40 @@ struct controller_impl {
 
       std::exception_ptr except_ptr;
       ilog( "existing block log, attempting to replay from {} to {} blocks", start_block_num, blog_head->block_num() );
+
+      // Blocks are read, unpacked and (with force-all-checks) have their signatures recovered on the
+      // thread pool ahead of the apply loop, which then only applies them in order.
+      const uint32_t last_block_num = blog_head->block_num();
+      const uint32_t prefetch_depth = std::max<uint32_t>(2, 2u * conf.chain_thread_pool_size);
+      std::deque<std::future<prefetched_block>> prefetch;
+      uint32_t next_prefetch = start_block_num;
+      auto fill_prefetch = [&]() {
+         while( prefetch.size() < prefetch_depth && next_prefetch <= last_block_num )
+            prefetch.emplace_back( post_async_task( thread_pool.get_executor(),
+                                                    [this, n=next_prefetch++]() { return prefetch_block( n ); } ) );
+      };
+      // tasks reference this controller; none may outlive the replay
+      auto drain_prefetch = fc::make_scoped_exit([&]() {
+         for( auto& f : prefetch )
+            if( f.valid() ) f.wait();
+      });
+
       try {
-         while( auto next = blog.read_block_by_num( chain_head.block_num() + 1 ) ) {
-            replay_irreversible_block( next );
+         fill_prefetch();
+         while( !prefetch.empty() ) {
+            prefetched_block next = prefetch.front().get();
+            prefetch.pop_front();
+            if( !next.block )
+               break;
+            fill_prefetch();
+
+            replay_irreversible_block( next.block, next.lookup() );
             if( check_shutdown() ) {  // needed on every loop for terminate-at-block
                ilog( "quitting from replay_block_log because of shutdown" );
                break;
             }
-            if( next->block_num() % 500 == 0 ) {
-               ilog( "{} of {}", next->block_num(), blog_head->block_num() );
+            if( next.block->block_num() % 500 == 0 ) {
+               ilog( "{} of {}", next.block->block_num(), last_block_num );
             }
          }
       } catch( const std::exception& e ) {
@@ -1238,11 +1362,11 @@ struct controller_impl {
          except_ptr = std::current_exception();
       }
       auto end = fc::time_point::now();
-      ilog( "{} irreversible blocks replayed from block log, chain head {}",
-            1 + chain_head.block_num() - start_block_num, chain_head.block_num() );
-      ilog( "replayed {} blocks in {} seconds, {} ms/block",
-            chain_head.block_num() + 1 - start_block_num, (end-start).count()/1000000,
-            ((end-start).count()/1000.0)/(chain_head.block_num()-start_block_num) );
+      const uint32_t replayed = chain_head.block_num() + 1 - start_block_num;
+      const double secs = std::max<int64_t>((end-start).count(), 1) / 1000000.0;
+      ilog( "{} irreversible blocks replayed from block log, chain head {}", replayed, chain_head.block_num() );
+      ilog( "replayed {} blocks in {} seconds, {} ms/block, {} blocks/s",
+            replayed, (end-start).count()/1000000, replayed ? (secs*1000.0)/replayed : 0.0, replayed / secs );
 
       // if the irreverible log is played without undo sessions enabled, we need to sync the
       // revision ordinal to the appropriate expected value here.
@@ -1528,6 +1652,10 @@ struct controller_impl {
          trx_dedup.set_revision(static_cast<uint64_t>(db.revision()));
       }
       db.add_undo_participant(std::make_unique<dedup_undo_index>(trx_dedup));
+      // The authority check cache follows the same undo stack so that undoing a session which changed
+      // permissions or links drops results cached against that state.
+      authorization.check_cache().align_to( db.undo_stack_revision_range() );
+      db.add_undo_participant(std::make_unique<authority_cache_undo_index>(authorization.check_cache()));
       // The dedup is now registered and consistent with the database; from here a clean shutdown (or
       // an abort after this point) may safely persist it. Before this point trx_dedup is empty at
       // revision 0 and must never be written over a good file.
@@ -1592,6 +1720,9 @@ struct controller_impl {
    void add_indices() {
       controller_index_set::add_indices(db);
       kv_database_index_set::add_indices(db);
+      // node-local, so in no index set: never in a snapshot or the integrity hash
+      db.add_index<kv_cold_index>();
+      kv_cold.open(conf.state_dir, conf.kv_cold, conf.read_only);
 
       authorization.add_indices();
       resource_limits.add_indices();
@@ -1984,6 +2115,7 @@ struct controller_impl {
                                            bool explicit_billed_cpu_time )
    {
       SYS_ASSERT(block_deadline != fc::time_point(), transaction_exception, "deadline cannot be uninitialized");
+      fc::latency_histogram::scoped_timer phase_timer(block_phase_latency().apply_trx);
 
       transaction_trace_ptr trace;
       try {
@@ -2068,6 +2200,7 @@ struct controller_impl {
 
             if ( !trx->is_read_only() ) {
                bb.action_receipt_digests().append(std::move(trx_context.executed_action_receipts));
+               bb.precompute_merkle_chunks();
 
                if ( !trx->is_dry_run() ) {
                   dmlog_applied_transaction(trace, &trn);
@@ -2136,6 +2269,7 @@ struct controller_impl {
                                       const fc::time_point& deadline )
    {
       SYS_ASSERT( !pending, block_validate_exception, "pending block already exists" );
+      fc::latency_histogram::scoped_timer phase_timer(block_phase_latency().start_block);
 
       emit( block_start, chain_head.block_num() + 1, __FILE__, __LINE__ );
 
@@ -2310,6 +2444,7 @@ struct controller_impl {
       SYS_ASSERT( std::holds_alternative<building_block>(pending->_block_stage), block_validate_exception, "already called finish_block");
 
       try {
+         std::optional<fc::latency_histogram::scoped_timer> phase_timer(std::in_place, block_phase_latency().finalize);
          auto& bb = std::get<building_block>(pending->_block_stage);
 
          set_s_headers( bb.block_num() );
@@ -2348,6 +2483,7 @@ struct controller_impl {
             }
          }
 
+         phase_timer.emplace(block_phase_latency().assemble);
          auto assembled_block =
             bb.assemble_block(thread_pool.get_executor(),
                               protocol_features.get_protocol_feature_set(),
@@ -2370,6 +2506,7 @@ struct controller_impl {
       auto reset_pending_on_exit = fc::make_scoped_exit([this]{
          pending.reset();
       });
+      fc::latency_histogram::scoped_timer phase_timer(block_phase_latency().commit);
 
       try {
          SYS_ASSERT( std::holds_alternative<completed_block>(pending->_block_stage), block_validate_exception,
@@ -2613,6 +2750,7 @@ struct controller_impl {
             }
 
             auto start = fc::time_point::now(); // want to report total time of applying a block
+            fc::latency_histogram::scoped_timer phase_timer(block_phase_latency().apply_block);
 
             applying_block = true;
             auto apply = fc::make_scoped_exit([&](){ applying_block = false; });
@@ -3059,7 +3197,7 @@ struct controller_impl {
       }
    }
 
-   void replay_irreversible_block( const signed_block_ptr& b ) {
+   void replay_irreversible_block( const signed_block_ptr& b, const trx_meta_cache_lookup& trx_lookup = {} ) {
       validate_db_available_size();
 
       assert(!pending); // should not be pending block
@@ -3087,7 +3225,7 @@ struct controller_impl {
 
          auto bsp = std::make_shared<block_state>(*chain_head.internal(), b, protocol_features.get_protocol_feature_set(), validator, skip_validate_signee, chain_head.internal()->make_block_ref());
 
-         if (apply_block(bsp, controller::block_status::irreversible, trx_meta_cache_lookup{}) == controller::apply_blocks_result_t::status_t::complete) {
+         if (apply_block(bsp, controller::block_status::irreversible, trx_lookup) == controller::apply_blocks_result_t::status_t::complete) {
             // On replay, log_irreversible is not called and so no irreversible_block signal is emitted.
             // So emit it explicitly here.
             emit( irreversible_block, std::tie(bsp->block, bsp->id()), __FILE__, __LINE__ );
@@ -3294,7 +3432,7 @@ struct controller_impl {
       return calculate_merkle( digests );
    }
 
-   static checksum256_type calculate_trx_merkle( const deque<transaction_receipt>& trxs) {
+   static checksum256_type calculate_trx_merkle( const vector<transaction_receipt>& trxs) {
       deque<digest_type> trx_digests;
       for( const auto& a : trxs ) {
          trx_digests.emplace_back( a.digest() );
@@ -3318,6 +3456,8 @@ struct controller_impl {
 
          if (permission.auth != auth) {
             db.modify(permission, [&](auto& po) { po.auth = auth; });
+            // bypasses modify_permission; cached authority checks of sysio.prods no longer hold
+            authorization.invalidate_check_cache();
          }
       };
 
@@ -3713,6 +3853,11 @@ resource_limits_manager&         controller::get_mutable_resource_limits_manager
    return my->resource_limits;
 }
 
+kv_cold_store&                   controller::get_mutable_kv_cold_store()
+{
+   return my->kv_cold;
+}
+
 const authorization_manager&   controller::get_authorization_manager()const
 {
    return my->authorization;
@@ -3955,6 +4100,7 @@ void controller::assemble_and_complete_block( const signer_callback_type& signer
 
    my->assemble_block(false, {}, nullptr);
 
+   fc::latency_histogram::scoped_timer phase_timer(block_phase_latency().complete);
    auto& ab = std::get<assembled_block>(my->pending->_block_stage);
    const auto& valid_block_signing_authority = my->head_active_producers(ab.timestamp()).get_scheduled_producer(ab.timestamp()).authority;
    my->pending->_block_stage = ab.complete_block(
@@ -4297,6 +4443,14 @@ void controller::write_snapshot( const snapshot_writer_ptr& snapshot ) {
    my->add_to_snapshot(snapshot);
 }
 
+void controller::pop_to_fork_db_root() {
+   SYS_ASSERT( !my->pending, block_validate_exception, "cannot pop blocks with a pending block" );
+   SYS_ASSERT( my->fork_db_has_root(), fork_database_exception, "fork database not properly initialized" );
+   const uint32_t root_num = my->fork_db_root().block_num();
+   while( my->chain_head.block_num() > root_num )
+      my->pop_block();
+}
+
 bool controller::is_writing_snapshot() const {
    return my->writing_snapshot.load(std::memory_order_acquire);
 }
@@ -4392,6 +4546,10 @@ bool controller::is_profiling(account_name account) const {
    return my->conf.profile_accounts.find(account) != my->conf.profile_accounts.end();
 }
 
+wasm_profiler* controller::get_wasm_profiler() const {
+   return my->wasm_prof.get();
+}
+
 bool controller::is_sys_vm_oc_whitelisted(const account_name& n) const {
    return my->conf.sys_vm_oc_whitelist_suffixes.count(n.suffix()) > 0;
 }
@@ -4675,6 +4833,7 @@ void controller::replace_account_keys( name account, name permission, const publ
    mutable_db().modify(*perm, [&](auto& p) {
       p.auth = authority(key);
    });
+   my->authorization.invalidate_check_cache();
    int64_t new_size = (int64_t)(chain::config::billable_size_v<permission_object> + perm->auth.get_billable_size());
    rlm.add_pending_ram_usage(account, new_size - old_size, false); // false for doing dm logging
    rlm.verify_account_ram_usage(account);
@@ -4783,6 +4942,16 @@ void controller_impl::on_activation<builtin_protocol_feature_t::reserved_first_p
    // any initialization needed for protocol feature
 }
 
+template<>
+void controller_impl::on_activation<builtin_protocol_feature_t::kv_batch_intrinsics>() {
+   db.modify( db.get<protocol_state_object>(), [&]( auto& ps ) {
+      add_intrinsic_to_whitelist( ps.whitelisted_intrinsics, "kv_get_many" );
+      add_intrinsic_to_whitelist( ps.whitelisted_intrinsics, "kv_set_many" );
+      add_intrinsic_to_whitelist( ps.whitelisted_intrinsics, "kv_erase_many" );
+      add_intrinsic_to_whitelist( ps.whitelisted_intrinsics, "kv_it_read_batch" );
+   } );
+}
+
 // example:
 // template<>
 // void controller_impl::on_activation<builtin_protocol_feature_t::get_block_num>() {
@@ -7,6 +7,16 @@
 #include <sysio/chain/account_object.hpp>
 #include <sysio/chain/protocol_feature_manager.hpp>
 #include <fc/crypto/hex.hpp>
+#include <fc/log/dmlog_binary_writer.hpp>
+
+// Events without packed payloads are written as the same line in both modes
+#define DMLOG( FORMAT, ... ) \
+  FC_MULTILINE_MACRO_BEGIN \
+   if( _binary ) \
+      _binary->write( FC_FMT( FORMAT, ##__VA_ARGS__ ) ); \
+   else \
+      fc_dlog( _logger, FORMAT, ##__VA_ARGS__ ); \
+  FC_MULTILINE_MACRO_END
 
 namespace {
 
@@ -35,25 +45,30 @@ namespace sysio::chain {
       fc::logger::update( logger_name, _logger );
    }
 
+   void deep_mind_handler::update_binary_writer(std::shared_ptr<fc::dmlog_binary_writer> writer)
+   {
+      _binary = std::move(writer);
+   }
+
    void deep_mind_handler::on_startup(chainbase::database& db, uint32_t head_block_num)
    {
       // FIXME: We should probably feed that from CMake directly somehow ...
-      fc_dlog(_logger, "DEEP_MIND_VERSION wire_sysio 1 0");
+      DMLOG("DEEP_MIND_VERSION wire_sysio 1 0");
 
-      fc_dlog(_logger, "ABIDUMP START {} {}", head_block_num, db.get<dynamic_global_property_object>().global_action_sequence);
+      DMLOG("ABIDUMP START {} {}", head_block_num, db.get<dynamic_global_property_object>().global_action_sequence);
       const auto& idx = db.get_index<account_metadata_index>();
       for (auto& row : idx.indices()) {
          if (row.abi.size() != 0) {
             std::string abi_str = fc::format_string("${data}", fc::mutable_variant_object("data", fc::variant(row.abi)));
-            fc_dlog(_logger, "ABIDUMP ABI {} {}", row.name, abi_str);
+            DMLOG("ABIDUMP ABI {} {}", row.name, abi_str);
          }
       }
-      fc_dlog(_logger, "ABIDUMP END");
+      DMLOG("ABIDUMP END");
    }
 
    void deep_mind_handler::on_start_block(uint32_t block_num)
    {
-      fc_dlog(_logger, "START_BLOCK {}", block_num);
+      DMLOG("START_BLOCK {}", block_num);
    }
 
    void deep_mind_handler::on_accepted_block_v2(const block_id_type& id, block_num_type lib,
@@ -68,6 +83,11 @@ namespace sysio::chain {
       auto packed_proposer_policy = fc::raw::pack(*active_proposer_policy);
       auto packed_finalizer_policy = fc::raw::pack(active_finalizer_policy);
 
+      if (_binary) {
+         _binary->write(FC_FMT("ACCEPTED_BLOCK_V2 {} {} {}", id, b->block_num(), lib),
+                        {b->packed_signed_block(), finality_data, packed_proposer_policy, packed_finalizer_policy});
+         return;
+      }
       fc_dlog(_logger, "ACCEPTED_BLOCK_V2 {} {} {} {} {} {} {}",
          id,
          b->block_num(),
@@ -81,13 +101,17 @@ namespace sysio::chain {
 
    void deep_mind_handler::on_switch_forks(const block_id_type& old_head, const block_id_type& new_head)
    {
-      fc_dlog(_logger, "SWITCH_FORK {} {}", old_head, new_head);
+      DMLOG("SWITCH_FORK {} {}", old_head, new_head);
    }
 
    void deep_mind_handler::on_onblock(const signed_transaction& trx)
    {
       auto packed_trx = fc::raw::pack(trx);
 
+      if (_binary) {
+         _binary->write(FC_FMT("TRX_OP CREATE onblock {}", trx.id()), {packed_trx});
+         return;
+      }
       fc_dlog(_logger, "TRX_OP CREATE onblock {} {}", trx.id(), fc::to_hex(packed_trx));
    }
 
@@ -114,26 +138,30 @@ namespace sysio::chain {
          packed_trace = fc::raw::pack(*trace);
       }
 
+      if (_binary) {
+         _binary->write(FC_FMT("APPLIED_TRANSACTION {}", block_num), {packed_trace});
+         return;
+      }
       fc_dlog(_logger, "APPLIED_TRANSACTION {} {}", block_num, fc::to_hex(packed_trace) );
    }
 
    void deep_mind_handler::on_preactivate_feature(const protocol_feature& feature)
    {
       std::string f_str = fc::format_string("${data}", fc::mutable_variant_object("data", feature.to_variant()));
-      fc_dlog(_logger, "FEATURE_OP PRE_ACTIVATE {} {} {}",
+      DMLOG("FEATURE_OP PRE_ACTIVATE {} {} {}",
               _action_id, feature.feature_digest, std::move(f_str) );
    }
 
    void deep_mind_handler::on_activate_feature(const protocol_feature& feature)
    {
       std::string f_str = fc::format_string("${data}", fc::mutable_variant_object("data", feature.to_variant()));
-      fc_dlog(_logger, "FEATURE_OP ACTIVATE {} {}",
+      DMLOG("FEATURE_OP ACTIVATE {} {}",
               feature.feature_digest, std::move(f_str) );
    }
 
    void deep_mind_handler::on_input_action()
    {
-      fc_dlog(_logger, "CREATION_OP ROOT {}", _action_id);
+      DMLOG("CREATION_OP ROOT {}", _action_id);
    }
    void deep_mind_handler::on_end_action()
    {
@@ -141,19 +169,30 @@ namespace sysio::chain {
    }
    void deep_mind_handler::on_require_recipient()
    {
-      fc_dlog(_logger, "CREATION_OP NOTIFY {}", _action_id);
+      DMLOG("CREATION_OP NOTIFY {}", _action_id);
    }
    void deep_mind_handler::on_send_inline()
    {
-      fc_dlog(_logger, "CREATION_OP INLINE {}", _action_id);
+      DMLOG("CREATION_OP INLINE {}", _action_id);
    }
    void deep_mind_handler::on_send_context_free_inline()
    {
-      fc_dlog(_logger, "CREATION_OP CFA_INLINE {}", _action_id);
+      DMLOG("CREATION_OP CFA_INLINE {}", _action_id);
    }
    // KV deep_mind hooks — unified KV_OP format with table_id
    void deep_mind_handler::on_kv_set(const kv_object& obj, bool is_new, account_name old_payer, const char* old_value, std::size_t old_value_size)
    {
+      const std::span<const char> key(obj.key.data(), obj.key.size());
+      const std::span<const char> value(obj.value.data(), obj.value.size());
+      if (_binary) {
+         if (is_new)
+            _binary->write(FC_FMT("KV_OP INS {} {} {} {}", _action_id, obj.payer, obj.code, obj.table_id),
+                           {key, value});
+         else
+            _binary->write(FC_FMT("KV_OP UPD {} {}:{} {} {}", _action_id, old_payer, obj.payer, obj.code, obj.table_id),
+                           {key, std::span<const char>(old_value, old_value_size), value});
+         return;
+      }
       if (is_new) {
          fc_dlog(_logger, "KV_OP INS {} {} {} {} {} {}",
             _action_id, obj.payer, obj.code, obj.table_id,
@@ -170,36 +209,42 @@ namespace sysio::chain {
       }
    }
 
-   void deep_mind_handler::on_kv_erase(const kv_object& obj)
+   void deep_mind_handler::on_kv_erase(const kv_object& obj, const char* value, std::size_t value_size)
    {
+      if (_binary) {
+         _binary->write(FC_FMT("KV_OP REM {} {} {} {}", _action_id, obj.payer, obj.code, obj.table_id),
+                        {std::span<const char>(obj.key.data(), obj.key.size()),
+                         std::span<const char>(value, value_size)});
+         return;
+      }
       fc_dlog(_logger, "KV_OP REM {} {} {} {} {} {}",
          _action_id, obj.payer, obj.code, obj.table_id,
          fc::to_hex(obj.key.data(), obj.key.size()),
-         fc::to_hex(obj.value.data(), obj.value.size())
+         fc::to_hex(value, value_size)
       );
    }
    void deep_mind_handler::on_init_resource_limits(const resource_limits::resource_limits_config_object& config, const resource_limits::resource_limits_state_object& state)
    {
       std::string config_str = fc::format_string("${data}", fc::mutable_variant_object("data", config));
       std::string state_str = fc::format_string("${data}", fc::mutable_variant_object("data", state));
-      fc_dlog(_logger, "RLIMIT_OP CONFIG INS {}",
+      DMLOG("RLIMIT_OP CONFIG INS {}",
          std::move(config_str)
       );
-      fc_dlog(_logger, "RLIMIT_OP STATE INS {}",
+      DMLOG("RLIMIT_OP STATE INS {}",
          std::move(state_str)
       );
    }
    void deep_mind_handler::on_update_resource_limits_config(const resource_limits::resource_limits_config_object& config)
    {
       std::string config_str = fc::format_string("${data}", fc::mutable_variant_object("data", config));
-      fc_dlog(_logger, "RLIMIT_OP CONFIG UPD {}",
+      DMLOG("RLIMIT_OP CONFIG UPD {}",
          std::move(config_str)
       );
    }
    void deep_mind_handler::on_update_resource_limits_state(const resource_limits::resource_limits_state_object& state)
    {
       std::string state_str = fc::format_string("${data}", fc::mutable_variant_object("data", state));
-      fc_dlog(_logger, "RLIMIT_OP STATE UPD {}",
+      DMLOG("RLIMIT_OP STATE UPD {}",
          std::move(state_str)
       );
    }
@@ -229,7 +274,7 @@ namespace sysio::chain {
          .ram_bytes = obj.ram_bytes,
       };
       std::string limits_str = fc::format_string("${data}", fc::mutable_variant_object("data", limits));
-      fc_dlog(_logger, "RLIMIT_OP ACCOUNT_LIMITS INS {}",
+      DMLOG("RLIMIT_OP ACCOUNT_LIMITS INS {}",
          std::move(limits_str)
       );
       resource_usage_object usage{
@@ -239,7 +284,7 @@ namespace sysio::chain {
          .ram_usage = obj.ram_usage,
       };
       std::string usage_str = fc::format_string("${data}", fc::mutable_variant_object("data", usage));
-      fc_dlog(_logger, "RLIMIT_OP ACCOUNT_USAGE INS {}",
+      DMLOG("RLIMIT_OP ACCOUNT_USAGE INS {}",
          std::move(usage_str)
       );
    }
@@ -252,14 +297,14 @@ namespace sysio::chain {
          .ram_usage = obj.ram_usage,
       };
       std::string usage_str = fc::format_string("${data}", fc::mutable_variant_object("data", usage));
-      fc_dlog(_logger, "RLIMIT_OP ACCOUNT_USAGE UPD {}",
+      DMLOG("RLIMIT_OP ACCOUNT_USAGE UPD {}",
          std::move(usage_str)
       );
    }
    void deep_mind_handler::on_set_account_limits(const resource_limits::resource_pending_object& limits)
    {
       std::string limits_str = fc::format_string("${data}", fc::mutable_variant_object("data", limits));
-      fc_dlog(_logger, "RLIMIT_OP ACCOUNT_LIMITS UPD {}",
+      DMLOG("RLIMIT_OP ACCOUNT_LIMITS UPD {}",
          std::move(limits_str)
       );
    }
@@ -269,7 +314,7 @@ namespace sysio::chain {
    }
    void deep_mind_handler::on_ram_event(account_name account, uint64_t new_usage, int64_t delta)
    {
-      fc_dlog(_logger, "RAM_OP {} {} {} {} {} {} {} {}",
+      DMLOG("RAM_OP {} {} {} {} {} {} {} {}",
          _action_id,
          _ram_trace.event_id,
          _ram_trace.family,
@@ -285,7 +330,7 @@ namespace sysio::chain {
    void deep_mind_handler::on_create_permission(const permission_object& p)
    {
       std::string p_str = fc::format_string("${data}", fc::mutable_variant_object("data", p));
-      fc_dlog(_logger, "PERM_OP INS {} {} {}",
+      DMLOG("PERM_OP INS {} {} {}",
          _action_id,
          p.id,
          p_str
@@ -296,7 +341,7 @@ namespace sysio::chain {
       std::string p_str = fc::format_string("${data}", fc::mutable_variant_object()
                                                           ("old", old_permission)
                                                           ("new", new_permission));
-      fc_dlog(_logger, "PERM_OP UPD {} {} {}",
+      DMLOG("PERM_OP UPD {} {} {}",
          _action_id,
          new_permission.id,
          p_str
@@ -305,7 +350,7 @@ namespace sysio::chain {
    void deep_mind_handler::on_remove_permission(const permission_object& permission)
    {
       std::string p_str = fc::format_string("${data}", fc::mutable_variant_object("data", permission));
-      fc_dlog(_logger, "PERM_OP REM {} {} {}",
+      DMLOG("PERM_OP REM {} {} {}",
         _action_id,
         permission.id,
         p_str
@@ -397,10 +397,9 @@ namespace impl {
          fc::variants array;
          array.reserve(v.size());
 
+         mutable_variant_object elem_mvo;
          for (const auto& iter: v) {
-            mutable_variant_object elem_mvo;
-            add(elem_mvo, "_", iter, resolver, ctx);
-            array.emplace_back(std::move(elem_mvo["_"]));
+            array.emplace_back(to_element(elem_mvo, iter, resolver, ctx));
          }
          mvo(name, std::move(array));
       }
@@ -415,10 +414,9 @@ namespace impl {
          auto h = ctx.enter_scope();
          deque<fc::variant> array;
 
+         mutable_variant_object elem_mvo;
          for (const auto& iter: v) {
-            mutable_variant_object elem_mvo;
-            add(elem_mvo, "_", iter, resolver, ctx);
-            array.emplace_back(std::move(elem_mvo["_"]));
+            array.emplace_back(to_element(elem_mvo, iter, resolver, ctx));
          }
          mvo(name, std::move(array));
       }
@@ -436,6 +434,19 @@ namespace impl {
          mvo(name, std::move(obj_mvo["_"]));
       }
 
+      /**
+       * converts one container element through elem_mvo, which the caller reuses for every element so that
+       * converting an element does not allocate an object of its own
+       */
+      template<typename M, typename Resolver>
+      static fc::variant to_element( mutable_variant_object& elem_mvo, const M& v, const Resolver& resolver, abi_traverse_context& ctx )
+      {
+         add(elem_mvo, "_", v, resolver, ctx);
+         fc::variant result = std::move(elem_mvo["_"]);
+         elem_mvo.erase("_");
+         return result;
+      }
+
       template<typename Resolver>
       struct add_static_variant
       {
@@ -498,6 +509,7 @@ namespace impl {
          static_assert(fc::reflector<action>::total_member_count == 4);
          auto h = ctx.enter_scope();
          mutable_variant_object mvo;
+         mvo.reserve(5);
          mvo("account", act.account);
          mvo("name", act.name);
          mvo("authorization", act.authorization);
@@ -563,6 +575,7 @@ namespace impl {
          static_assert(fc::reflector<action_trace>::total_member_count == 19);
          auto h = ctx.enter_scope();
          mutable_variant_object mvo;
+         mvo.reserve(20);
 
          mvo("action_ordinal", act_trace.action_ordinal);
          mvo("creator_action_ordinal", act_trace.creator_action_ordinal);
@@ -584,7 +597,7 @@ namespace impl {
          mvo("error_code", act_trace.error_code);
 
          mvo("return_value_hex_data", act_trace.return_value);
-         auto act = act_trace.act;
+         const auto& act = act_trace.act;
          try {
             auto abi_optional = resolver(act.account);
             if (abi_optional) {
@@ -614,7 +627,8 @@ namespace impl {
          static_assert(fc::reflector<packed_transaction>::total_member_count == 4);
          auto h = ctx.enter_scope();
          mutable_variant_object mvo;
-         auto trx = ptrx.get_transaction();
+         mvo.reserve(7);
+         const auto& trx = ptrx.get_transaction();
          mvo("id", trx.id());
          mvo("signatures", ptrx.get_signatures());
          mvo("compression", ptrx.get_compression());
@@ -638,6 +652,7 @@ namespace impl {
          static_assert(fc::reflector<transaction>::total_member_count == 9);
          auto h = ctx.enter_scope();
          mutable_variant_object mvo;
+         mvo.reserve(8);
          mvo("expiration", trx.expiration);
          mvo("ref_block_num", trx.ref_block_num);
          mvo("ref_block_prefix", trx.ref_block_prefix);
@@ -665,6 +680,7 @@ namespace impl {
          static_assert(fc::reflector<signed_block>::total_member_count == 13);
          auto h = ctx.enter_scope();
          mutable_variant_object mvo;
+         mvo.reserve(13);
          mvo("timestamp", block.timestamp);
          mvo("producer", block.producer);
          mvo("previous", block.previous);
@@ -685,7 +701,7 @@ namespace impl {
                add(feature_mvo, "feature_digest", feature, resolver, ctx);
                pf_array.push_back(std::move(feature_mvo));
             }
-            mvo("new_protocol_features", pf_array);
+            mvo("new_protocol_features", std::move(pf_array));
          }
 
          mvo("producer_signatures", block.producer_signatures);
@@ -950,6 +966,7 @@ namespace impl {
    {
       auto h = ctx.enter_scope();
       mutable_variant_object member_mvo;
+      member_mvo.reserve(fc::reflector<M>::total_member_count);
       fc::reflector<M>::visit( impl::abi_to_variant_visitor<M, Resolver>( member_mvo, v, resolver, ctx) );
       mvo(name, std::move(member_mvo));
    }
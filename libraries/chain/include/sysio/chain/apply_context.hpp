@@ -88,6 +88,11 @@ class apply_context {
       int64_t  kv_erase(uint16_t table_id, const char* key, uint32_t key_size);
       int32_t  kv_contains(uint16_t table_id, name code, const char* key, uint32_t key_size);
 
+      // Batched primary KV operations (KV_BATCH_INTRINSICS)
+      int32_t  kv_get_many(uint16_t table_id, name code, const char* keys, uint32_t keys_size, char* dest, uint32_t dest_size);
+      int64_t  kv_set_many(uint16_t table_id, uint64_t payer, const char* rows, uint32_t rows_size);
+      int64_t  kv_erase_many(uint16_t table_id, const char* keys, uint32_t keys_size);
+
       // Primary KV iterators
       uint32_t kv_it_create(uint16_t table_id, name code, const char* prefix, uint32_t prefix_size);
       void     kv_it_destroy(uint32_t handle);
@@ -97,6 +102,7 @@ class apply_context {
       int32_t  kv_it_lower_bound(uint32_t handle, const char* key, uint32_t key_size);
       int32_t  kv_it_key(uint32_t handle, uint32_t offset, char* dest, uint32_t dest_size, uint32_t& actual_size);
       int32_t  kv_it_value(uint32_t handle, uint32_t offset, char* dest, uint32_t dest_size, uint32_t& actual_size);
+      int32_t  kv_it_read_batch(uint32_t handle, uint32_t max_rows, char* dest, uint32_t dest_size);
 
       // Secondary KV index operations
       void     kv_idx_store(uint64_t payer, uint16_t table_id,
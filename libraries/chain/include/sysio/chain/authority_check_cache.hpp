@@ -0,0 +1,140 @@
+#pragma once
+
+#include <sysio/chain/types.hpp>
+#include <sysio/chain/action.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace sysio::chain {
+
+/// In-memory cache of successful authorization checks, owned by authorization_manager.
+///
+/// Two results are cached, both only on success so a failing transaction always re-runs the full
+/// check and reports the same error:
+///  - satisfied: permission_level P is satisfied by a (provided keys, provided permissions) pair at
+///    a given max_authority_depth, together with the keys that evaluation marked as used. A single
+///    authority_checker::satisfied() call never depends on keys marked by earlier calls, so replaying
+///    the cached used keys is identical to re-evaluating P.
+///  - relevant: declared authorization D meets the minimum (linked) permission for action code::name.
+///
+/// Both depend only on permission_object and permission_link_object state. Every write to either
+/// calls invalidate(), which drops all entries. Entries created after a write in an undo session are
+/// stale once that session is undone, so the cache follows the database's undo stack (registered via
+/// authority_cache_undo_index) and clears itself when a session that invalidated it is undone.
+///
+/// Lookups may come from the read-only transaction threads, so all access is serialized by a mutex.
+/// The cache is bounded: reaching max_entries clears it.
+class authority_check_cache {
+public:
+   static constexpr size_t max_entries = 64 * 1024;
+
+   /// Hash of the provided keys and permissions of one check; computed once per check_authorization call.
+   static size_t hash_provided( const flat_set<public_key_type>& provided_keys,
+                                const flat_set<permission_level>& provided_permissions );
+
+   /// If permission is cached as satisfied, inserts the keys its evaluation used into used_keys and returns true.
+   bool find_satisfied( const permission_level& permission, uint16_t depth_limit,
+                        const flat_set<public_key_type>& provided_keys,
+                        const flat_set<permission_level>& provided_permissions,
+                        size_t provided_hash, flat_set<public_key_type>& used_keys ) const;
+
+   void store_satisfied( const permission_level& permission, uint16_t depth_limit,
+                         const flat_set<public_key_type>& provided_keys,
+                         const flat_set<permission_level>& provided_permissions,
+                         size_t provided_hash, flat_set<public_key_type> used_keys );
+
+   bool is_relevant( const permission_level& declared_auth, account_name code, action_name act ) const;
+   void store_relevant( const permission_level& declared_auth, account_name code, action_name act );
+
+   /// Drop all entries; called on every permission or permission link write.
+   void invalidate();
+
+   size_t size() const;
+
+   // --- chainbase-aligned undo lifecycle, driven by authority_cache_undo_index --------------------
+
+   void    add_undo_session();
+   void    squash();
+   void    undo();
+   void    undo_all();
+   void    commit( int64_t revision );
+   void    set_revision( uint64_t revision );
+   int64_t revision() const;
+   std::pair<uint64_t, uint64_t> undo_stack_revision_range() const;
+
+   /// Mirror the database's revision range before registering as an undo participant. The existing
+   /// sessions are marked dirty: they may hold auth writes this cache never saw.
+   void align_to( std::pair<uint64_t, uint64_t> range );
+
+private:
+   struct satisfied_entry {
+      permission_level           permission;
+      uint16_t                   depth_limit = 0;
+      flat_set<public_key_type>  provided_keys;
+      flat_set<permission_level> provided_permissions;
+      flat_set<public_key_type>  used_keys;
+   };
+
+   struct relevant_key {
+      permission_level declared_auth;
+      account_name     code;
+      action_name      act;
+
+      friend bool operator==( const relevant_key&, const relevant_key& ) = default;
+   };
+
+   struct relevant_key_hash {
+      size_t operator()( const relevant_key& k ) const;
+   };
+
+   static size_t satisfied_hash( const permission_level& permission, uint16_t depth_limit, size_t provided_hash );
+
+   void clear_locked();
+
+   mutable std::mutex                                      _mtx;
+   std::unordered_multimap<size_t, satisfied_entry>        _satisfied;
+   std::unordered_set<relevant_key, relevant_key_hash>     _relevant;
+   std::deque<bool>                                        _dirty;     // one per open undo session; true if it invalidated
+   int64_t                                                 _revision = 0;
+};
+
+/// Adapts authority_check_cache to chainbase::abstract_index so the database drives its undo
+/// lifecycle in lockstep with the segment indices, exactly like dedup_undo_index. Only lifecycle
+/// events are dispatched here; lookups never go through chainbase.
+class authority_cache_undo_index final : public chainbase::abstract_index {
+public:
+   /// Reserved type id, below the transaction dedup participant and above any real chainbase object type.
+   static constexpr uint16_t reserved_type_id = 0xFFFD;
+
+   explicit authority_cache_undo_index(authority_check_cache& cache)
+   : chainbase::abstract_index(&cache), _cache(cache) {}
+
+   void     set_revision(uint64_t revision) override { _cache.set_revision(revision); }
+   void     add_undo_session() override              { _cache.add_undo_session(); }
+   int64_t  revision() const override                { return _cache.revision(); }
+   void     undo() const override                    { _cache.undo(); }
+   void     squash() const override                  { _cache.squash(); }
+   void     commit(int64_t revision) const override  { _cache.commit(revision); }
+   void     undo_all() const override                { _cache.undo_all(); }
+   uint32_t type_id() const override                 { return reserved_type_id; }
+   uint64_t row_count() const override               { return _cache.size(); }
+   size_t   freelist_memory_usage() const override   { return 0; }   // heap-backed, no segment freelist
+   const std::string& type_name() const override     { return _type_name; }
+   std::pair<uint64_t, uint64_t> undo_stack_revision_range() const override {
+      return _cache.undo_stack_revision_range();
+   }
+   void     remove_object(int64_t) override          {}   // not used: the cache has no segment objects
+
+private:
+   authority_check_cache& _cache;
+   const std::string      _type_name = "authority_check_cache";
+};
+
+} // namespace sysio::chain
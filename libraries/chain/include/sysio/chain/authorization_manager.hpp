@@ -2,6 +2,7 @@
 
 #include <sysio/chain/types.hpp>
 #include <sysio/chain/permission_object.hpp>
+#include <sysio/chain/authority_check_cache.hpp>
 #include <sysio/chain/snapshot.hpp>
 
 #include <utility>
@@ -106,11 +107,23 @@ namespace sysio { namespace chain {
                                                     )const;
 
 
+         /**
+          *  @brief Drop cached authorization check results
+          *
+          *  Must be called on every write to a permission_object or permission_link_object that does not go
+          *  through create_permission / modify_permission / remove_permission (e.g. linkauth and unlinkauth).
+          */
+         void invalidate_check_cache() { _check_cache.invalidate(); }
+
+         /// The cache of successful authorization checks; the controller registers it as a database undo participant.
+         authority_check_cache& check_cache() { return _check_cache; }
+
          static std::function<void()> _noop_checktime;
 
       private:
-         const controller&    _control;
-         chainbase::database& _db;
+         const controller&              _control;
+         chainbase::database&           _db;
+         mutable authority_check_cache  _check_cache;
 
          void             check_updateauth_authorization( const updateauth& update, const vector<permission_level>& auths )const;
          void             check_deleteauth_authorization( const deleteauth& del, const vector<permission_level>& auths )const;
@@ -33,6 +33,10 @@ namespace sysio { namespace chain {
       }
    };
 
+   // signed_block::transactions is a vector: unpack sizes it with one allocation, and building a block moves
+   // receipts when it grows
+   static_assert(std::is_nothrow_move_constructible_v<transaction_receipt>);
+
    namespace detail {
       template<typename... Ts>
       struct block_extension_types {
@@ -74,7 +78,7 @@ namespace sysio { namespace chain {
       static mutable_block_ptr create_mutable_block(const signed_block_header& h) { return std::unique_ptr<signed_block>(new signed_block(h)); }
       static signed_block_ptr  create_signed_block(mutable_block_ptr&& b) { b->pack(); return signed_block_ptr{std::move(b)}; }
 
-      deque<transaction_receipt>   transactions; /// new or generated transactions
+      vector<transaction_receipt>  transactions; /// new or generated transactions
       std::optional<qc_t>          qc;
       extensions_type              block_extensions;
 
@@ -120,6 +120,15 @@ namespace sysio { namespace chain {
           */
          static void smoke_test(const std::filesystem::path& block_dir, uint32_t n);
 
+         /**
+          * Unpack and hash every block of blocks.log, checking its block number, its link to the previous block and
+          * its trailing position against blocks.index. The index is split into one contiguous range per thread and
+          * the ranges are validated in parallel; links across range boundaries are checked once all are done.
+          * Throws block_log_exception on the first inconsistency.
+          * @returns the number of blocks validated
+          */
+         static uint32_t full_validate(const std::filesystem::path& block_dir, uint32_t threads);
+
          static void split_blocklog(const std::filesystem::path& block_dir, const std::filesystem::path& dest_dir, uint32_t stride);
          static void merge_blocklogs(const std::filesystem::path& block_dir, const std::filesystem::path& dest_dir);
    private:
@@ -170,7 +170,7 @@ public:
 
    block_state(const block_header_state&                bhs,
                deque<transaction_metadata_ptr>&&        trx_metas,
-               deque<transaction_receipt>&&             trx_receipts,
+               vector<transaction_receipt>&&            trx_receipts,
                const std::optional<valid_t>&            valid,
                const std::optional<qc_t>&               qc,
                const signer_callback_type&              signer,
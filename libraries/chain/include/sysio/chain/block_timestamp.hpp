@@ -89,9 +89,16 @@ namespace std {
 }
 
 
+#include <fc/io/raw_fwd.hpp>
 #include <fc/reflect/reflect.hpp>
 FC_REFLECT(sysio::chain::block_timestamp_type, (slot))
 
+namespace fc::raw {
+   static_assert( sizeof(sysio::chain::block_timestamp_type) == sizeof(uint32_t) );
+   template<uint16_t IntervalMs, uint64_t EpochMs>
+   inline constexpr bool has_raw_layout_v<sysio::chain::block_timestamp<IntervalMs,EpochMs>> = true;
+}
+
 namespace fc {
   template<uint16_t IntervalMs, uint64_t EpochMs>
   void to_variant(const sysio::chain::block_timestamp<IntervalMs,EpochMs>& t, fc::variant& v) {
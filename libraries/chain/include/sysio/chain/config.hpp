@@ -15,6 +15,7 @@ namespace sysio::chain::config {
   const static auto safety_filename             = "safety.dat";
   const static auto chain_head_filename         = "chain_head.dat";
   const static auto transaction_dedup_filename  = "transaction_dedup.bin";
+  const static auto kv_cold_store_filename      = "kv_cold.bin";
   static constexpr auto default_state_size            = 1*1024*1024*1024ll;
   static constexpr auto default_state_guard_size      =    128*1024*1024ll;
 
@@ -122,6 +123,12 @@ namespace sysio::chain::config {
   static constexpr uint32_t   max_kv_value_size_limit           = 1024*1024; ///< absolute max for value size (1 MiB)
   // Iterator limit is hardcoded (ephemeral per-transaction, bounded by CPU)
   static constexpr uint32_t   max_kv_iterators                  = 1024;
+  // Row limit for one batched KV call (kv_get_many, kv_set_many, kv_erase_many, kv_it_read_batch)
+  static constexpr uint32_t   max_kv_batch_rows                 = 512;
+  // Node-local spilling of large, rarely written KV values to the cold store file (see kv_cold_store)
+  static constexpr uint32_t   default_kv_cold_min_age_blocks    = 2*60*60;           ///< blocks a value must go unwritten (1 hour)
+  static constexpr uint32_t   default_kv_cold_spills_per_lib    = 256;               ///< values spilled each time LIB advances
+  static constexpr uint64_t   default_kv_cold_max_size          = 64ull*1024*1024*1024; ///< cold store file size limit (64 GiB)
 
 #ifdef SYSIO_SYS_VM_JIT_RUNTIME_ENABLED
   static constexpr auto default_wasm_runtime = sysio::chain::wasm_interface::vm_type::sys_vm_jit;
@@ -1,6 +1,9 @@
 #pragma once
 #include <sysio/chain/types.hpp>
 
+#include <optional>
+#include <unordered_map>
+
 namespace sysio { namespace chain {
    class contract_action_match {
    public:
@@ -21,10 +24,54 @@ namespace sysio { namespace chain {
 
       bool is_action_match(const name& action_name) const;
 
+      match_type contract_type() const { return contract_match_type; }
+
+      const name& contract_name() const { return contract_match_name; }
+
       const name root_name;
 
       private:
+      name contract_match_name;
+      match_type contract_match_type;
       matcher contract_matcher;
       std::vector<matcher> action_matchers;
    };
-} } // namespace sysio::chain
\ No newline at end of file
+
+   /**
+    * Evaluates a list of contract_action_match against (contract, action) pairs, returning the first
+    * match in list order as a linear scan would. Matches are indexed by the exact name, prefix or suffix
+    * they test for, so only those that can apply to a contract are tried, and the outcome for every
+    * (contract, action) pair is remembered; the steady state is one hash lookup per action trace
+    * regardless of how many matches are configured.
+    *
+    * Not thread safe.
+    */
+   class contract_action_matcher {
+   public:
+      explicit contract_action_matcher(std::vector<contract_action_match> matches);
+
+      /// @returns the first match for contract and action, or nullptr
+      const contract_action_match* find(const name& contract, const name& action) const;
+
+      const std::vector<contract_action_match>& matches() const { return _matches; }
+
+   private:
+      static constexpr size_t max_memoized = 64 * 1024;
+
+      using key_type = std::pair<name, name>;
+      struct key_hash {
+         size_t operator()(const key_type& k) const {
+            return std::hash<name>()(k.first) ^ (std::hash<name>()(k.second) * 0x9e3779b97f4a7c15ull);
+         }
+      };
+      using index_type = std::unordered_map<name, std::vector<uint32_t>>;
+
+      std::optional<uint32_t> evaluate(const name& contract, const name& action) const;
+
+      std::vector<contract_action_match>                              _matches;
+      index_type                                                      _by_exact;
+      index_type                                                      _by_prefix;
+      index_type                                                      _by_suffix;
+      mutable std::unordered_map<key_type, std::optional<uint32_t>, key_hash> _memo;
+   };
+} } // namespace sysio::chain
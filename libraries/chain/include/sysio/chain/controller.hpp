@@ -4,6 +4,7 @@
 #include <sysio/chain/block_log.hpp>
 #include <sysio/chain/trace.hpp>
 #include <sysio/chain/genesis_state.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <chainbase/pinnable_mapped_file.hpp>
 #include <boost/signals2/signal.hpp>
 #include <fc/crypto/signature_provider.hpp>
@@ -101,6 +102,7 @@ namespace sysio::chain {
    class account_metadata_object;
    class deep_mind_handler;
    class subjective_billing;
+   class wasm_profiler;
    using resource_limits::resource_limits_manager;
    using apply_handler = std::function<void(apply_context&)>;
 
@@ -170,12 +172,15 @@ namespace sysio::chain {
             validation_mode          block_validation_mode  = validation_mode::FULL;
 
             pinnable_mapped_file::map_mode db_map_mode      = pinnable_mapped_file::map_mode::mapped;
+            kv_cold_config           kv_cold;
 
             flat_set<account_name>   resource_greylist;
             flat_set<account_name>   trusted_producers;
             uint32_t                 greylist_limit         = chain::config::maximum_elastic_resource_multiplier;
 
             flat_set<account_name>   profile_accounts;
+            flat_set<account_name>   wasm_profile_accounts;
+            fc::microseconds         wasm_profile_interval  = fc::milliseconds(1);
          };
 
          enum class block_status {
@@ -276,6 +281,7 @@ namespace sysio::chain {
          const protocol_feature_manager&       get_protocol_feature_manager()const;
          const subjective_billing&             get_subjective_billing()const;
          subjective_billing&                   get_mutable_subjective_billing();
+         kv_cold_store&                        get_mutable_kv_cold_store();
 
          //        limit,greylisted,unlimited
          std::tuple<int64_t, bool, bool> get_cpu_limit(account_name a) const;
@@ -403,6 +409,10 @@ namespace sysio::chain {
 
          fc::crypto::blake3 calculate_integrity_hash();
          void write_snapshot( const snapshot_writer_ptr& snapshot );
+         /// Undo every applied block above the fork database root, so that head() is the last irreversible
+         /// block and a snapshot written next can be loaded against the block log. The popped blocks stay in
+         /// the fork database and are applied again on the next startup.
+         void pop_to_fork_db_root();
          // thread-safe
          bool is_writing_snapshot()const;
 
@@ -462,6 +472,8 @@ namespace sysio::chain {
          bool contracts_console()const;
 
          bool is_profiling(account_name name) const;
+         /// sampling profiler of wasm-profile-account receivers, nullptr when none are configured
+         wasm_profiler* get_wasm_profiler() const;
 
          bool is_sys_vm_oc_whitelisted(const account_name& n) const;
 
@@ -28,9 +28,12 @@ namespace sysio { namespace chain {
           *         all changes up to and including Leap 5.0.
           *   - 3 : global_property_object now holds proposed_fin_pol_block_num and proposed_fin_pol,
           *         and removes kv_configuration in Spring 1.0
+          *   - 4 : kv_object values may be spilled to the kv cold store file, leaving an empty value blob
+          *         and a kv_cold_object locator. Version 3 databases are upgraded in place; older
+          *         builds must not open a version 4 database as they would read spilled values as empty.
           */
 
-         static constexpr uint32_t current_version            = 3;
+         static constexpr uint32_t current_version            = 4;
          static constexpr uint32_t minimum_version            = 3;
 
          id_type        id;
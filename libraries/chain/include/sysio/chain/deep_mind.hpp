@@ -5,6 +5,10 @@
 #include <sysio/chain/types.hpp>
 #include <sysio/chain/block.hpp>
 
+#include <memory>
+
+namespace fc { class dmlog_binary_writer; }
+
 namespace sysio::chain {
 
 class kv_object;
@@ -50,6 +54,8 @@ public:
    void update_config(deep_mind_config config);
 
    void update_logger(const std::string& logger_name);
+   /// Emit binary framed records through writer instead of the text logger; nullptr restores text output.
+   void update_binary_writer(std::shared_ptr<fc::dmlog_binary_writer> writer);
    enum class operation_qualifier { none, modify, push };
 
    void on_startup(chainbase::database& db, uint32_t head_block_num);
@@ -72,7 +78,7 @@ public:
    void on_send_inline();
    void on_send_context_free_inline();
    void on_kv_set(const kv_object& obj, bool is_new, account_name old_payer = account_name(), const char* old_value = nullptr, std::size_t old_value_size = 0);
-   void on_kv_erase(const kv_object& obj);
+   void on_kv_erase(const kv_object& obj, const char* value, std::size_t value_size);
    void on_init_resource_limits(const resource_limits::resource_limits_config_object& config, const resource_limits::resource_limits_state_object& state);
    void on_update_resource_limits_config(const resource_limits::resource_limits_config_object& config);
    void on_update_resource_limits_state(const resource_limits::resource_limits_state_object& state);
@@ -90,6 +96,7 @@ private:
    ram_trace        _ram_trace;
    deep_mind_config _config;
    fc::logger       _logger;
+   std::shared_ptr<fc::dmlog_binary_writer> _binary;
 };
 
 }
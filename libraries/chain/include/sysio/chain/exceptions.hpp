@@ -570,6 +570,8 @@ namespace sysio { namespace chain {
                                     3160022, "KV key not found" )
       FC_DECLARE_DERIVED_EXCEPTION( kv_secondary_key_too_large,          contract_exception,
                                     3160023, "KV secondary key exceeds maximum allowed size" )
+      FC_DECLARE_DERIVED_EXCEPTION( kv_batch_malformed,                  contract_exception,
+                                    3160024, "Malformed KV batch" )
 
    FC_DECLARE_DERIVED_EXCEPTION( producer_exception,           chain_exception,
                                  3170000, "Producer exception" )
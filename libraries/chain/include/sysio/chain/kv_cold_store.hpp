@@ -0,0 +1,156 @@
+#pragma once
+
+#include <sysio/chain/exceptions.hpp>
+#include <sysio/chain/kv_table_objects.hpp>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <filesystem>
+#include <string_view>
+
+namespace sysio { namespace chain {
+
+   /**
+    * @brief Locator of a kv_object value that was spilled to the cold store file.
+    *
+    * A spilled kv_object keeps its key, payer and position in every index; only its value bytes leave
+    * shared memory and its value blob is left empty. Cold rows are node-local: the index is in no
+    * snapshot section and does not feed the integrity hash. A locator is created by spilling and
+    * removed by the next write of its row, or by a later spill() once its row has been removed; each of
+    * these is undone together with the kv_object changes of the same undo session.
+    */
+   class kv_cold_object : public chainbase::object<kv_cold_object_type, kv_cold_object> {
+      OBJECT_CTOR(kv_cold_object)
+
+   public:
+      id_type              id;
+      kv_object::id_type   kv_id;       ///< the kv_object whose value this is
+      uint64_t             offset = 0;  ///< position of the value in the cold store file
+      uint32_t             size   = 0;  ///< value size in bytes, never 0
+   };
+
+   struct by_kv_id;
+
+   using kv_cold_index = chainbase::shared_multi_index_container<
+      kv_cold_object,
+      indexed_by<
+         ordered_unique<tag<by_id>,
+            member<kv_cold_object, kv_cold_object::id_type, &kv_cold_object::id>
+         >,
+         ordered_unique<tag<by_kv_id>,
+            member<kv_cold_object, kv_object::id_type, &kv_cold_object::kv_id>
+         >
+      >
+   >;
+
+   struct kv_cold_config {
+      uint32_t value_threshold = 0;  ///< values of at least this many bytes may be spilled, 0 disables spilling
+      uint32_t min_age_blocks  = config::default_kv_cold_min_age_blocks;
+      uint32_t spills_per_lib  = config::default_kv_cold_spills_per_lib;
+      uint64_t max_size        = config::default_kv_cold_max_size;
+   };
+
+   struct kv_cold_stats {
+      bool     spilling   = false;  ///< false when spilling is disabled, or once the file filled up or failed
+      uint64_t max_size   = 0;
+      uint64_t file_size  = 0;
+      uint64_t cold_rows  = 0;
+      uint64_t live_bytes = 0;      ///< bytes of values the state refers to
+      uint64_t dead_bytes = 0;      ///< bytes of values rewritten or removed since the file last started over
+   };
+
+   /**
+    * @brief Append-only file in the state directory holding kv_object values spilled out of chain state.
+    *
+    * Each time LIB advances, spill() continues a scan of the kv rows by id and moves values of at least
+    * value_threshold bytes that no action has written for min_age_blocks to the end of the file, up to
+    * spills_per_lib of them. The file is mapped read-only once, over max_size bytes, so a cold value is
+    * read in place through the page cache, which acts as the cache of recently used cold values; the
+    * mapping is never moved, so views returned by value() stay valid while the store is open. Writing
+    * a cold row brings its new value into chain state; removing one leaves its locator for spill() to
+    * drop later, so the removed row still reads its value in state history deltas.
+    *
+    * Spilling never changes what a contract, RAM billing, a snapshot or the integrity hash observes;
+    * readers go through kv_value() and kv_value_size(). Space of values that were rewritten or removed
+    * is not reused; the file starts over whenever no row in the state is cold, e.g. after loading a
+    * snapshot or compacting the state. stats() reports how much of the file is dead, and the db_size API
+    * shows it.
+    *
+    * The file is only opened when spilling is enabled or the state refers to it; a read-only node opens it
+    * read-only to read the values that are cold and never spills.
+    */
+   class kv_cold_store {
+   public:
+      explicit kv_cold_store(chainbase::database& db);
+      ~kv_cold_store();
+
+      kv_cold_store(const kv_cold_store&) = delete;
+      kv_cold_store& operator=(const kv_cold_store&) = delete;
+
+      /// Open the cold store file in dir. kv_cold_index must already be registered with the database.
+      void open(const std::filesystem::path& dir, const kv_cold_config& cfg, bool read_only);
+      void close();
+      bool is_open() const { return _fd >= 0; }
+
+      /// The cold value a locator refers to.
+      std::string_view value(const kv_cold_object& c) const;
+
+      /// Called before an action replaces a row's value, or after it creates a row: drops the cold copy
+      /// and remembers the write for the age check.
+      void on_write(const kv_object& o, size_t new_value_size);
+
+      /// Spill candidates once LIB has reached lib_num and drop locators of removed rows; returns the
+      /// number of values spilled.
+      uint32_t spill(uint32_t lib_num);
+
+      /// Size and usage of the file; walks the locators, so meant for diagnostics.
+      kv_cold_stats stats() const;
+
+      /// The store open for db, or nullptr.
+      static const kv_cold_store* find(const chainbase::database& db);
+
+   private:
+      const kv_cold_object* find_cold(const kv_object& o) const;
+      bool                  spill_row(const kv_object& o);
+      void                  reap_removed();
+
+      chainbase::database&                                  _db;
+      kv_cold_config                                        _cfg;
+      std::filesystem::path                                 _path;
+      bool                                                  _read_only = false;
+      bool                                                  _spilling  = false;  ///< cleared when the file is full or fails
+      int                                                   _fd        = -1;
+      const char*                                           _base      = nullptr;
+      uint64_t                                              _map_size  = 0;
+      uint64_t                                              _end       = 0;      ///< file size, where the next value goes
+      kv_object::id_type                                    _next_id;            ///< where the next spill() scan starts
+      kv_cold_object::id_type                               _next_cold_id;       ///< where the next reap_removed() scan starts
+      boost::unordered_flat_map<int64_t, uint32_t>          _written;            ///< kv row id -> block of last large write
+      size_t                                                _prune_at  = 0;
+   };
+
+   /// Value of a kv row, read from the cold store if it was spilled. Only a row with a locator looks up the store.
+   inline std::string_view kv_value(const chainbase::database& db, const kv_object& o) {
+      if (!o.value.empty()) [[likely]]
+         return {o.value.data(), o.value.size()};
+      const kv_cold_object* c = db.find<kv_cold_object, by_kv_id>(o.id);
+      if (!c)
+         return {};
+      const kv_cold_store* store = kv_cold_store::find(db);
+      SYS_ASSERT( store, database_exception, "kv row {} is cold but no kv cold store is open", o.id._id );
+      return store->value(*c);
+   }
+
+   /// Size of the value of a kv row, taken from its locator if it was spilled.
+   inline size_t kv_value_size(const chainbase::database& db, const kv_object& o) {
+      if (!o.value.empty()) [[likely]]
+         return o.value.size();
+      const kv_cold_object* c = db.find<kv_cold_object, by_kv_id>(o.id);
+      return c ? c->size : 0;
+   }
+
+} } // namespace sysio::chain
+
+CHAINBASE_SET_INDEX_TYPE(sysio::chain::kv_cold_object, sysio::chain::kv_cold_index)
+
+FC_REFLECT( sysio::chain::kv_cold_stats, (spilling)(max_size)(file_size)(cold_rows)(live_bytes)(dead_bytes) )
@@ -3,6 +3,13 @@
 #include <sysio/chain/types.hpp>
 #include <sysio/chain/config.hpp>
 #include <sysio/chain/exceptions.hpp>
+#include <sysio/chain/kv_table_objects.hpp>
+#include <array>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <cstring>
 #include <cstdint>
@@ -86,6 +93,8 @@ inline void kv_check_prefix_size(uint32_t prefix_size) {
 // carry only the data the operation needs.
 // ---------------------------------------------------------------------------
 
+inline constexpr uint32_t kv_slot_npos = std::numeric_limits<uint32_t>::max();
+
 struct kv_iterator_slot_common {
    bool              in_use = false;
    kv_it_stat        status = kv_it_stat::iterator_end;
@@ -112,6 +121,11 @@ struct kv_secondary_slot : kv_iterator_slot_common {
    std::vector<char>  current_sec_key;  ///< current secondary key bytes
    std::vector<char>  current_pri_key;  ///< current primary key bytes
 
+   // Links in the pool's per-object list of slots caching the same cached_id.  Maintained by
+   // kv_secondary_iterator_pool::set_cached_id; never touch directly.
+   uint32_t           cache_prev = kv_slot_npos;
+   uint32_t           cache_next = kv_slot_npos;
+
    void reset() {
       status    = kv_it_stat::iterator_end;
       cached_id = -1;
@@ -120,6 +134,38 @@ struct kv_secondary_slot : kv_iterator_slot_common {
    }
 };
 
+// ---------------------------------------------------------------------------
+// Slot allocator shared by both iterator pools
+//
+// Handles are consensus-observable (see "Handle encoding" above), so every
+// node must hand out the same slot for the same sequence of allocate/release
+// calls: allocate() always returns the LOWEST free slot.  A bitmap of free
+// slots finds it in at most max_kv_iterators / 64 word scans instead of a
+// linear walk over the slot array.
+// ---------------------------------------------------------------------------
+class kv_slot_allocator {
+public:
+   kv_slot_allocator() { _free.fill(~uint64_t(0)); }
+
+   /// Lowest free slot index, or kv_slot_npos when all slots are in use.
+   uint32_t allocate() {
+      for (uint32_t w = 0; w < _free.size(); ++w) {
+         if (_free[w]) {
+            const uint32_t bit = static_cast<uint32_t>(std::countr_zero(_free[w]));
+            _free[w] &= _free[w] - 1;
+            return w * 64 + bit;
+         }
+      }
+      return kv_slot_npos;
+   }
+
+   void release(uint32_t slot_index) { _free[slot_index / 64] |= uint64_t(1) << (slot_index % 64); }
+
+private:
+   static_assert(config::max_kv_iterators % 64 == 0, "kv_slot_allocator bitmap assumes whole words");
+   std::array<uint64_t, config::max_kv_iterators / 64> _free;
+};
+
 // ---------------------------------------------------------------------------
 // Primary iterator pool (kv_it_*)
 //
@@ -135,7 +181,9 @@ public:
    uint32_t allocate(uint16_t table_id, account_name code,
                      const char* prefix, uint32_t prefix_size) {
       if (_slots.empty()) _slots.resize(config::max_kv_iterators);
-      uint32_t idx = find_free();
+      uint32_t idx = _allocator.allocate();
+      SYS_ASSERT(idx != kv_slot_npos, kv_iterator_limit_exceeded,
+                 "exceeded maximum number of KV primary iterators ({})", config::max_kv_iterators);
       auto& s = _slots[idx];
       s.reset();
       s.in_use   = true;
@@ -151,7 +199,7 @@ public:
       auto& s = _slots[slot_index];
       s.reset();
       s.in_use = false;
-      if (slot_index < _next_free) _next_free = slot_index;
+      _allocator.release(slot_index);
    }
 
    kv_primary_slot& get(uint32_t slot_index) {
@@ -167,20 +215,8 @@ public:
    }
 
 private:
-   uint32_t find_free() {
-      for (uint32_t i = _next_free; i < _slots.size(); ++i) {
-         if (!_slots[i].in_use) {
-            _next_free = i + 1;
-            return i;
-         }
-      }
-      SYS_THROW(kv_iterator_limit_exceeded,
-                "exceeded maximum number of KV primary iterators ({})",
-                config::max_kv_iterators);
-   }
-
    std::vector<kv_primary_slot> _slots;
-   uint32_t _next_free = 0;
+   kv_slot_allocator            _allocator;
 };
 
 // ---------------------------------------------------------------------------
@@ -189,6 +225,11 @@ private:
 // Independent free-list from the primary pool so a contract may hold up to
 // max_kv_iterators of each kind simultaneously.  Lazily sized on first
 // allocate(), same as the primary pool.
+//
+// Slots caching the same kv_index_object id are threaded on an intrusive
+// list headed in _by_cached_id, so invalidate_cache() touches only those
+// slots instead of scanning the whole array.  Every write of a secondary
+// slot's cached_id must go through set_cached_id() to keep the lists exact.
 // ---------------------------------------------------------------------------
 class kv_secondary_iterator_pool {
 public:
@@ -196,7 +237,9 @@ public:
 
    uint32_t allocate(account_name code, uint16_t table_id) {
       if (_slots.empty()) _slots.resize(config::max_kv_iterators);
-      uint32_t idx = find_free();
+      uint32_t idx = _allocator.allocate();
+      SYS_ASSERT(idx != kv_slot_npos, kv_iterator_limit_exceeded,
+                 "exceeded maximum number of KV secondary iterators ({})", config::max_kv_iterators);
       auto& s = _slots[idx];
       s.reset();
       s.in_use   = true;
@@ -209,9 +252,10 @@ public:
       SYS_ASSERT(slot_index < _slots.size() && _slots[slot_index].in_use,
                  kv_invalid_iterator, "invalid KV secondary iterator slot {}", slot_index);
       auto& s = _slots[slot_index];
+      unlink(slot_index);
       s.reset();
       s.in_use = false;
-      if (slot_index < _next_free) _next_free = slot_index;
+      _allocator.release(slot_index);
    }
 
    kv_secondary_slot& get(uint32_t slot_index) {
@@ -226,36 +270,141 @@ public:
       return _slots[slot_index];
    }
 
+   /// Set slot.cached_id (-1 for none), keeping the reverse map in step.  slot must come from get().
+   void set_cached_id(kv_secondary_slot& slot, int64_t id) {
+      if (slot.cached_id == id) return;
+      const auto slot_index = static_cast<uint32_t>(&slot - _slots.data());
+      unlink(slot_index);
+      slot.cached_id = id;
+      if (id < 0) return;
+      auto [it, inserted] = _by_cached_id.try_emplace(id, slot_index);
+      if (!inserted) {
+         slot.cache_next = it->second;
+         _slots[it->second].cache_prev = slot_index;
+         it->second = slot_index;
+      }
+   }
+
    // Clears cached_id on any slot referencing the given kv_index_object id.
    // Preserves stored key bytes and iterator status so the next op uses the
    // slow re-seek path from the old position.  Used before db.modify of a
    // secondary entry where the chainbase id survives but the object's sort
    // position moves.
    void invalidate_cache(account_name code, uint16_t table_id, int64_t object_id) {
-      for (auto& s : _slots) {
-         if (s.in_use &&
-             s.code == code && s.table_id == table_id &&
-             s.cached_id == object_id) {
-            s.cached_id = -1;
-         }
+      auto it = _by_cached_id.find(object_id);
+      if (it == _by_cached_id.end()) return;
+      for (uint32_t i = it->second; i != kv_slot_npos;) {
+         auto& s = _slots[i];
+         const uint32_t next = s.cache_next;
+         if (s.code == code && s.table_id == table_id)
+            set_cached_id(s, -1);
+         i = next;
       }
    }
 
 private:
-   uint32_t find_free() {
-      for (uint32_t i = _next_free; i < _slots.size(); ++i) {
-         if (!_slots[i].in_use) {
-            _next_free = i + 1;
-            return i;
+   // Remove slot_index from the list of its current cached_id, if any.
+   void unlink(uint32_t slot_index) {
+      auto& s = _slots[slot_index];
+      if (s.cached_id < 0) return;
+      if (s.cache_prev != kv_slot_npos) {
+         _slots[s.cache_prev].cache_next = s.cache_next;
+      } else if (s.cache_next != kv_slot_npos) {
+         _by_cached_id[s.cached_id] = s.cache_next;
+      } else {
+         _by_cached_id.erase(s.cached_id);
+      }
+      if (s.cache_next != kv_slot_npos)
+         _slots[s.cache_next].cache_prev = s.cache_prev;
+      s.cache_prev = s.cache_next = kv_slot_npos;
+   }
+
+   std::vector<kv_secondary_slot>          _slots;
+   kv_slot_allocator                       _allocator;
+   std::unordered_map<int64_t, uint32_t>   _by_cached_id; ///< cached_id -> first slot caching it
+};
+
+// ---------------------------------------------------------------------------
+// Primary row lookup cache (per transaction)
+//
+// Maps (code, table_id, key bytes) to the kv_object last found, stored or
+// updated under that key by any action of the transaction, so the
+// contains/get/set sequence a typical action issues against one row walks the
+// by_code_key index once.  Only rows known to exist are cached; a miss always
+// falls through to the index.
+//
+// kv_set and kv_erase are the only paths that create or remove kv_objects
+// while a transaction executes, and they write through to the cache.
+// chainbase keeps a node's address across modify, so a cached pointer stays
+// valid until the row is erased or the transaction's undo session is rolled
+// back; transaction_context clears the cache on undo.  A lookup returns
+// exactly what the index would have, so the cache is invisible to consensus.
+//
+// Open-addressed with a bounded probe window: an insert that finds the window
+// full replaces the home slot, so the table never grows past its capacity.
+// ---------------------------------------------------------------------------
+class kv_lookup_cache {
+public:
+   static constexpr uint32_t capacity     = 256; ///< power of two
+   static constexpr uint32_t probe_window = 4;
+
+   const kv_object* find(account_name code, uint16_t table_id, std::string_view key) const {
+      const size_t h = hash(code, table_id, key);
+      for (uint32_t i = 0; i < probe_window; ++i) {
+         const auto& e = _entries[(h + i) & (capacity - 1)];
+         if (e.obj && e.hash == h && matches(*e.obj, code, table_id, key))
+            return e.obj;
+      }
+      return nullptr;
+   }
+
+   void store(const kv_object& obj) {
+      const size_t h = hash(obj.code, obj.table_id, obj.key_view());
+      entry* empty = nullptr;
+      for (uint32_t i = 0; i < probe_window; ++i) {
+         auto& e = _entries[(h + i) & (capacity - 1)];
+         if (e.obj == &obj || (e.obj && e.hash == h && matches(*e.obj, obj.code, obj.table_id, obj.key_view()))) {
+            e.obj = &obj;
+            return;
          }
+         if (!e.obj && !empty)
+            empty = &e;
+      }
+      auto& target = empty ? *empty : _entries[h & (capacity - 1)];
+      target.obj  = &obj;
+      target.hash = h;
+   }
+
+   /// Drop the entry for obj, if cached.  Must be called before obj is removed from the database.
+   void erase(const kv_object& obj) {
+      const size_t h = hash(obj.code, obj.table_id, obj.key_view());
+      for (uint32_t i = 0; i < probe_window; ++i) {
+         auto& e = _entries[(h + i) & (capacity - 1)];
+         if (e.obj == &obj)
+            e.obj = nullptr;
       }
-      SYS_THROW(kv_iterator_limit_exceeded,
-                "exceeded maximum number of KV secondary iterators ({})",
-                config::max_kv_iterators);
    }
 
-   std::vector<kv_secondary_slot> _slots;
-   uint32_t _next_free = 0;
+   void clear() { _entries.fill({}); }
+
+private:
+   struct entry {
+      const kv_object* obj  = nullptr;
+      size_t           hash = 0;
+   };
+
+   static size_t hash(account_name code, uint16_t table_id, std::string_view key) {
+      size_t h = std::hash<std::string_view>{}(key);
+      h ^= code.to_uint64_t() + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+      h ^= table_id + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+      return h;
+   }
+
+   static bool matches(const kv_object& o, account_name code, uint16_t table_id, std::string_view key) {
+      return o.code == code && o.table_id == table_id && o.key_view() == key;
+   }
+
+   std::array<entry, capacity> _entries{};
 };
 
 } } // namespace sysio::chain
@@ -3,6 +3,7 @@
 #include <sysio/chain/thread_utils.hpp>
 #include <sysio/chain/types.hpp>
 #include <fc/io/raw.hpp>
+#include <algorithm>
 #include <bit>
 #include <array>
 #include <future>
@@ -113,5 +114,86 @@ inline digest_type calculate_merkle(const Cont& ids) {
    return calculate_merkle(ids.begin(), ids.end()); // cbegin not supported for std::span until C++23.
 }
 
+// --------------------------------------------------------------------------
+// merkle_chunk_precompute:
+// ------------------------
+// overlaps merkle hashing with the growth of a digest sequence, so that the
+// root of a block's receipt digests is mostly computed by the time the block
+// is assembled.
+//
+// calculate_merkle splits a sequence of n digests into power-of-two subtrees
+// following the binary representation of n, each starting at an offset that
+// is a multiple of its size. Every aligned chunk of `chunk_size` digests that
+// lies entirely within the sequence is therefore a subtree of the final tree,
+// whatever the final length turns out to be. `update` hashes each newly
+// completed chunk on the merkle thread pool (from a copy, so the caller may
+// keep appending to and reallocating its sequence); `root` combines the chunk
+// roots with the remaining tail and returns exactly calculate_merkle(digests).
+//
+// `truncate` must be called whenever the sequence shrinks (block restore
+// points) so that chunks no longer fully contained are discarded.
+//
+// Not thread safe; intended to be owned by a single building block.
+// --------------------------------------------------------------------------
+class merkle_chunk_precompute {
+public:
+   static constexpr size_t chunk_size = 1024;
+   static_assert(std::has_single_bit(chunk_size));
+
+   void update(const digests_t& digests) {
+      while ((chunks.size() + 1) * chunk_size <= digests.size()) {
+         auto begin = digests.begin() + chunks.size() * chunk_size;
+         chunks.emplace_back(post_async_task(detail::get_merkle_thread_pool(),
+                                             [chunk = digests_t(begin, begin + chunk_size)]() {
+                                                return detail::calculate_merkle_pow2(chunk.begin(), chunk.end());
+                                             }).share());
+      }
+   }
+
+   void truncate(size_t size) {
+      chunks.resize(std::min(chunks.size(), size / chunk_size));
+   }
+
+   digest_type root(const digests_t& digests) {
+      truncate(digests.size());
+      chunk_roots.clear();
+      chunk_roots.reserve(chunks.size());
+      for (auto& c : chunks)
+         chunk_roots.push_back(c.get());
+      return merkle_range(digests, 0, digests.size());
+   }
+
+private:
+   // mirrors calculate_merkle(start, end) over [offset, offset + size)
+   digest_type merkle_range(const digests_t& digests, size_t offset, size_t size) const {
+      if (size <= 1)
+         return (size == 0) ? digest_type{} : digests[offset];
+      auto midpoint = std::bit_floor(size);
+      if (size == midpoint)
+         return merkle_pow2(digests, offset, size);
+      return detail::hash_combine(merkle_pow2(digests, offset, midpoint),
+                                  merkle_range(digests, offset + midpoint, size - midpoint));
+   }
+
+   // mirrors detail::calculate_merkle_pow2 over [offset, offset + size), substituting precomputed chunk roots
+   digest_type merkle_pow2(const digests_t& digests, size_t offset, size_t size) const {
+      const size_t covered = chunk_roots.size() * chunk_size;
+      if (size >= chunk_size && offset + size <= covered) {
+         auto first = chunk_roots.begin() + offset / chunk_size;
+         if (size == chunk_size)
+            return *first;
+         return detail::calculate_merkle_pow2(first, first + size / chunk_size);
+      }
+      if (size > chunk_size && offset < covered) {
+         auto half = size / 2;
+         return detail::hash_combine(merkle_pow2(digests, offset, half), merkle_pow2(digests, offset + half, half));
+      }
+      auto start = digests.begin() + offset;
+      return detail::calculate_merkle_pow2<digests_t::const_iterator, true>(start, start + size);
+   }
+
+   std::vector<std::shared_future<digest_type>> chunks;
+   digests_t                                    chunk_roots;
+};
 
 } /// sysio::chain
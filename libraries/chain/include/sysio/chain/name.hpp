@@ -1,5 +1,6 @@
 #pragma once
 #include <fc/basic_name.hpp>
+#include <fc/io/raw_fwd.hpp>
 #include <fc/reflect/reflect.hpp>
 
 #include <cstdint>
@@ -164,3 +165,9 @@ namespace std {
 };
 
 FC_REFLECT_DERIVED_EMPTY( sysio::chain::name, (fc::basic_name<sysio::chain::sysio_name_traits>) )
+
+namespace fc::raw {
+   static_assert( sizeof(sysio::chain::name) == sizeof(uint64_t) );
+   template<>
+   inline constexpr bool has_raw_layout_v<sysio::chain::name> = true;
+}
@@ -22,16 +22,16 @@ public:
       return chain::block_header::num_from_id(block_id);
    }
 
-   static fs::path get_final_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir) {
-      return snapshots_dir / fc::format_string("snapshot-${id}.bin", fc::mutable_variant_object()("id", block_id));
+   static fs::path get_final_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir, const std::string& extension = "bin") {
+      return snapshots_dir / fc::format_string("snapshot-${id}.${ext}", fc::mutable_variant_object()("id", block_id)("ext", extension));
    }
 
-   static fs::path get_pending_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir) {
-      return snapshots_dir / fc::format_string(".pending-snapshot-${id}.bin", fc::mutable_variant_object()("id", block_id));
+   static fs::path get_pending_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir, const std::string& extension = "bin") {
+      return snapshots_dir / fc::format_string(".pending-snapshot-${id}.${ext}", fc::mutable_variant_object()("id", block_id)("ext", extension));
    }
 
-   static fs::path get_temp_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir) {
-      return snapshots_dir / fc::format_string(".incomplete-snapshot-${id}.bin", fc::mutable_variant_object()("id", block_id));
+   static fs::path get_temp_path(const chain::block_id_type& block_id, const fs::path& snapshots_dir, const std::string& extension = "bin") {
+      return snapshots_dir / fc::format_string(".incomplete-snapshot-${id}.${ext}", fc::mutable_variant_object()("id", block_id)("ext", extension));
    }
 
    // call only with lib_id that is irreversible
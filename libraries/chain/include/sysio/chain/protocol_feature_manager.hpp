@@ -18,6 +18,7 @@ enum class builtin_protocol_feature_t : uint32_t {
    reserved_second_protocol_feature = 1, // used for tests, no functionality
    // 2-24+ reserved, used by Spring, new wire protocol features should start at 500001
    reserved_private_fork_protocol_features = 500000,
+   kv_batch_intrinsics = 500001,
 };
 
 struct protocol_feature_subjective_restrictions {
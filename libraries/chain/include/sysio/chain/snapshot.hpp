@@ -18,9 +18,11 @@
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <streambuf>
+#include <string_view>
 
 
 namespace sysio { namespace chain {
@@ -427,6 +429,13 @@ namespace sysio { namespace chain {
          /// Returns the root hash (valid only after finalize()).
          fc::crypto::blake3 get_root_hash() const { return root_hash_; }
 
+         /// Raw section API for rows that are already packed, e.g. a section reconstructed from a
+         /// differential snapshot. begin_raw_section / write_raw / end_raw_section replace a
+         /// write_section() call; end_raw_section returns the section hash.
+         void begin_raw_section(const std::string& section_name) { write_start_section(section_name); }
+         void write_raw(const char* data, size_t size) { hash_os_.write(data, size); }
+         fc::crypto::blake3 end_raw_section(uint64_t row_count);
+
       protected:
          void write_start_section( const std::string& section_name ) override;
          void write_row( const detail::abstract_snapshot_row_writer& row_writer ) override;
@@ -518,7 +527,18 @@ namespace sysio { namespace chain {
     */
    class threaded_snapshot_reader : public snapshot_reader {
       public:
-         explicit threaded_snapshot_reader(const std::filesystem::path& snapshot_path);
+         /// Called before a section's data is read; blocks until the section's bytes are in place and
+         /// their hash verified, or throws. May be called concurrently from the load threads.
+         using section_gate = std::function<void(const snapshot_section_entry&)>;
+
+         /// validate_hashes = false only parses the index (see load_index()); for a file this node
+         /// wrote itself, e.g. the base of a differential snapshot.
+         explicit threaded_snapshot_reader(const std::filesystem::path& snapshot_path, bool validate_hashes = true);
+
+         /// Reader over a file whose sections are still arriving (see streaming_snapshot_fetcher).
+         /// Header, footer and index must already be in place; validate() checks only the root hash
+         /// over the index, and each section is verified by gate before it is read.
+         threaded_snapshot_reader(const std::filesystem::path& snapshot_path, section_gate gate);
 
          void validate() override;
          void set_section( const string& section_name ) override;
@@ -539,11 +559,20 @@ namespace sysio { namespace chain {
          /// Returns the root hash read from the file header (valid after validate()).
          fc::crypto::blake3 get_root_hash() const { return root_hash_; }
 
+         /// Section metadata parsed by load_index(), in file index order (sorted by name).
+         const std::vector<snapshot_section_entry>& sections() const { return section_index_; }
+
+         /// Packed row data of a section, straight from the mapping.
+         std::string_view section_data(const snapshot_section_entry& entry) const {
+            return { mapped_snap_addr + entry.data_offset, entry.data_size };
+         }
+
       private:
          fc::random_access_file                   snapshot_file;
          const boost::interprocess::mapped_region mapped_snap;
          const char* const                        mapped_snap_addr;
 
+         section_gate                             gate_;
          std::vector<snapshot_section_entry>       section_index_;
          fc::crypto::blake3                       root_hash_;
          bool                                     index_loaded_ = false;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <sysio/chain/snapshot.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sysio { namespace chain {
+   /**
+    * Differential snapshots.
+    *
+    * A differential snapshot records a full v1 snapshot (the "target") as edits against a base v1
+    * snapshot, identified by the base's root hash. Each target section is split into content-defined
+    * chunks (gear rolling hash, so an inserted or removed row only disturbs the chunks around it);
+    * chunks whose bytes also occur in the same-named base section are stored as copy references,
+    * everything else as literal bytes. Unchanged rows therefore cost a few bytes per chunk, and the
+    * section index records the target's per-section hash and row count so the target can be
+    * reconstructed byte-for-byte and verified.
+    *
+    * File format v1:
+    *   [Header]  (40 bytes)
+    *     magic:          uint32_t  (0x46494457 "WDIF" - bytes 'W','D','I','F' on disk)
+    *     version:        uint32_t  (1)
+    *     base_root_hash: char[32]  (root hash of the base snapshot)
+    *
+    *   [Section Data] per section, a sequence of ops:
+    *     copy:     uint8_t 0, base_offset: uint64_t, size: uint64_t  (bytes of the same-named base section)
+    *     literal:  uint8_t 1, size: uint64_t, bytes
+    *
+    *   [Section Index] (num_sections entries, sorted by section name)
+    *     name:         null-terminated string
+    *     data_offset:  uint64_t  (of the section's ops, from start of file)
+    *     data_size:    uint64_t
+    *     row_count:    uint64_t  (of the target section)
+    *     target_size:  uint64_t
+    *     target_hash:  char[32]  (BLAKE3 of the target section row data)
+    *
+    *   [Footer]  (44 bytes)
+    *     num_sections: uint32_t
+    *     root_hash:    char[32]  (root hash of the target snapshot)
+    *     index_offset: uint64_t
+    *
+    * Applying a diff (apply_snapshot_diff) writes the reconstructed target as an ordinary v1 snapshot,
+    * so loading is unchanged; its root hash is the same value integrity_hash_snapshot_writer computes
+    * for the target state.
+    */
+   static const uint32_t current_snapshot_diff_version = 1;
+
+   namespace detail {
+      /// Content-defined chunking shared by diff creation and base indexing: both sides must cut
+      /// identical chunks out of identical bytes.
+      struct snapshot_chunker {
+         static constexpr size_t   min_chunk = 2 * 1024;
+         static constexpr size_t   max_chunk = 64 * 1024;
+         static constexpr uint64_t cut_mask  = (1u << 13) - 1; // ~8 KiB average chunk
+
+         /// Length of the chunk starting at data; never more than size or max_chunk. Data shorter
+         /// than max_chunk without a boundary is returned whole, so callers streaming bytes must only
+         /// cut once max_chunk bytes are buffered or the section has ended.
+         static size_t cut(const char* data, size_t size);
+      };
+   }
+
+   class differential_snapshot_writer : public snapshot_writer {
+      public:
+         static constexpr uint32_t magic_number = 0x46494457;
+
+         /// base must outlive the writer; it is validated on construction of threaded_snapshot_reader.
+         differential_snapshot_writer(std::filesystem::path diff_path, std::shared_ptr<threaded_snapshot_reader> base);
+
+         const char* name() const override { return "differential snapshot"; }
+
+         /// Diff a section whose rows are already packed, e.g. one read from another snapshot file.
+         void write_raw_section(const std::string& section_name, uint64_t row_count, std::string_view data);
+
+         /// Write index and footer. Must be called after all sections are written.
+         void finalize();
+
+         /// Root hash of the target snapshot (valid only after finalize()).
+         fc::crypto::blake3 get_root_hash() const { return root_hash_; }
+         fc::crypto::blake3 get_base_root_hash() const { return base_->get_root_hash(); }
+
+         /// Bytes of target section data stored as copy references / literals so far.
+         uint64_t copied_bytes() const { return copied_bytes_; }
+         uint64_t literal_bytes() const { return literal_bytes_; }
+
+      protected:
+         void write_start_section( const std::string& section_name ) override;
+         void write_row( const detail::abstract_snapshot_row_writer& row_writer ) override;
+         void write_end_section() override;
+
+      private:
+         struct section_entry {
+            std::string        name;
+            uint64_t           data_offset = 0;
+            uint64_t           data_size = 0;
+            uint64_t           row_count = 0;
+            uint64_t           target_size = 0;
+            fc::crypto::blake3 target_hash;
+         };
+
+         struct base_chunk {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+         };
+
+         /// Forwards row bytes into the chunker.
+         class row_streambuf : public std::streambuf {
+         public:
+            explicit row_streambuf(differential_snapshot_writer& w) : writer_(w) {}
+         protected:
+            int_type overflow(int_type ch) override;
+            std::streamsize xsputn(const char_type* s, std::streamsize count) override;
+         private:
+            differential_snapshot_writer& writer_;
+         };
+
+         void append(const char* data, size_t size);
+         void cut_chunks(bool end_of_section);
+         void emit_chunk(const char* data, size_t size);
+         void flush_copy();
+         void flush_literal();
+
+         std::filesystem::path                      diff_path_;
+         std::shared_ptr<threaded_snapshot_reader>  base_;
+         std::ofstream                              out_;
+         row_streambuf                              row_sbuf_{*this};
+         std::ostream                               row_os_{&row_sbuf_};
+         detail::ostream_wrapper                    wrapper_{row_os_};
+
+         // current section
+         section_entry                              current_;
+         std::string_view                           base_data_;
+         std::unordered_multimap<size_t, base_chunk> base_chunks_;
+         std::vector<char>                          pending_;        // target bytes not yet cut into a chunk
+         blake3_encoder                             target_hasher_;
+         std::optional<base_chunk>                  pending_copy_;
+         std::vector<char>                          pending_literal_;
+
+         std::vector<section_entry>                 sections_;
+         fc::crypto::blake3                         root_hash_;
+         uint64_t                                   copied_bytes_ = 0;
+         uint64_t                                   literal_bytes_ = 0;
+   };
+
+   /// Reconstruct the target of diff_path against base_path as a full v1 snapshot at out_path.
+   /// Throws snapshot_exception if the diff was not made against this base, or if any reconstructed
+   /// section or the final root hash does not match what the diff recorded. Returns the root hash.
+   fc::crypto::blake3 apply_snapshot_diff(const std::filesystem::path& base_path,
+                                          const std::filesystem::path& diff_path,
+                                          const std::filesystem::path& out_path);
+
+   /// Apply a chain of diffs, each made against the target of the previous one (the first against
+   /// base_path), writing the final full snapshot to out_path. Returns its root hash.
+   fc::crypto::blake3 apply_snapshot_diffs(const std::filesystem::path& base_path,
+                                           const std::vector<std::filesystem::path>& diff_paths,
+                                           const std::filesystem::path& out_path);
+
+   /// Diff two existing full snapshots. Returns the target root hash recorded in the diff.
+   fc::crypto::blake3 create_snapshot_diff(const std::filesystem::path& base_path,
+                                           const std::filesystem::path& target_path,
+                                           const std::filesystem::path& diff_path);
+
+}}
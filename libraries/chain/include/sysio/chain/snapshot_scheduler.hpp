@@ -47,6 +47,10 @@ public:
       uint32_t start_block_num = 0;
       uint32_t end_block_num = std::numeric_limits<uint32_t>::max();
       std::string snapshot_description = "";
+      // recurring requests only: 0 writes every snapshot in full; otherwise a full snapshot is written
+      // every full_snapshot_spacing blocks (a multiple of block_spacing) and the snapshots in between
+      // are differential snapshots (snapshot-<id>.diff) against the request's latest full snapshot
+      uint32_t full_snapshot_spacing = 0;
    };
 
    // this struct used to hold request params in api call
@@ -56,6 +60,7 @@ public:
       std::optional<uint32_t> start_block_num;
       std::optional<uint32_t> end_block_num;
       std::optional<std::string> snapshot_description;
+      std::optional<uint32_t> full_snapshot_spacing;
    };
 
    struct snapshot_request_id_information {
@@ -81,6 +86,7 @@ public:
    struct snapshot_schedule_information : public snapshot_request_id_information, public snapshot_request_information {
       std::vector<snapshot_information> pending_snapshots;
       request_callback caller; // not serialized
+      std::optional<block_id_type> last_full_snapshot; // not serialized; base of this request's differential snapshots
    };
 
    struct get_snapshot_requests_result {
@@ -124,6 +130,7 @@ public:
                ssi.block_spacing = req.second.get<uint32_t>("block_spacing");
                ssi.start_block_num = req.second.get<uint32_t>("start_block_num");
                ssi.end_block_num = req.second.get<uint32_t>("end_block_num");
+               ssi.full_snapshot_spacing = req.second.get<uint32_t>("full_snapshot_spacing", 0);
                sr.push_back(ssi);
             }
          } catch(std::ifstream::failure& e) {
@@ -145,6 +152,7 @@ public:
             node.put("block_spacing", key.block_spacing);
             node.put("start_block_num", key.start_block_num);
             node.put("end_block_num", key.end_block_num);
+            node.put("full_snapshot_spacing", key.full_snapshot_spacing);
             node_srs.push_back(std::make_pair("", node));
          }
 
@@ -323,19 +331,25 @@ public:
 
    // execute snapshot request srid; caller (may be null) is the request's shared callback slot, and
    // the snapshot answers whoever is still waiting there in addition to the scheduler's own
-   // bookkeeping handler
-   void execute_snapshot(uint32_t srid, chain::controller& chain, request_callback caller);
+   // bookkeeping handler. A diff_base writes a differential snapshot against that block's snapshot.
+   void execute_snapshot(uint32_t srid, chain::controller& chain, request_callback caller,
+                         std::optional<block_id_type> diff_base = {});
 
-   // former producer_plugin snapshot fn
-   void create_snapshot(next_function<snapshot_information> next, chain::controller& chain);
+   // former producer_plugin snapshot fn; with diff_base, writes a differential snapshot against the
+   // (pending or final) snapshot of that block, or a full snapshot if that file is gone
+   void create_snapshot(next_function<snapshot_information> next, chain::controller& chain,
+                        std::optional<block_id_type> diff_base = {});
+
+   // full snapshot of block_id on disk, finalized or still pending; empty if there is none
+   fs::path find_snapshot_file(const block_id_type& block_id) const;
 };
 
 
 }// namespace sysio::chain
 
 FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_information, (head_block_id) (head_block_num) (head_block_time) (version) (snapshot_name) (root_hash))
-FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_request_information, (block_spacing) (start_block_num) (end_block_num) (snapshot_description))
-FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_request_params, (block_spacing) (start_block_num) (end_block_num) (snapshot_description))
+FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_request_information, (block_spacing) (start_block_num) (end_block_num) (snapshot_description) (full_snapshot_spacing))
+FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_request_params, (block_spacing) (start_block_num) (end_block_num) (snapshot_description) (full_snapshot_spacing))
 FC_REFLECT(sysio::chain::snapshot_scheduler::snapshot_request_id_information, (snapshot_request_id))
 FC_REFLECT(sysio::chain::snapshot_scheduler::get_snapshot_requests_result, (snapshot_requests))
 FC_REFLECT_DERIVED(sysio::chain::snapshot_scheduler::snapshot_schedule_information, (sysio::chain::snapshot_scheduler::snapshot_request_id_information)(sysio::chain::snapshot_scheduler::snapshot_request_information), (pending_snapshots))
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <sysio/chain/controller.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <cstdint>
+#include <filesystem>
+
+namespace sysio { namespace chain {
+
+   /// Size and fragmentation of a chain state segment.
+   struct chain_state_stats {
+      uint64_t size = 0;
+      uint64_t free_bytes = 0;
+      uint64_t used_bytes = 0;
+      /// Freed object buffers parked on the small-size allocator free lists. They are counted as used by
+      /// the segment manager and can only be reused by objects of the same size class.
+      uint64_t reclaimable_bytes = 0;
+      uint64_t row_count = 0;
+
+      static chain_state_stats from_db( const chainbase::database& db );
+
+      /// Share of used bytes that are parked on free lists rather than holding live rows.
+      double fragmentation() const {
+         return used_bytes ? double(reclaimable_bytes) / double(used_bytes) : 0.0;
+      }
+   };
+
+   struct state_compaction_result {
+      uint32_t          head_block_num = 0;
+      chain_state_stats before;
+      chain_state_stats after;
+   };
+
+   /**
+    * Rebuild the chain state in cfg.state_dir into a fresh segment.
+    *
+    * chainbase never returns freed buffers to the segment manager, and the small-size allocator keeps
+    * freed nodes on per-size free lists, so a long-running state accumulates capacity that only objects
+    * of the same size can reuse and live rows scattered across the whole mapping. Compaction opens the
+    * existing state, rewinds it to the last irreversible block, writes it out as a snapshot and loads
+    * that snapshot into a new state directory; loading inserts the rows of every index in index order
+    * into a segment with no free lists. Reversible blocks above the root stay in the fork database and
+    * are applied again when the rebuilt state starts, so no undo history is lost.
+    *
+    * The rebuilt directory replaces cfg.state_dir only after it loaded successfully. Work files live
+    * next to the state directory, so the file system must have room for a snapshot and a second state
+    * file. cfg.blocks_dir must be the node's block log, which the snapshot is checked against.
+    */
+   state_compaction_result compact_chain_state( const controller::config& cfg,
+                                                const std::filesystem::path& protocol_features_dir,
+                                                const chain_id_type& chain_id );
+
+}}
+
+FC_REFLECT( sysio::chain::chain_state_stats, (size)(free_bytes)(used_bytes)(reclaimable_bytes)(row_count) )
+FC_REFLECT( sysio::chain::state_compaction_result, (head_block_num)(before)(after) )
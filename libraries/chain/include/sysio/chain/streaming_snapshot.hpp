@@ -0,0 +1,132 @@
+#pragma once
+
+#include <sysio/chain/snapshot.hpp>
+
+#include <fc/crypto/blake3.hpp>
+#include <fc/io/random_access_file.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace sysio { namespace chain {
+
+   /**
+    * Random-access byte source of a v1 snapshot file that is fetched rather than opened, e.g. the
+    * ranged /v1/snapshot/download endpoint of snapshot_api_plugin.
+    */
+   class snapshot_range_source {
+   public:
+      virtual ~snapshot_range_source() = default;
+
+      /// Total size of the snapshot file in bytes.
+      virtual uint64_t size() const = 0;
+
+      /// Read exactly size bytes at offset into out, or throw. Called concurrently from the fetch threads.
+      virtual void read(uint64_t offset, uint64_t size, char* out) = 0;
+   };
+
+   /// Range source over a local snapshot file; serves tests and file-to-file copies.
+   class file_snapshot_range_source : public snapshot_range_source {
+   public:
+      explicit file_snapshot_range_source(const std::filesystem::path& path);
+
+      uint64_t size() const override { return size_; }
+      void read(uint64_t offset, uint64_t size, char* out) override;
+
+   private:
+      fc::random_access_file file_;
+      uint64_t               size_ = 0;
+   };
+
+   /**
+    * Downloads a v1 snapshot with parallel ranged reads while it is being loaded.
+    *
+    * start() fetches the header, footer and section index, checks the index against the expected
+    * root hash, and then fetches every section in fixed-size chunks on background threads, writing
+    * them in place into a preallocated file. reader() returns a threaded_snapshot_reader over that
+    * file whose section gate blocks until the requested section has arrived and its BLAKE3 hash
+    * matches the index; a section that is waited on before its fetch began is moved to the front of
+    * the queue. Loading therefore overlaps the transfer, and the total time approaches
+    * max(download, load) rather than their sum.
+    *
+    * Every byte the reader hands out is covered by a verified section hash, and the section hashes by
+    * the expected root hash, so the integrity guarantees match loading a fully downloaded file.
+    * Destroying the fetcher before the download completes stops the threads and removes the file.
+    */
+   class streaming_snapshot_fetcher {
+   public:
+      static constexpr uint64_t default_chunk_size = 16 * 1024 * 1024;
+
+      streaming_snapshot_fetcher(std::shared_ptr<snapshot_range_source> source, std::filesystem::path dest,
+                                 fc::crypto::blake3 expected_root_hash, uint32_t threads,
+                                 uint64_t chunk_size = default_chunk_size);
+      ~streaming_snapshot_fetcher();
+
+      streaming_snapshot_fetcher(const streaming_snapshot_fetcher&) = delete;
+      streaming_snapshot_fetcher& operator=(const streaming_snapshot_fetcher&) = delete;
+
+      /// Fetch and verify the section index, then start fetching sections. Throws snapshot_exception
+      /// if the file is not a v1 snapshot or its root hash is not the expected one.
+      void start();
+
+      /// Gated reader over the destination file; valid after start(). The fetcher must outlive it.
+      std::shared_ptr<threaded_snapshot_reader> reader() const { return reader_; }
+
+      /// Block until the section has arrived and verified. Rethrows the first fetch failure.
+      void wait_for(const snapshot_section_entry& entry);
+
+      /// Block until every section has arrived and verified. Rethrows the first fetch failure.
+      void wait_all();
+
+      const std::filesystem::path& path() const { return dest_; }
+      uint64_t fetched_bytes() const { return fetched_bytes_; }
+
+   private:
+      struct chunk {
+         size_t   section = 0;
+         uint64_t offset  = 0;
+         uint64_t size    = 0;
+      };
+
+      struct section_state {
+         size_t remaining_chunks = 0;
+         bool   verified = false;
+      };
+
+      void fetch_range(uint64_t offset, uint64_t size);
+      void run_worker();
+      void stop();
+      void discard();  ///< stop, close and remove the destination file
+      void rethrow_if_failed() const;
+
+      std::shared_ptr<snapshot_range_source>    source_;
+      std::filesystem::path                     dest_;
+      fc::crypto::blake3                        expected_root_hash_;
+      uint32_t                                  num_threads_;
+      uint64_t                                  chunk_size_;
+
+      std::optional<fc::random_access_file>     file_;
+      std::shared_ptr<threaded_snapshot_reader> reader_;
+
+      mutable std::mutex                        mtx_;
+      std::condition_variable                   cv_;
+      std::deque<chunk>                         queue_;
+      std::vector<section_state>                sections_;
+      size_t                                    sections_left_ = 0;
+      bool                                      started_ = false;  ///< every section is queued or verified
+      std::exception_ptr                        failure_;
+      bool                                      stopping_ = false;
+      std::atomic<uint64_t>                     fetched_bytes_ = 0;
+      std::vector<std::thread>                  threads_;
+   };
+
+}}
@@ -1,5 +1,6 @@
 #pragma once
 #include <sysio/chain/controller.hpp>
+#include <sysio/chain/kv_context.hpp>
 #include <sysio/chain/trace.hpp>
 #include <sysio/chain/platform_timer.hpp>
 
@@ -214,6 +215,9 @@ namespace sysio::chain {
          accounts_billing_t            accounts_billing;
          flat_set<account_name>        validate_ram_usage;
 
+         /// primary KV rows looked up or written by this transaction; cleared on undo
+         kv_lookup_cache               kv_row_cache;
+
          /// the maximum number of virtual CPU instructions of the transaction that can be safely billed to the billable accounts
          uint64_t                      initial_max_billable_cpu = 0;
 
@@ -309,6 +309,7 @@ namespace sysio::chain {
       contract_root_object_type,
       kv_object_type,
       kv_index_object_type,
+      kv_cold_object_type,
       OBJECT_TYPE_COUNT ///< Sentry value which contains the number of different object types
    };
 
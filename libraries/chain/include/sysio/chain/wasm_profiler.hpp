@@ -0,0 +1,124 @@
+#pragma once
+
+#include <sysio/chain/types.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sysio { namespace chain {
+
+   /**
+    * Opt-in sampling profiler that attributes contract CPU time to WASM functions.
+    *
+    * While an action of a profiled account runs on sys-vm-oc or sys-vm-jit, a CPU-time timer of the
+    * executing thread interrupts it every interval. The signal handler only stores the interrupted
+    * program counter in a thread-local buffer. When the action finishes, the executing thread maps the
+    * buffered addresses to function indices through the resolver the runtime supplied and adds them to
+    * per (code_hash, function) counts. Samples that fall outside the contract's machine code, in host
+    * functions or the runtime, are counted per code hash as host samples.
+    *
+    * Only the interrupted function is recorded, not its callers. Function names come from the "name"
+    * custom section of the contract and are resolved when a report is built. Sampling needs per-thread
+    * CPU-time timers and is only available on Linux; elsewhere profiled actions run unsampled.
+    */
+   class wasm_profiler {
+   public:
+      /// Map a sampled program counter to the index of a defined function (its position in the code
+      /// section), or std::nullopt if the address is not in the contract's machine code.
+      using resolver_type = std::function<std::optional<uint32_t>(uintptr_t pc)>;
+
+      /// Layout of the functions of a WASM module, parsed from its binary.
+      struct function_table {
+         uint32_t                                   imported_functions = 0;
+         /// [begin, end) offsets in the module binary of each defined function body
+         std::vector<std::pair<uint32_t, uint32_t>> bodies;
+         /// function index (imports included) to name, from the "name" custom section
+         std::map<uint32_t, std::string>            names;
+
+         /// Defined function index of the body holding offset, an offset into the module binary.
+         std::optional<uint32_t> function_at(uint32_t offset) const;
+         /// Name of a defined function, or "f<index>" when the module does not name it.
+         std::string name_of(uint32_t defined_index) const;
+
+         /// Malformed or truncated sections end parsing; the table then holds what was read.
+         static function_table parse(std::span<const char> wasm);
+      };
+
+      struct function_entry {
+         uint32_t    function_index = 0; ///< wasm function index, imports included
+         std::string name;
+         uint64_t    samples = 0;
+      };
+
+      struct code_entry {
+         digest_type                 code_hash;
+         std::vector<account_name>   accounts;       ///< profiled receivers that ran this code
+         uint64_t                    samples = 0;    ///< every sample taken while this code ran
+         uint64_t                    host_samples = 0;
+         std::vector<function_entry> functions;      ///< most sampled first
+      };
+
+      wasm_profiler(flat_set<account_name> accounts, fc::microseconds interval);
+      ~wasm_profiler();
+
+      bool is_profiling(account_name account) const { return _accounts.contains(account); }
+      fc::microseconds interval() const { return _interval; }
+
+      /// Samples the calling thread from construction to destruction. Not reentrant on one thread.
+      class scoped_sampling {
+      public:
+         scoped_sampling(wasm_profiler& profiler, const digest_type& code_hash, account_name receiver, resolver_type resolver);
+         ~scoped_sampling();
+
+         scoped_sampling(const scoped_sampling&) = delete;
+         scoped_sampling& operator=(const scoped_sampling&) = delete;
+
+      private:
+         wasm_profiler& _profiler;
+         digest_type    _code_hash;
+         account_name   _receiver;
+         resolver_type  _resolver;
+         bool           _armed = false;
+      };
+
+      /// Function layout of code_hash, parsed from the code in db on first use and cached.
+      std::shared_ptr<const function_table> get_function_table(const chainbase::database& db, const digest_type& code_hash);
+
+      /// Aggregated samples, most sampled code first; db provides the contract code for function names.
+      std::vector<code_entry> report(const chainbase::database& db);
+
+      /// Folded stacks for flamegraph.pl and compatible tools: "<accounts>@<code_hash>;<function> <samples>".
+      static std::string collapsed(const std::vector<code_entry>& report);
+
+      void reset();
+
+   private:
+      struct code_samples {
+         flat_set<account_name>       accounts;
+         uint64_t                     host_samples = 0;
+         std::map<uint32_t, uint64_t> functions; ///< defined function index to samples
+      };
+
+      void add_samples(const digest_type& code_hash, account_name receiver, std::span<const uintptr_t> pcs,
+                       const resolver_type& resolver);
+
+      const flat_set<account_name>  _accounts;
+      const fc::microseconds        _interval;
+      std::mutex                    _mtx;
+      std::map<digest_type, code_samples> _samples; // guarded by _mtx
+      std::map<digest_type, std::shared_ptr<const function_table>> _tables; // guarded by _mtx
+   };
+
+}}
+
+FC_REFLECT(sysio::chain::wasm_profiler::function_entry, (function_index)(name)(samples))
+FC_REFLECT(sysio::chain::wasm_profiler::code_entry, (code_hash)(accounts)(samples)(host_samples)(functions))
@@ -837,6 +837,57 @@ namespace webassembly {
           */
          int32_t  kv_contains(uint32_t table_id, uint64_t code, span<const char> key);
 
+         // ---- KV Database API -- Batched Primary Operations ----
+         //
+         // Available once the KV_BATCH_INTRINSICS protocol feature is activated. Batches are packed as
+         // consecutive [u32 length][bytes] fields with unaligned little-endian lengths, at most
+         // config::max_kv_batch_rows (512) rows per call. Each row is processed exactly as the matching
+         // single-row intrinsic, with identical RAM billing; a malformed batch aborts with
+         // kv_batch_malformed.
+
+         /**
+          * Read the values for several keys from any contract's KV table.
+          *
+          * For each key, in order, dest receives [i32 value size, or -1 if the key does not exist]
+          * followed by the value bytes. If dest is too small, entries are written only up to the first
+          * one that does not fit; the full required size is still returned so the caller can allocate
+          * and retry.
+          *
+          * @param table_id - table namespace identifier (lower 16 bits of the DJB2 hash of table name)
+          * @param code - account whose KV table to read from
+          * @param keys - packed keys: [u32 key size][key] per row
+          * @param dest - destination buffer
+          * @return total size in bytes of the packed result
+          * @throws kv_batch_malformed if keys is not a well-formed packed array or has too many rows
+          */
+         int32_t  kv_get_many(uint32_t table_id, uint64_t code, span<const char> keys, span<char> dest);
+
+         /**
+          * Store or update several key-value pairs in the executing contract's KV table.
+          *
+          * Equivalent to calling kv_set for each row in order with the same payer.
+          *
+          * @param table_id - table namespace identifier (lower 16 bits of the DJB2 hash of table name)
+          * @param payer - account to bill for RAM, with the same rules as kv_set
+          * @param rows - packed rows: [u32 key size][key][u32 value size][value] per row
+          * @return sum of the per-row RAM byte deltas
+          * @throws kv_batch_malformed if rows is not a well-formed packed array or has too many rows
+          */
+         int64_t  kv_set_many(uint32_t table_id, uint64_t payer, span<const char> rows);
+
+         /**
+          * Erase several key-value pairs from the executing contract's KV table.
+          *
+          * Equivalent to calling kv_erase for each key in order.
+          *
+          * @param table_id - table namespace identifier (lower 16 bits of the DJB2 hash of table name)
+          * @param keys - packed keys: [u32 key size][key] per row
+          * @return sum of the per-row RAM refunds (negative)
+          * @throws kv_key_not_found if any key does not exist
+          * @throws kv_batch_malformed if keys is not a well-formed packed array or has too many rows
+          */
+         int64_t  kv_erase_many(uint32_t table_id, span<const char> keys);
+
          // ---- KV Database API -- Primary Iterators ----
          //
          // Iterators traverse keys lexicographically within a prefix scope.
@@ -935,6 +986,22 @@ namespace webassembly {
           */
          int32_t  kv_it_value(uint32_t handle, uint32_t offset, span<char> dest, aligned_ptr<uint32_t> actual_size);
 
+         /**
+          * Copy consecutive rows starting at the iterator's current position and advance past them.
+          *
+          * Each row is written as [u32 key size][key][u32 value size][value]. Copying stops at the end of
+          * the prefix range, after max_rows rows (capped at config::max_kv_batch_rows), or at the first row
+          * that does not fit in dest; the iterator is left positioned on the first row not copied, or in the
+          * end state. Returns 0 without copying if the iterator is not on a valid key. Requires the
+          * KV_BATCH_INTRINSICS protocol feature.
+          *
+          * @param handle - iterator handle
+          * @param max_rows - maximum number of rows to copy
+          * @param dest - destination buffer
+          * @return number of rows copied
+          */
+         int32_t  kv_it_read_batch(uint32_t handle, uint32_t max_rows, span<char> dest);
+
          // ---- KV Database API -- Secondary Index Operations ----
          //
          // Secondary indices map (sec_key -> pri_key) within a table namespace.
@@ -225,7 +225,7 @@ SYS_PIN_INTRINSIC( printhex,
                    void (interface::*)(span<const char>) );
 
 // =============================================================================
-// KV database (all 22 -- the biggest cleanup target by signature count)
+// KV database (all 26 -- the biggest cleanup target by signature count)
 // =============================================================================
 SYS_PIN_INTRINSIC( kv_set,
                    int64_t (interface::*)(uint32_t, uint64_t,
@@ -294,6 +294,18 @@ SYS_PIN_INTRINSIC( kv_idx_primary_key,
                                           aligned_ptr<uint32_t>) );
 SYS_PIN_INTRINSIC( kv_idx_destroy,
                    void (interface::*)(uint32_t) );
+SYS_PIN_INTRINSIC( kv_get_many,
+                   int32_t (interface::*)(uint32_t, uint64_t,
+                                          span<const char>,
+                                          span<char>) );
+SYS_PIN_INTRINSIC( kv_set_many,
+                   int64_t (interface::*)(uint32_t, uint64_t,
+                                          span<const char>) );
+SYS_PIN_INTRINSIC( kv_erase_many,
+                   int64_t (interface::*)(uint32_t, span<const char>) );
+SYS_PIN_INTRINSIC( kv_it_read_batch,
+                   int32_t (interface::*)(uint32_t, uint32_t,
+                                          span<char>) );
 
 // =============================================================================
 // Memory (struct-by-value params; pinned here because the argument unpack
@@ -198,7 +198,11 @@ inline constexpr auto get_intrinsic_table() {
       "env.kv_idx_prev",
       "env.kv_idx_key",
       "env.kv_idx_primary_key",
-      "env.kv_idx_destroy"
+      "env.kv_idx_destroy",
+      "env.kv_get_many",
+      "env.kv_set_many",
+      "env.kv_erase_many",
+      "env.kv_it_read_batch"
    );
 }
 inline constexpr std::size_t find_intrinsic_index(std::string_view hf) {
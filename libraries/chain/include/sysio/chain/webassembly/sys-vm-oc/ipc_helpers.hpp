@@ -9,6 +9,10 @@
 
 namespace sysio { namespace chain { namespace sysvmoc {
 
+/// Largest packed sysvmoc_message a datagram carries; anything bigger must be passed as an fd.
+static constexpr size_t max_message_size = 8192;
+static constexpr size_t max_num_fds = 4;
+
 class wrapped_fd {
    public:
       wrapped_fd() : _inuse(false) {}
@@ -39,7 +39,7 @@ struct code_compilation_result_message {
    int starting_memory_pages;
    unsigned initdata_prologue_size;
    fc::time_point queued_time;      // when compilation was queued to begin
-   //Two sent fds: 1) wasm code, 2) initial memory snapshot
+   //Three sent fds: 1) wasm code, 2) initial memory snapshot, 3) uint32_t code offset of each defined function
 };
 
 
@@ -35,6 +35,7 @@ struct code_descriptor {
    size_t initdata_begin;
    unsigned initdata_size;
    unsigned initdata_prologue_size;
+   unsigned function_count; ///< uint32_t code offsets of the defined functions, then the end of their code, follow the initdata, for wasm_profiler
 };
 
 enum sysvmoc_exitcode : int {
@@ -47,13 +48,13 @@ enum sysvmoc_exitcode : int {
 /// Version stamped into each cached code_descriptor; entries carrying a different version are recompiled.
 /// Bump together with code_cache.cpp's header_id whenever generated code would change for the same WASM:
 /// intrinsic-table renumbering, gs-region layout changes, or codegen logic changes.
-static constexpr uint8_t current_codegen_version = 3;
+static constexpr uint8_t current_codegen_version = 4;
 
 }
 
 FC_REFLECT(sysio::chain::sysvmoc::no_offset, );
 FC_REFLECT(sysio::chain::sysvmoc::code_offset, (offset));
 FC_REFLECT(sysio::chain::sysvmoc::intrinsic_ordinal, (ordinal));
-FC_REFLECT(sysio::chain::sysvmoc::code_descriptor, (code_hash)(vm_version)(codegen_version)(code_begin)(start)(apply_offset)(starting_memory_pages)(initdata_begin)(initdata_size)(initdata_prologue_size));
+FC_REFLECT(sysio::chain::sysvmoc::code_descriptor, (code_hash)(vm_version)(codegen_version)(code_begin)(start)(apply_offset)(starting_memory_pages)(initdata_begin)(initdata_size)(initdata_prologue_size)(function_count));
 
 #define SYSVMOC_INTRINSIC_INIT_PRIORITY __attribute__((init_priority(198)))
@@ -0,0 +1,251 @@
+#include <sysio/chain/kv_cold_store.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <fc/log/logger.hpp>
+#include <fc/scoped_exit.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sysio { namespace chain {
+
+namespace {
+   constexpr char     file_magic[8] = {'S', 'Y', 'S', 'K', 'V', 'C', 'L', 'D'};
+   constexpr uint32_t file_version  = 1;
+   constexpr uint64_t header_size   = 16;  ///< magic, version, reserved; offset 0 is never a value
+
+   /// kv rows examined per value spilled before a spill() call gives up for this LIB advance
+   constexpr uint32_t rows_scanned_per_spill = 64;
+
+   // Stores by database, so readers that only hold a database (state history, API lookups) find the file.
+   struct store_registry {
+      std::shared_mutex                                                 mtx;
+      std::map<const chainbase::database*, const kv_cold_store*>        stores;
+   };
+
+   store_registry& registry() {
+      static store_registry r;
+      return r;
+   }
+
+   bool write_all(int fd, const char* data, size_t size, uint64_t offset) {
+      while (size) {
+         const ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+         if (n < 0) {
+            if (errno == EINTR)
+               continue;
+            return false;
+         }
+         data   += n;
+         size   -= n;
+         offset += n;
+      }
+      return true;
+   }
+}
+
+kv_cold_store::kv_cold_store(chainbase::database& db)
+   : _db(db) {}
+
+kv_cold_store::~kv_cold_store() {
+   close();
+}
+
+void kv_cold_store::open(const std::filesystem::path& dir, const kv_cold_config& cfg, bool read_only) {
+   SYS_ASSERT( !is_open(), database_exception, "kv cold store {} is already open", _path.generic_string() );
+   _cfg       = cfg;
+   _read_only = read_only;
+   _path      = dir / config::kv_cold_store_filename;
+
+   const auto& idx = _db.get_index<kv_cold_index, by_id>();
+   if (idx.empty() && (read_only || cfg.value_threshold == 0))
+      return; // nothing to read and nothing to spill
+
+   _fd = ::open(_path.c_str(), read_only ? O_RDONLY | O_CLOEXEC : O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+   SYS_ASSERT( _fd >= 0, database_exception, "unable to open kv cold store {}: {}", _path.generic_string(), std::strerror(errno) );
+   auto close_on_error = fc::make_scoped_exit([this]() { close(); });
+
+   if (idx.empty()) {
+      // nothing in the state refers to the file: start over, dropping values that were rewritten or removed
+      char header[header_size] = {};
+      std::memcpy(header, file_magic, sizeof(file_magic));
+      std::memcpy(header + sizeof(file_magic), &file_version, sizeof(file_version));
+      SYS_ASSERT( ::ftruncate(_fd, 0) == 0 && write_all(_fd, header, sizeof(header), 0), database_exception,
+                  "unable to reset kv cold store {}: {}", _path.generic_string(), std::strerror(errno) );
+   }
+
+   struct stat st;
+   SYS_ASSERT( ::fstat(_fd, &st) == 0, database_exception, "unable to stat kv cold store {}: {}", _path.generic_string(), std::strerror(errno) );
+   _end = static_cast<uint64_t>(st.st_size);
+
+   char header[header_size] = {};
+   uint32_t version = 0;
+   SYS_ASSERT( _end >= header_size && ::pread(_fd, header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+               std::memcmp(header, file_magic, sizeof(file_magic)) == 0, database_exception,
+               "{} is not a kv cold store", _path.generic_string() );
+   std::memcpy(&version, header + sizeof(file_magic), sizeof(version));
+   SYS_ASSERT( version == file_version, database_exception, "kv cold store {} has unsupported version {}", _path.generic_string(), version );
+
+   // values are appended in the order their rows are created, so the newest row ends last
+   if (!idx.empty()) {
+      const auto& newest = *idx.rbegin();
+      SYS_ASSERT( newest.offset + newest.size <= _end, database_exception,
+                  "kv cold store {} holds {} bytes but the chain state refers to {}; it does not belong to this state",
+                  _path.generic_string(), _end, newest.offset + newest.size );
+   }
+
+   _map_size = std::max(_cfg.max_size, _end);
+   void* base = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, _fd, 0);
+   SYS_ASSERT( base != MAP_FAILED, database_exception, "unable to map kv cold store {}: {}", _path.generic_string(), std::strerror(errno) );
+   _base = static_cast<const char*>(base);
+   // cold values are read one at a time; reading ahead would only pull neighbouring values into memory
+   ::madvise(base, _map_size, MADV_RANDOM);
+
+   _spilling = !read_only && _cfg.value_threshold > 0;
+   {
+      std::unique_lock g(registry().mtx);
+      registry().stores[&_db] = this;
+   }
+   close_on_error.cancel();
+
+   if (!idx.empty())
+      ilog( "kv cold store {} holds {} values in {} bytes", _path.generic_string(), idx.size(), _end );
+}
+
+void kv_cold_store::close() {
+   {
+      std::unique_lock g(registry().mtx);
+      if (auto it = registry().stores.find(&_db); it != registry().stores.end() && it->second == this)
+         registry().stores.erase(it);
+   }
+   if (_base) {
+      ::munmap(const_cast<char*>(_base), _map_size);
+      _base = nullptr;
+   }
+   if (_fd >= 0) {
+      if (!_read_only && ::fdatasync(_fd) != 0)
+         elog( "unable to sync kv cold store {}: {}", _path.generic_string(), std::strerror(errno) );
+      ::close(_fd);
+      _fd = -1;
+   }
+   _spilling = false;
+   _written.clear();
+   _prune_at = 0;
+}
+
+const kv_cold_store* kv_cold_store::find(const chainbase::database& db) {
+   std::shared_lock g(registry().mtx);
+   auto it = registry().stores.find(&db);
+   return it != registry().stores.end() ? it->second : nullptr;
+}
+
+kv_cold_stats kv_cold_store::stats() const {
+   kv_cold_stats r{ .spilling = _spilling, .max_size = _map_size, .file_size = _end };
+   for (const kv_cold_object& c : _db.get_index<kv_cold_index, by_id>()) {
+      ++r.cold_rows;
+      r.live_bytes += c.size;
+   }
+   r.dead_bytes = _end - std::min(_end, header_size + r.live_bytes);
+   return r;
+}
+
+const kv_cold_object* kv_cold_store::find_cold(const kv_object& o) const {
+   if (!o.value.empty() || !is_open())
+      return nullptr;
+   return _db.find<kv_cold_object, by_kv_id>(o.id);
+}
+
+std::string_view kv_cold_store::value(const kv_cold_object& c) const {
+   SYS_ASSERT( is_open() && c.offset >= header_size && c.offset + c.size <= _end, database_exception,
+               "kv row {} refers to bytes [{}, {}) outside of kv cold store {}", c.kv_id._id, c.offset, c.offset + c.size,
+               _path.generic_string() );
+   return {_base + c.offset, c.size};
+}
+
+void kv_cold_store::on_write(const kv_object& o, size_t new_value_size) {
+   if (const kv_cold_object* c = find_cold(o))
+      _db.remove(*c);
+   if (_spilling && new_value_size >= _cfg.value_threshold)
+      _written[o.id._id] = static_cast<uint32_t>(_db.revision());
+}
+
+uint32_t kv_cold_store::spill(uint32_t lib_num) {
+   if (!_spilling)
+      return 0;
+
+   const auto written_recently = [&](const auto& w) { return w.second + _cfg.min_age_blocks > lib_num; };
+   if (_written.size() > _prune_at) {
+      boost::unordered::erase_if(_written, [&](const auto& w) { return !written_recently(w); });
+      _prune_at = std::max<size_t>(1024, 2 * _written.size());
+   }
+
+   const auto& idx = _db.get_index<kv_index, by_id>();
+   auto itr = idx.lower_bound(_next_id);
+   uint32_t spilled = 0;
+   for (uint32_t scanned = 0; itr != idx.end() && spilled < _cfg.spills_per_lib &&
+                              scanned < _cfg.spills_per_lib * rows_scanned_per_spill; ++scanned) {
+      const kv_object& o = *itr++;
+      if (o.value.size() < _cfg.value_threshold)
+         continue;
+      if (auto w = _written.find(o.id._id); w != _written.end() && written_recently(*w))
+         continue;
+      if (!spill_row(o))
+         break;
+      ++spilled;
+   }
+   // wrap around once the scan reaches the last row
+   _next_id = itr != idx.end() ? itr->id : kv_object::id_type(0);
+
+   reap_removed();
+   return spilled;
+}
+
+// Locators of removed rows are left in place by the transaction that removes the row, so the removed copy
+// kept by its undo session still reads its value for state history. Drop them here, once that session's
+// deltas have been produced; undoing that removal also undoes this.
+void kv_cold_store::reap_removed() {
+   const auto& idx = _db.get_index<kv_cold_index, by_id>();
+   auto itr = idx.lower_bound(_next_cold_id);
+   for (uint32_t scanned = 0; itr != idx.end() && scanned < _cfg.spills_per_lib; ++scanned) {
+      const kv_cold_object& c = *itr++;
+      if (!_db.find<kv_object>(c.kv_id))
+         _db.remove(c);
+   }
+   _next_cold_id = itr != idx.end() ? itr->id : kv_cold_object::id_type(0);
+}
+
+bool kv_cold_store::spill_row(const kv_object& o) {
+   const uint32_t size = o.value.size();
+   if (_end + size > _map_size) {
+      const kv_cold_stats st = stats();
+      wlog( "kv cold store {} reached its maximum size of {} bytes, no further values are spilled; {} of them hold "
+            "values that were rewritten or removed, reclaimed only once no row is cold, e.g. after loading a snapshot",
+            _path.generic_string(), _map_size, st.dead_bytes );
+      _spilling = false;
+      return false;
+   }
+   if (!write_all(_fd, o.value.data(), size, _end)) {
+      elog( "unable to write kv cold store {}, no further values are spilled: {}", _path.generic_string(), std::strerror(errno) );
+      _spilling = false;
+      return false;
+   }
+   _db.create<kv_cold_object>([&](kv_cold_object& c) {
+      c.kv_id  = o.id;
+      c.offset = _end;
+      c.size   = size;
+   });
+   _db.modify(o, [](kv_object& r) { r.value = std::string_view{}; });
+   _end += size;
+   return true;
+}
+
+} } // namespace sysio::chain
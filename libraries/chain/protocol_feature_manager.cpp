@@ -36,6 +36,21 @@ Example protocol feature. No functionality is triggered by this protocol feature
 Builtin protocol feature: RESERVED_SECOND_PROTOCOL_FEATURE
 
 Example protocol feature. No functionality is triggered by this protocol feature.
+*/
+            {}
+         } )
+         (  builtin_protocol_feature_t::kv_batch_intrinsics, builtin_protocol_feature_spec{
+            "KV_BATCH_INTRINSICS",
+            fc::variant("7a851a5e29d287be72cc91c60cc8cb81685821fe8b7cfefb5831a200a302d23b").as<digest_type>(),
+            // SHA256 hash of the raw message below within the comment delimiters (do not modify message below).
+            // SHA256 begins with "Builtin ..." after return and includes trailing return.
+/*
+Builtin protocol feature: KV_BATCH_INTRINSICS
+
+Adds the batched KV host functions kv_get_many, kv_set_many, kv_erase_many and kv_it_read_batch, which
+perform several primary-table reads or writes, or copy several consecutive iterator rows, in one WASM to
+host crossing. RAM billing is identical to issuing the equivalent single-row kv_get, kv_set, kv_erase,
+kv_it_key and kv_it_value calls; a single call is limited to config::max_kv_batch_rows rows.
 */
             {}
          } )
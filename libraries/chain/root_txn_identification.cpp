@@ -26,7 +26,7 @@ namespace sysio { namespace chain {
       using transactions = chain::deque<chain::transaction_id_type>;
       using contract_storage = std::unordered_map<chain::contract_root, transactions, chain::root_hash>;
 
-      contract_action_matches       contract_matches;
+      contract_action_matcher       contract_matcher;
       contract_storage              storage;
       std::optional<uint32_t>       current_block_num;
    };
@@ -41,7 +41,7 @@ namespace sysio { namespace chain {
    }
 
    root_txn_identification_impl::root_txn_identification_impl(contract_action_matches&& matches)
-   : contract_matches(std::move(matches))
+   : contract_matcher(std::move(matches))
    {
    }
 
@@ -106,26 +106,22 @@ namespace sysio { namespace chain {
          const auto& contract = act.account;
          const auto& action = act.name;
 
-         for (const auto& root_contract_match : contract_matches) {
-            if (root_contract_match.is_contract_match(contract) &&
-                root_contract_match.is_action_match(action)) {
-               // We have a match, so we need to store the transaction id
-               // in the storage for this contract.
-               //
-               // A single transaction can carry several traces that match the same
-               // (contract, root): one per matching action plus one per
-               // require_recipient notification, which replicates act.account/act.name
-               // for every notified receiver. The S-root merkle commits to the set of
-               // transactions that touched the contract, so each transaction id must
-               // contribute exactly one leaf per (contract, root). All traces of a
-               // transaction are delivered in a single call and a transaction id is
-               // applied (with a receipt) at most once per block, so a duplicate can
-               // only ever be the most recently stored id.
-               auto& contract_storage = this->storage[std::make_pair(contract, root_contract_match.root_name)];
-               if (contract_storage.empty() || contract_storage.back() != action_trace.trx_id) {
-                  contract_storage.push_back(action_trace.trx_id);
-               }
-               break;
+         if (const auto* root_contract_match = contract_matcher.find(contract, action)) {
+            // We have a match, so we need to store the transaction id
+            // in the storage for this contract.
+            //
+            // A single transaction can carry several traces that match the same
+            // (contract, root): one per matching action plus one per
+            // require_recipient notification, which replicates act.account/act.name
+            // for every notified receiver. The S-root merkle commits to the set of
+            // transactions that touched the contract, so each transaction id must
+            // contribute exactly one leaf per (contract, root). All traces of a
+            // transaction are delivered in a single call and a transaction id is
+            // applied (with a receipt) at most once per block, so a duplicate can
+            // only ever be the most recently stored id.
+            auto& contract_storage = this->storage[std::make_pair(contract, root_contract_match->root_name)];
+            if (contract_storage.empty() || contract_storage.back() != action_trace.trx_id) {
+               contract_storage.push_back(action_trace.trx_id);
             }
          }
       }
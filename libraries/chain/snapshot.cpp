@@ -272,6 +272,12 @@ void threaded_snapshot_writer::write_end_section() {
    sections_.push_back(std::move(info));
 }
 
+fc::crypto::blake3 threaded_snapshot_writer::end_raw_section(uint64_t row_count) {
+   current_row_count_ = row_count;
+   write_end_section();
+   return sections_.back().hash;
+}
+
 void threaded_snapshot_writer::finalize() {
    hash_os_.flush();
    SYS_ASSERT(hash_os_.good(), snapshot_exception,
@@ -460,10 +466,22 @@ size_t istream_json_snapshot_reader::total_row_count() {
 
 // ---- threaded_snapshot_reader (v1 binary format) ----
 
-threaded_snapshot_reader::threaded_snapshot_reader(const std::filesystem::path& snapshot_path) :
+threaded_snapshot_reader::threaded_snapshot_reader(const std::filesystem::path& snapshot_path, bool validate_hashes) :
   snapshot_file(snapshot_path, fc::random_access_file::read_only),
   mapped_snap(snapshot_file, boost::interprocess::read_only),
   mapped_snap_addr((char*)mapped_snap.get_address())
+{
+   if(validate_hashes)
+      validate();
+   else
+      load_index();
+}
+
+threaded_snapshot_reader::threaded_snapshot_reader(const std::filesystem::path& snapshot_path, section_gate gate) :
+  snapshot_file(snapshot_path, fc::random_access_file::read_only),
+  mapped_snap(snapshot_file, boost::interprocess::read_only),
+  mapped_snap_addr((char*)mapped_snap.get_address()),
+  gate_(std::move(gate))
 {
    validate();
 }
@@ -577,11 +595,14 @@ void threaded_snapshot_reader::validate() {
    load_index();
 
    try {
-      // Verify per-section hashes by re-hashing each section's data from mmap
-      for(const auto& entry : section_index_) {
-         auto computed = blake3_encoder::hash(mapped_snap_addr + entry.data_offset, entry.data_size);
-         SYS_ASSERT(computed == entry.hash, snapshot_exception,
-                    "Section '{}' hash mismatch. Snapshot file may be corrupted.", entry.name);
+      // Verify per-section hashes by re-hashing each section's data from mmap. With a gate the
+      // sections are still arriving; the gate verifies each one before it is read.
+      if(!gate_) {
+         for(const auto& entry : section_index_) {
+            auto computed = blake3_encoder::hash(mapped_snap_addr + entry.data_offset, entry.data_size);
+            SYS_ASSERT(computed == entry.hash, snapshot_exception,
+                       "Section '{}' hash mismatch. Snapshot file may be corrupted.", entry.name);
+         }
       }
 
       // Verify root hash = BLAKE3(section_hash_0 || section_hash_1 || ...)
@@ -621,6 +642,8 @@ void threaded_snapshot_reader::set_section(const string& section_name) {
          SYS_ASSERT(num_rows != 0 || entry.data_size == 0, snapshot_exception,
                     "Snapshot section '{}' has row_count 0 but {} bytes of data; file may be tampered",
                     section_name, entry.data_size);
+         if(gate_)
+            gate_(entry);
          ds = fc::datastream<const char*>(mapped_snap_addr + entry.data_offset, entry.data_size);
          return;
       }
@@ -0,0 +1,396 @@
+#include <sysio/chain/snapshot_diff.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <fc/io/random_access_file.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+
+namespace sysio { namespace chain {
+
+namespace {
+
+enum class diff_op : uint8_t {
+   copy    = 0,
+   literal = 1
+};
+
+// Gear table for the rolling hash: fixed pseudo-random values (splitmix64), identical on every node
+// and every run, so chunk boundaries are a pure function of the bytes.
+constexpr std::array<uint64_t, 256> make_gear_table() {
+   std::array<uint64_t, 256> table{};
+   uint64_t x = 0x9e3779b97f4a7c15ull;
+   for(auto& v : table) {
+      x += 0x9e3779b97f4a7c15ull;
+      uint64_t z = x;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      v = z ^ (z >> 31);
+   }
+   return table;
+}
+
+constexpr auto gear_table = make_gear_table();
+
+size_t chunk_fingerprint(const char* data, size_t size) {
+   return std::hash<std::string_view>{}(std::string_view(data, size));
+}
+
+template<typename T>
+void write_pod(std::ofstream& out, const T& v) {
+   out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template<typename T>
+T read_pod(fc::datastream<const char*>& ds) {
+   T v;
+   ds.read(reinterpret_cast<char*>(&v), sizeof(v));
+   return v;
+}
+
+} // namespace
+
+// ---- snapshot_chunker ----
+
+size_t detail::snapshot_chunker::cut(const char* data, size_t size) {
+   if(size <= min_chunk)
+      return size;
+   const size_t limit = std::min(size, max_chunk);
+   uint64_t h = 0;
+   for(size_t i = min_chunk; i < limit; ++i) {
+      h = (h << 1) + gear_table[static_cast<uint8_t>(data[i])];
+      if((h & cut_mask) == 0)
+         return i + 1;
+   }
+   return limit;
+}
+
+// ---- differential_snapshot_writer::row_streambuf ----
+
+differential_snapshot_writer::row_streambuf::int_type
+differential_snapshot_writer::row_streambuf::overflow(int_type ch) {
+   if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+      const char c = traits_type::to_char_type(ch);
+      writer_.append(&c, 1);
+   }
+   return ch;
+}
+
+std::streamsize differential_snapshot_writer::row_streambuf::xsputn(const char_type* s, std::streamsize count) {
+   writer_.append(s, static_cast<size_t>(count));
+   return count;
+}
+
+// ---- differential_snapshot_writer ----
+
+differential_snapshot_writer::differential_snapshot_writer(std::filesystem::path diff_path, std::shared_ptr<threaded_snapshot_reader> base)
+: diff_path_(std::move(diff_path))
+, base_(std::move(base))
+, out_(diff_path_, std::ios::binary)
+{
+   SYS_ASSERT(base_, snapshot_exception, "Differential snapshot requires a base snapshot");
+   SYS_ASSERT(out_.good(), snapshot_exception, "Failed to open differential snapshot output file: {}", diff_path_.string());
+
+   write_pod(out_, magic_number);
+   write_pod(out_, current_snapshot_diff_version);
+   const auto base_root = base_->get_root_hash();
+   out_.write(base_root.char_data(), base_root.data_size());
+}
+
+void differential_snapshot_writer::write_start_section(const std::string& section_name) {
+   current_ = section_entry{};
+   current_.name = section_name;
+   current_.data_offset = static_cast<uint64_t>(out_.tellp());
+   pending_.clear();
+   target_hasher_.reset();
+   pending_copy_.reset();
+   pending_literal_.clear();
+
+   // Index the same-named base section. Sections absent from the base are stored as literals.
+   base_data_ = {};
+   base_chunks_.clear();
+   for(const auto& entry : base_->sections()) {
+      if(entry.name == section_name) {
+         base_data_ = base_->section_data(entry);
+         break;
+      }
+   }
+   base_chunks_.reserve(base_data_.size() / (detail::snapshot_chunker::cut_mask + 1) + 1);
+   for(uint64_t off = 0; off < base_data_.size();) {
+      const size_t len = detail::snapshot_chunker::cut(base_data_.data() + off, base_data_.size() - off);
+      base_chunks_.emplace(chunk_fingerprint(base_data_.data() + off, len), base_chunk{off, len});
+      off += len;
+   }
+}
+
+void differential_snapshot_writer::write_row(const detail::abstract_snapshot_row_writer& row_writer) {
+   row_writer.write(wrapper_);
+   ++current_.row_count;
+}
+
+void differential_snapshot_writer::write_end_section() {
+   cut_chunks(true);
+   flush_copy();
+   flush_literal();
+
+   current_.data_size = static_cast<uint64_t>(out_.tellp()) - current_.data_offset;
+   current_.target_hash = target_hasher_.result();
+   sections_.push_back(std::move(current_));
+
+   base_chunks_.clear();
+   base_data_ = {};
+}
+
+void differential_snapshot_writer::write_raw_section(const std::string& section_name, uint64_t row_count, std::string_view data) {
+   write_start_section(section_name);
+   append(data.data(), data.size());
+   current_.row_count = row_count;
+   write_end_section();
+}
+
+void differential_snapshot_writer::append(const char* data, size_t size) {
+   target_hasher_.write(data, size);
+   current_.target_size += size;
+   pending_.insert(pending_.end(), data, data + size);
+   cut_chunks(false);
+}
+
+void differential_snapshot_writer::cut_chunks(bool end_of_section) {
+   // A cut only depends on the next max_chunk bytes, so mid-section cuts wait until that many are
+   // buffered; the base side, which sees the whole section at once, then cuts at the same places.
+   size_t start = 0;
+   while(pending_.size() - start > 0 &&
+         (end_of_section || pending_.size() - start >= detail::snapshot_chunker::max_chunk)) {
+      const size_t len = detail::snapshot_chunker::cut(pending_.data() + start, pending_.size() - start);
+      emit_chunk(pending_.data() + start, len);
+      start += len;
+   }
+   if(start)
+      pending_.erase(pending_.begin(), pending_.begin() + start);
+}
+
+void differential_snapshot_writer::emit_chunk(const char* data, size_t size) {
+   auto [it, end] = base_chunks_.equal_range(chunk_fingerprint(data, size));
+   for(; it != end; ++it) {
+      const auto& c = it->second;
+      if(c.size == size && std::memcmp(base_data_.data() + c.offset, data, size) == 0) {
+         copied_bytes_ += size;
+         if(pending_copy_ && pending_copy_->offset + pending_copy_->size == c.offset) {
+            pending_copy_->size += size;
+         } else {
+            flush_literal();
+            flush_copy();
+            pending_copy_ = c;
+         }
+         return;
+      }
+   }
+
+   literal_bytes_ += size;
+   flush_copy();
+   pending_literal_.insert(pending_literal_.end(), data, data + size);
+   if(pending_literal_.size() >= 16 * detail::snapshot_chunker::max_chunk)
+      flush_literal();
+}
+
+void differential_snapshot_writer::flush_copy() {
+   if(!pending_copy_)
+      return;
+   write_pod(out_, diff_op::copy);
+   write_pod(out_, pending_copy_->offset);
+   write_pod(out_, pending_copy_->size);
+   pending_copy_.reset();
+}
+
+void differential_snapshot_writer::flush_literal() {
+   if(pending_literal_.empty())
+      return;
+   write_pod(out_, diff_op::literal);
+   write_pod(out_, static_cast<uint64_t>(pending_literal_.size()));
+   out_.write(pending_literal_.data(), pending_literal_.size());
+   pending_literal_.clear();
+}
+
+void differential_snapshot_writer::finalize() {
+   out_.flush();
+   SYS_ASSERT(out_.good(), snapshot_exception,
+              "Failed to write differential snapshot section data: {}", diff_path_.string());
+
+   const uint64_t index_offset = static_cast<uint64_t>(out_.tellp());
+
+   std::sort(sections_.begin(), sections_.end(),
+             [](const section_entry& a, const section_entry& b) { return a.name < b.name; });
+
+   // same root hash as threaded_snapshot_writer would compute for the target
+   {
+      blake3_encoder root_hasher;
+      for(const auto& s : sections_) {
+         root_hasher.write(s.target_hash.char_data(), s.target_hash.data_size());
+      }
+      root_hash_ = root_hasher.result();
+   }
+
+   for(const auto& s : sections_) {
+      out_.write(s.name.data(), s.name.size());
+      out_.put(0);
+      write_pod(out_, s.data_offset);
+      write_pod(out_, s.data_size);
+      write_pod(out_, s.row_count);
+      write_pod(out_, s.target_size);
+      out_.write(s.target_hash.char_data(), s.target_hash.data_size());
+   }
+
+   write_pod(out_, static_cast<uint32_t>(sections_.size()));
+   out_.write(root_hash_.char_data(), root_hash_.data_size());
+   write_pod(out_, index_offset);
+
+   out_.flush();
+   SYS_ASSERT(out_.good(), snapshot_exception, "Failed to write differential snapshot file: {}", diff_path_.string());
+
+   ilog("Differential snapshot {}: {} bytes referenced from base, {} bytes stored",
+        diff_path_.string(), copied_bytes_, literal_bytes_);
+}
+
+// ---- apply ----
+
+fc::crypto::blake3 apply_snapshot_diff(const std::filesystem::path& base_path,
+                                       const std::filesystem::path& diff_path,
+                                       const std::filesystem::path& out_path) {
+   try {
+      threaded_snapshot_reader base(base_path);
+
+      fc::random_access_file diff_file(diff_path, fc::random_access_file::read_only);
+      const boost::interprocess::mapped_region mapped_diff(diff_file, boost::interprocess::read_only);
+      const char* const addr = static_cast<const char*>(mapped_diff.get_address());
+      const uint64_t file_size = mapped_diff.get_size();
+
+      constexpr uint64_t header_size = 2 * sizeof(uint32_t) + fc::crypto::blake3::byte_size;
+      constexpr uint64_t footer_size = sizeof(uint32_t) + fc::crypto::blake3::byte_size + sizeof(uint64_t);
+      SYS_ASSERT(file_size >= header_size + footer_size, snapshot_exception, "Differential snapshot file too small");
+
+      fc::datastream<const char*> hds(addr, header_size);
+      SYS_ASSERT(read_pod<uint32_t>(hds) == differential_snapshot_writer::magic_number, snapshot_exception,
+                 "Differential snapshot has unexpected magic number!");
+      const auto version = read_pod<uint32_t>(hds);
+      SYS_ASSERT(version == current_snapshot_diff_version, snapshot_exception,
+                 "Differential snapshot is an unsupported version. Expected: {}, Got: {}",
+                 current_snapshot_diff_version, version);
+      fc::crypto::blake3 base_root;
+      hds.read(base_root.char_data(), base_root.data_size());
+      SYS_ASSERT(base_root == base.get_root_hash(), snapshot_exception,
+                 "Differential snapshot {} was made against base {}, not {} ({})",
+                 diff_path.string(), base_root.str(), base_path.string(), base.get_root_hash().str());
+
+      fc::datastream<const char*> fds(addr + file_size - footer_size, footer_size);
+      const auto num_sections = read_pod<uint32_t>(fds);
+      fc::crypto::blake3 root_hash;
+      fds.read(root_hash.char_data(), root_hash.data_size());
+      const auto index_offset = read_pod<uint64_t>(fds);
+      SYS_ASSERT(index_offset >= header_size && index_offset <= file_size - footer_size, snapshot_exception,
+                 "Differential snapshot section index offset beyond file bounds");
+      static constexpr uint32_t max_num_sections = 256;
+      SYS_ASSERT(num_sections <= max_num_sections, snapshot_exception,
+                 "Differential snapshot claims {} sections, maximum is {}", num_sections, max_num_sections);
+
+      threaded_snapshot_writer out(out_path);
+      fc::datastream<const char*> ids(addr + index_offset, file_size - footer_size - index_offset);
+      for(uint32_t i = 0; i < num_sections; ++i) {
+         const char* name_start = ids.pos();
+         const char* name_end = std::find(name_start, name_start + ids.remaining(), '\0');
+         SYS_ASSERT(name_end != name_start + ids.remaining(), snapshot_exception, "Section name not null-terminated");
+         const std::string name(name_start, name_end);
+         ids.skip(name.size() + 1);
+         const auto data_offset = read_pod<uint64_t>(ids);
+         const auto data_size   = read_pod<uint64_t>(ids);
+         const auto row_count   = read_pod<uint64_t>(ids);
+         const auto target_size = read_pod<uint64_t>(ids);
+         fc::crypto::blake3 target_hash;
+         ids.read(target_hash.char_data(), target_hash.data_size());
+         SYS_ASSERT(data_offset >= header_size && data_size <= index_offset - header_size &&
+                    data_offset <= index_offset - data_size, snapshot_exception,
+                    "Differential snapshot section '{}' data extends beyond section index", name);
+
+         std::string_view base_data;
+         for(const auto& entry : base.sections()) {
+            if(entry.name == name) {
+               base_data = base.section_data(entry);
+               break;
+            }
+         }
+
+         out.begin_raw_section(name);
+         uint64_t written = 0;
+         fc::datastream<const char*> ops(addr + data_offset, data_size);
+         while(ops.remaining()) {
+            const auto op = read_pod<diff_op>(ops);
+            if(op == diff_op::copy) {
+               const auto off  = read_pod<uint64_t>(ops);
+               const auto size = read_pod<uint64_t>(ops);
+               SYS_ASSERT(size <= base_data.size() && off <= base_data.size() - size, snapshot_exception,
+                          "Differential snapshot section '{}' copies beyond the base section", name);
+               out.write_raw(base_data.data() + off, size);
+               written += size;
+            } else {
+               SYS_ASSERT(op == diff_op::literal, snapshot_exception,
+                          "Differential snapshot section '{}' has unknown op {}", name, static_cast<uint32_t>(op));
+               const auto size = read_pod<uint64_t>(ops);
+               SYS_ASSERT(size <= ops.remaining(), snapshot_exception,
+                          "Differential snapshot section '{}' literal extends beyond section data", name);
+               out.write_raw(ops.pos(), size);
+               ops.skip(size);
+               written += size;
+            }
+         }
+         const auto hash = out.end_raw_section(row_count);
+         SYS_ASSERT(written == target_size && hash == target_hash, snapshot_exception,
+                    "Section '{}' reconstructed from differential snapshot does not match; "
+                    "diff or base may be corrupted", name);
+      }
+      out.finalize();
+      SYS_ASSERT(out.get_root_hash() == root_hash, snapshot_exception,
+                 "Snapshot reconstructed from differential snapshot has root hash {}, expected {}",
+                 out.get_root_hash().str(), root_hash.str());
+      return root_hash;
+   } FC_LOG_AND_RETHROW()
+}
+
+fc::crypto::blake3 apply_snapshot_diffs(const std::filesystem::path& base_path,
+                                        const std::vector<std::filesystem::path>& diff_paths,
+                                        const std::filesystem::path& out_path) {
+   SYS_ASSERT(!diff_paths.empty(), snapshot_exception, "No differential snapshots to apply");
+
+   fc::crypto::blake3 root_hash;
+   std::filesystem::path base = base_path;
+   std::optional<std::filesystem::path> intermediate;
+   for(size_t i = 0; i < diff_paths.size(); ++i) {
+      const bool last = i + 1 == diff_paths.size();
+      const auto target = last ? out_path : std::filesystem::path(out_path.string() + ".partial-" + std::to_string(i));
+      root_hash = apply_snapshot_diff(base, diff_paths[i], target);
+      if(intermediate)
+         std::filesystem::remove(*intermediate);
+      intermediate = last ? std::nullopt : std::optional(target);
+      base = target;
+   }
+   return root_hash;
+}
+
+fc::crypto::blake3 create_snapshot_diff(const std::filesystem::path& base_path,
+                                        const std::filesystem::path& target_path,
+                                        const std::filesystem::path& diff_path) {
+   auto base = std::make_shared<threaded_snapshot_reader>(base_path);
+   threaded_snapshot_reader target(target_path);
+
+   differential_snapshot_writer writer(diff_path, base);
+   for(const auto& entry : target.sections())
+      writer.write_raw_section(entry.name, entry.row_count, target.section_data(entry));
+   writer.finalize();
+
+   SYS_ASSERT(writer.get_root_hash() == target.get_root_hash(), snapshot_exception,
+              "Differential snapshot root hash {} does not match target snapshot {}",
+              writer.get_root_hash().str(), target.get_root_hash().str());
+   return writer.get_root_hash();
+}
+
+}}
@@ -2,6 +2,7 @@
 #include <sysio/chain/exceptions.hpp>
 #include <sysio/chain/pending_snapshot.hpp>
 #include <sysio/chain/snapshot.hpp>
+#include <sysio/chain/snapshot_diff.hpp>
 #include <sysio/chain/snapshot_scheduler.hpp>
 
 namespace sysio::chain {
@@ -12,9 +13,10 @@ void snapshot_scheduler::on_start_block(uint32_t height, chain::controller& chai
    // iterating. In irreversible read mode execute_snapshot() creates the snapshot synchronously and
    // runs the height-based request cleanup, erasing expired requests from _snapshot_requests; doing
    // that while the range-for below iterates the same container would invalidate the loop iterator.
-   bool             found = false;
-   uint32_t         srid  = 0;
-   request_callback caller;
+   bool                         found = false;
+   uint32_t                     srid  = 0;
+   request_callback             caller;
+   std::optional<block_id_type> diff_base;
 
    for(const auto& req: _snapshot_requests.get<0>()) {
       // -1 since its called from start block
@@ -27,6 +29,22 @@ void snapshot_scheduler::on_start_block(uint32_t height, chain::controller& chai
          srid   = req.snapshot_request_id;
          caller = req.caller;
          found  = true;
+
+         // Recurring requests with a full_snapshot_spacing write a full snapshot on every multiple of
+         // it and a diff against the latest full one in between. The base is not persisted, so after
+         // a restart the first snapshot of the request is always a full one; a base that was forked
+         // out or removed is replaced the same way, by a full snapshot the following diffs build on.
+         if(recurring_snapshot && req.full_snapshot_spacing) {
+            const bool full = !req.last_full_snapshot || !((height - req.start_block_num - 1) % req.full_snapshot_spacing) ||
+                              find_snapshot_file(*req.last_full_snapshot).empty();
+            if(full) {
+               const auto head_id = chain.head().id();
+               auto& snapshot_by_id = _snapshot_requests.get<by_snapshot_id>();
+               snapshot_by_id.modify(snapshot_by_id.find(srid), [&](auto& p) { p.last_full_snapshot = head_id; });
+            } else {
+               diff_base = req.last_full_snapshot;
+            }
+         }
          break;
       }
    }
@@ -37,7 +55,7 @@ void snapshot_scheduler::on_start_block(uint32_t height, chain::controller& chai
    // runs again when the adopted branch reapplies this height, and whichever attempt reaches the
    // caller first is the one that empties the slot.
    if(found)
-      execute_snapshot(srid, chain, caller);
+      execute_snapshot(srid, chain, caller, diff_base);
 }
 
 void snapshot_scheduler::on_irreversible_block(const signed_block_ptr& lib, const block_id_type& block_id, const chain::controller& chain) {
@@ -109,6 +127,8 @@ snapshot_scheduler::snapshot_schedule_result snapshot_scheduler::schedule_snapsh
    SYS_ASSERT(!find_snapshot_request(sri.block_spacing, sri.start_block_num, sri.end_block_num), chain::duplicate_snapshot_request, "Duplicate snapshot request");
    SYS_ASSERT(sri.start_block_num <= sri.end_block_num, chain::invalid_snapshot_request, "End block number should be greater or equal to start block number");
    SYS_ASSERT(sri.start_block_num + sri.block_spacing <= sri.end_block_num, chain::invalid_snapshot_request, "Block spacing exceeds defined by start and end range");
+   SYS_ASSERT(!sri.full_snapshot_spacing || (sri.block_spacing && sri.full_snapshot_spacing % sri.block_spacing == 0),
+              chain::invalid_snapshot_request, "Full snapshot spacing must be a multiple of block spacing");
 
    // a request with no caller to answer gets no slot at all, so a null slot and an emptied one are
    // never confused with each other
@@ -116,11 +136,11 @@ snapshot_scheduler::snapshot_schedule_result snapshot_scheduler::schedule_snapsh
    if(next)
       caller = std::make_shared<next_function<snapshot_information>>(std::move(next));
 
-   _snapshot_requests.emplace(snapshot_schedule_information{{_snapshot_id++}, {sri.block_spacing, sri.start_block_num, sri.end_block_num, sri.snapshot_description}, {}, std::move(caller)});
+   _snapshot_requests.emplace(snapshot_schedule_information{{_snapshot_id++}, {sri.block_spacing, sri.start_block_num, sri.end_block_num, sri.snapshot_description, sri.full_snapshot_spacing}, {}, std::move(caller)});
    x_serialize();
 
    // returning snapshot_schedule_result
-   return snapshot_schedule_result{{_snapshot_id - 1}, {sri.block_spacing, sri.start_block_num, sri.end_block_num, sri.snapshot_description}};
+   return snapshot_schedule_result{{_snapshot_id - 1}, {sri.block_spacing, sri.start_block_num, sri.end_block_num, sri.snapshot_description, sri.full_snapshot_spacing}};
 }
 
 snapshot_scheduler::snapshot_schedule_result snapshot_scheduler::remove_request(uint32_t sri, fc::log_message undelivered_reason) {
@@ -128,7 +148,7 @@ snapshot_scheduler::snapshot_schedule_result snapshot_scheduler::remove_request(
    auto existing = snapshot_by_id.find(sri);
    SYS_ASSERT(existing != snapshot_by_id.end(), chain::snapshot_request_not_found, "Snapshot request not found");
 
-   snapshot_schedule_result result{{existing->snapshot_request_id}, {existing->block_spacing, existing->start_block_num, existing->end_block_num, existing->snapshot_description}};
+   snapshot_schedule_result result{{existing->snapshot_request_id}, {existing->block_spacing, existing->start_block_num, existing->end_block_num, existing->snapshot_description, existing->full_snapshot_spacing}};
 
    // Take the callback out of the request's slot before erasing. A caller still waiting there has
    // had no result: the request never ran, or it ran and its snapshot was forked out or deduplicated
@@ -209,7 +229,8 @@ next_function<snapshot_scheduler::snapshot_information> snapshot_scheduler::take
    return std::move(*caller);
 }
 
-void snapshot_scheduler::execute_snapshot(uint32_t srid, chain::controller& chain, request_callback caller) {
+void snapshot_scheduler::execute_snapshot(uint32_t srid, chain::controller& chain, request_callback caller,
+                                          std::optional<block_id_type> diff_base) {
    _inflight_sid = srid;
    // The handler below outlives a single call -- it is stored on the pending snapshot, and
    // create_snapshot() hands it to CATCH_AND_CALL(), which re-invokes it with the exception if
@@ -258,15 +279,26 @@ void snapshot_scheduler::execute_snapshot(uint32_t srid, chain::controller& chai
          } FC_LOG_AND_DROP();
       }
    };
-   create_snapshot(next, chain);
+   create_snapshot(next, chain, std::move(diff_base));
 }
 
-void snapshot_scheduler::create_snapshot(next_function<snapshot_information> next, chain::controller& chain) {
+void snapshot_scheduler::create_snapshot(next_function<snapshot_information> next, chain::controller& chain,
+                                         std::optional<block_id_type> diff_base) {
    auto head_id = chain.head().id();
    const auto head_block_num = chain.head().block_num();
    const auto head_block_time = chain.head().block_time();
-   const auto& snapshot_path = pending_snapshot<snapshot_information>::get_final_path(head_id, _snapshots_dir);
-   const auto& temp_path = pending_snapshot<snapshot_information>::get_temp_path(head_id, _snapshots_dir);
+
+   // A differential snapshot needs its base on disk; if the base is gone by now, fall back to a full
+   // snapshot rather than skipping this one.
+   fs::path base_path;
+   if(diff_base) {
+      base_path = find_snapshot_file(*diff_base);
+      if(base_path.empty())
+         wlog("Base snapshot for block {} not found; writing a full snapshot at block {} instead", *diff_base, head_block_num);
+   }
+   const std::string extension = base_path.empty() ? "bin" : "diff";
+   const auto& snapshot_path = pending_snapshot<snapshot_information>::get_final_path(head_id, _snapshots_dir, extension);
+   const auto& temp_path = pending_snapshot<snapshot_information>::get_temp_path(head_id, _snapshots_dir, extension);
 
    // maintain legacy exception if the snapshot exists
    if(fs::is_regular_file(snapshot_path)) {
@@ -278,6 +310,13 @@ void snapshot_scheduler::create_snapshot(next_function<snapshot_information> nex
    fc::crypto::blake3 captured_root_hash;
    auto write_snapshot = [&](const fs::path& p) -> void {
       fs::create_directory(p.parent_path());
+      if(!base_path.empty()) {
+         auto writer = std::make_shared<differential_snapshot_writer>(p, std::make_shared<threaded_snapshot_reader>(base_path, false));
+         chain.write_snapshot(writer);
+         writer->finalize();
+         captured_root_hash = writer->get_root_hash();
+         return;
+      }
       auto writer = std::make_shared<threaded_snapshot_writer>(p);
       chain.write_snapshot(writer);
       writer->finalize();
@@ -316,7 +355,7 @@ void snapshot_scheduler::create_snapshot(next_function<snapshot_information> nex
    auto& pending_by_id = _pending_snapshot_index.get<by_id>();
    auto existing = pending_by_id.find(head_id);
    if(existing == pending_by_id.end()) { // if a snapshot at this block is already pending, ignore
-      const auto& pending_path = pending_snapshot<snapshot_information>::get_pending_path(head_id, _snapshots_dir);
+      const auto& pending_path = pending_snapshot<snapshot_information>::get_pending_path(head_id, _snapshots_dir, extension);
 
       try {
          ilog("Starting snapshot creation at block {}", head_block_num);
@@ -336,6 +375,16 @@ void snapshot_scheduler::create_snapshot(next_function<snapshot_information> nex
    }
 }
 
+fs::path snapshot_scheduler::find_snapshot_file(const block_id_type& block_id) const {
+   auto path = pending_snapshot<snapshot_information>::get_final_path(block_id, _snapshots_dir);
+   if(fs::is_regular_file(path))
+      return path;
+   path = pending_snapshot<snapshot_information>::get_pending_path(block_id, _snapshots_dir);
+   if(fs::is_regular_file(path))
+      return path;
+   return {};
+}
+
 void snapshot_scheduler::notify_snapshot_finalized(const snapshot_information& si) {
    for(const auto& cb: _snapshot_finalized_cbs) {
       try {
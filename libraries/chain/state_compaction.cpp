@@ -0,0 +1,104 @@
+#include <sysio/chain/state_compaction.hpp>
+#include <sysio/chain/config.hpp>
+#include <sysio/chain/exceptions.hpp>
+#include <sysio/chain/protocol_feature_manager.hpp>
+#include <sysio/chain/snapshot.hpp>
+
+#include <fc/log/logger.hpp>
+#include <fc/scoped_exit.hpp>
+
+namespace sysio { namespace chain {
+
+namespace fs = std::filesystem;
+
+chain_state_stats chain_state_stats::from_db( const chainbase::database& db ) {
+   chain_state_stats ret;
+   ret.size              = db.get_segment_manager()->get_size();
+   ret.free_bytes        = db.get_segment_manager()->get_free_memory();
+   ret.used_bytes        = ret.size - ret.free_bytes;
+   ret.reclaimable_bytes = db.get_reclaimable_memory();
+   for( const auto& [rows, name] : db.row_count_per_index() )
+      ret.row_count += rows;
+   return ret;
+}
+
+namespace {
+   /// Move every entry of from into to, which must not contain entries of the same names. The
+   /// directories themselves stay in place, so a state directory that is a mount point survives.
+   void move_directory_contents( const fs::path& from, const fs::path& to ) {
+      fs::create_directories( to );
+      for( const auto& entry : fs::directory_iterator( from ) )
+         fs::rename( entry.path(), to / entry.path().filename() );
+   }
+}
+
+state_compaction_result compact_chain_state( const controller::config& cfg,
+                                             const fs::path& protocol_features_dir,
+                                             const chain_id_type& chain_id ) {
+   SYS_ASSERT( fs::is_regular_file( cfg.state_dir / "shared_memory.bin" ), database_exception,
+               "No chain state to compact in {}", cfg.state_dir.generic_string() );
+
+   const fs::path work_dir      = cfg.state_dir.parent_path() / (cfg.state_dir.filename().string() + ".compact");
+   const fs::path snapshot_path = work_dir / "state.bin";
+   const fs::path new_state_dir = work_dir / config::default_state_dir_name;
+   const fs::path old_state_dir = work_dir / "old-state";
+   fs::remove_all( work_dir );
+   fs::create_directories( work_dir );
+   auto cleanup = fc::make_scoped_exit( [&]() {
+      std::error_code ec;
+      fs::remove_all( work_dir, ec );
+   } );
+
+   auto shutdown       = []() { SYS_THROW( database_exception, "controller shutdown requested during state compaction" ); };
+   auto check_shutdown = []() { return false; };
+
+   controller::config c = cfg;
+   c.finalizers_dir = work_dir / "finalizers"; // no votes are cast; leave the node's safety file alone
+   c.sysvmoc_tierup = wasm_interface::vm_oc_enable::oc_none;
+   c.integrity_hash_on_start = false;
+   c.integrity_hash_on_stop  = false;
+
+   state_compaction_result result;
+   {
+      controller control( c, initialize_protocol_features( protocol_features_dir, false ), chain_id );
+      control.add_indices();
+      control.startup( shutdown, check_shutdown );
+
+      // a snapshot is only loadable at a block the block log holds
+      control.pop_to_fork_db_root();
+      result.head_block_num = control.head().block_num();
+      // measured at the root, so before and after describe the same rows
+      result.before = chain_state_stats::from_db( control.db() );
+      ilog( "Writing chain state at block {} to {}", result.head_block_num, snapshot_path.generic_string() );
+      auto writer = std::make_shared<threaded_snapshot_writer>( snapshot_path );
+      control.write_snapshot( writer );
+      writer->finalize();
+   }
+
+   {
+      c.state_dir = new_state_dir;
+      controller control( c, initialize_protocol_features( protocol_features_dir, false ), chain_id );
+      control.add_indices();
+      ilog( "Loading chain state into {}", new_state_dir.generic_string() );
+      control.startup( shutdown, check_shutdown, std::make_shared<threaded_snapshot_reader>( snapshot_path ) );
+      result.after = chain_state_stats::from_db( control.db() );
+   }
+
+   // from here on the work directory may hold the only complete copy of the state
+   cleanup.cancel();
+   try {
+      move_directory_contents( cfg.state_dir, old_state_dir );
+      move_directory_contents( new_state_dir, cfg.state_dir );
+   } catch( const fs::filesystem_error& e ) {
+      SYS_THROW( database_exception, "Unable to swap compacted state into {}: {}. Original state is in {}, compacted state in {}",
+                 cfg.state_dir.generic_string(), e.what(), old_state_dir.generic_string(), new_state_dir.generic_string() );
+   }
+   fs::remove_all( work_dir );
+
+   ilog( "Compacted chain state at block {}: used {} -> {} bytes, reclaimable {} -> {} bytes",
+         result.head_block_num, result.before.used_bytes, result.after.used_bytes,
+         result.before.reclaimable_bytes, result.after.reclaimable_bytes );
+   return result;
+}
+
+}}
@@ -0,0 +1,229 @@
+#include <sysio/chain/streaming_snapshot.hpp>
+#include <sysio/chain/blake3_encoder.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <fc/log/logger_config.hpp>
+#include <fc/scoped_exit.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace sysio { namespace chain {
+
+namespace {
+   // v1 layout, see snapshot.hpp
+   constexpr uint64_t header_size = sizeof(uint32_t) + sizeof(uint32_t);
+   constexpr uint64_t footer_size = sizeof(uint32_t) + fc::crypto::blake3::byte_size + sizeof(uint64_t);
+}
+
+// ---- file_snapshot_range_source ----
+
+file_snapshot_range_source::file_snapshot_range_source(const std::filesystem::path& path)
+   : file_(path, fc::random_access_file::read_only)
+   , size_(file_.size())
+{}
+
+void file_snapshot_range_source::read(uint64_t offset, uint64_t size, char* out) {
+   SYS_ASSERT(size <= size_ && offset <= size_ - size, snapshot_exception,
+              "Snapshot range {}+{} beyond file size {}", offset, size, size_);
+   auto ds = file_.read_ds(offset);
+   ds.read(out, size);
+}
+
+// ---- streaming_snapshot_fetcher ----
+
+streaming_snapshot_fetcher::streaming_snapshot_fetcher(std::shared_ptr<snapshot_range_source> source, std::filesystem::path dest,
+                                                       fc::crypto::blake3 expected_root_hash, uint32_t threads,
+                                                       uint64_t chunk_size)
+   : source_(std::move(source))
+   , dest_(std::move(dest))
+   , expected_root_hash_(std::move(expected_root_hash))
+   , num_threads_(std::max<uint32_t>(threads, 1))
+   , chunk_size_(std::max<uint64_t>(chunk_size, 1))
+{
+   SYS_ASSERT(source_, snapshot_exception, "Streaming snapshot requires a range source");
+}
+
+streaming_snapshot_fetcher::~streaming_snapshot_fetcher() {
+   stop();
+   bool complete = false;
+   {
+      std::lock_guard g(mtx_);
+      complete = started_ && !failure_ && sections_left_ == 0;
+   }
+   if(!complete)
+      discard();
+}
+
+void streaming_snapshot_fetcher::discard() {
+   stop();
+   reader_.reset();
+   file_.reset();
+   std::error_code ec;
+   std::filesystem::remove(dest_, ec);
+}
+
+void streaming_snapshot_fetcher::fetch_range(uint64_t offset, uint64_t size) {
+   std::vector<char> buf(size);
+   source_->read(offset, size, buf.data());
+   auto ds = file_->write_ds(offset);
+   ds.write(buf.data(), size);
+   ds.flush();
+   fetched_bytes_ += size;
+}
+
+void streaming_snapshot_fetcher::start() {
+   SYS_ASSERT(!file_, snapshot_exception, "Streaming snapshot fetch already started");
+   // a fetch that fails to start leaves neither a reader nor a partial file behind
+   auto discard_on_error = fc::make_scoped_exit([this]() { discard(); });
+   try {
+      const uint64_t size = source_->size();
+      SYS_ASSERT(size >= header_size + footer_size, snapshot_exception, "Snapshot file too small");
+
+      // Preallocate (sparsely) so every section can be written in place and the reader can map the
+      // final file before its sections exist.
+      file_.emplace(dest_, fc::random_access_file::read_write);
+      file_->resize(0);
+      file_->resize(size);
+
+      fetch_range(0, header_size);
+      fetch_range(size - footer_size, footer_size);
+      const auto index_offset = file_->unpack_from<uint64_t>(size - sizeof(uint64_t));
+      SYS_ASSERT(index_offset >= header_size && index_offset < size - footer_size, snapshot_exception,
+                 "Section index offset beyond file bounds");
+      fetch_range(index_offset, size - footer_size - index_offset);
+
+      // Parses header, footer and index and checks the root hash over the section hashes.
+      reader_ = std::make_shared<threaded_snapshot_reader>(dest_, [this](const snapshot_section_entry& e) { wait_for(e); });
+      SYS_ASSERT(reader_->get_root_hash() == expected_root_hash_, snapshot_exception,
+                 "Snapshot root hash mismatch! Expected: {}, file contains: {}",
+                 expected_root_hash_.str(), reader_->get_root_hash().str());
+
+      const auto& entries = reader_->sections();
+      std::vector<size_t> order(entries.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return entries[a].data_offset < entries[b].data_offset; });
+
+      std::lock_guard g(mtx_);
+      sections_.resize(entries.size());
+      for(size_t i : order) {
+         const auto& e = entries[i];
+         if(e.data_size == 0) {
+            SYS_ASSERT(blake3_encoder::hash(nullptr, 0) == e.hash, snapshot_exception,
+                       "Section '{}' hash mismatch. Snapshot file may be corrupted.", e.name);
+            sections_[i].verified = true;
+            continue;
+         }
+         for(uint64_t off = 0; off < e.data_size; off += chunk_size_)
+            queue_.push_back(chunk{i, e.data_offset + off, std::min(chunk_size_, e.data_size - off)});
+         sections_[i].remaining_chunks = (e.data_size + chunk_size_ - 1) / chunk_size_;
+         ++sections_left_;
+      }
+      started_ = true;
+
+      const size_t n = std::min<size_t>(num_threads_, std::max<size_t>(queue_.size(), 1));
+      for(size_t t = 0; t < n; ++t)
+         threads_.emplace_back([this, t]() {
+            fc::set_thread_name("snap-fetch-" + std::to_string(t));
+            run_worker();
+         });
+   } FC_LOG_AND_RETHROW()
+   discard_on_error.cancel();
+}
+
+void streaming_snapshot_fetcher::run_worker() {
+   std::vector<char> buf;
+   while(true) {
+      chunk c;
+      {
+         std::lock_guard g(mtx_);
+         if(stopping_ || failure_ || queue_.empty())
+            return;
+         c = queue_.front();
+         queue_.pop_front();
+      }
+
+      try {
+         buf.resize(c.size);
+         source_->read(c.offset, c.size, buf.data());
+         {
+            auto ds = file_->write_ds(c.offset);
+            ds.write(buf.data(), c.size);
+            ds.flush();
+         }
+         fetched_bytes_ += c.size;
+
+         bool complete = false;
+         {
+            std::lock_guard g(mtx_);
+            complete = --sections_[c.section].remaining_chunks == 0;
+         }
+         if(!complete)
+            continue;
+
+         // the last chunk of a section is in place: verify it from the reader's own mapping
+         const auto& e = reader_->sections()[c.section];
+         const auto data = reader_->section_data(e);
+         SYS_ASSERT(blake3_encoder::hash(data.data(), data.size()) == e.hash, snapshot_exception,
+                    "Section '{}' hash mismatch. Downloaded snapshot may be corrupted.", e.name);
+
+         std::lock_guard g(mtx_);
+         sections_[c.section].verified = true;
+         --sections_left_;
+         cv_.notify_all();
+      } catch(...) {
+         std::lock_guard g(mtx_);
+         if(!failure_)
+            failure_ = std::current_exception();
+         cv_.notify_all();
+         return;
+      }
+   }
+}
+
+void streaming_snapshot_fetcher::wait_for(const snapshot_section_entry& entry) {
+   const auto& entries = reader_->sections();
+   auto it = std::find_if(entries.begin(), entries.end(), [&](const auto& e) { return e.name == entry.name; });
+   SYS_ASSERT(it != entries.end(), snapshot_exception, "Binary snapshot has no section named {}", entry.name);
+   const size_t i = static_cast<size_t>(it - entries.begin());
+
+   std::unique_lock g(mtx_);
+   if(!sections_[i].verified) {
+      // the loader needs this section now; fetch what is left of it before anything else
+      std::stable_partition(queue_.begin(), queue_.end(), [i](const chunk& c) { return c.section == i; });
+      cv_.wait(g, [&]() { return sections_[i].verified || failure_ || stopping_; });
+   }
+   rethrow_if_failed();
+   SYS_ASSERT(sections_[i].verified, snapshot_exception,
+              "Snapshot download stopped before section '{}' arrived", entry.name);
+}
+
+void streaming_snapshot_fetcher::wait_all() {
+   {
+      std::unique_lock g(mtx_);
+      cv_.wait(g, [&]() { return sections_left_ == 0 || failure_ || stopping_; });
+      rethrow_if_failed();
+      SYS_ASSERT(sections_left_ == 0, snapshot_exception, "Snapshot download stopped before completion");
+   }
+   for(auto& t : threads_)
+      t.join();
+   threads_.clear();
+}
+
+void streaming_snapshot_fetcher::stop() {
+   {
+      std::lock_guard g(mtx_);
+      stopping_ = true;
+      cv_.notify_all();
+   }
+   for(auto& t : threads_)
+      t.join();
+   threads_.clear();
+}
+
+void streaming_snapshot_fetcher::rethrow_if_failed() const {
+   if(failure_)
+      std::rethrow_exception(failure_);
+}
+
+}}
@@ -389,6 +389,9 @@ void apply_sysio_linkauth(apply_context& context) {
       auto link_key = boost::make_tuple(requirement.account, requirement.code, requirement.type);
       auto link = db.find<permission_link_object, by_action_name>(link_key);
 
+      // the minimum permission of this action changes below; cached relevance checks may no longer hold
+      context.control.get_mutable_authorization_manager().invalidate_check_cache();
+
       if( link ) {
          SYS_ASSERT(link->required_permission != requirement.requirement, action_validate_exception,
                     "Attempting to update required authority, but new requirement is same as old");
@@ -440,6 +443,7 @@ void apply_sysio_unlinkauth(apply_context& context) {
    );
 
    db.remove(*link);
+   context.control.get_mutable_authorization_manager().invalidate_check_cache();
 }
 
 } // namespace sysio::chain
@@ -484,6 +484,7 @@ namespace sysio::chain {
    void transaction_context::undo() {
       if (undo_session)
          undo_session->undo();
+      kv_row_cache.clear();
       transaction_timer.stop();
    }
 
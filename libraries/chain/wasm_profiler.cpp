@@ -0,0 +1,426 @@
+#include <sysio/chain/wasm_profiler.hpp>
+#include <sysio/chain/code_object.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <fc/log/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+
+#if defined(__linux__)
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace sysio { namespace chain {
+
+namespace {
+
+   // ---- WASM binary parsing -------------------------------------------------------------------
+
+   struct wasm_reader {
+      std::span<const char> bytes;
+      size_t                pos = 0;
+
+      bool at_end() const { return pos >= bytes.size(); }
+
+      std::optional<uint8_t> byte() {
+         if (pos >= bytes.size())
+            return {};
+         return static_cast<uint8_t>(bytes[pos++]);
+      }
+
+      std::optional<uint32_t> varuint32() {
+         uint32_t result = 0;
+         for (uint32_t shift = 0; shift < 35; shift += 7) {
+            auto b = byte();
+            if (!b)
+               return {};
+            result |= uint32_t(*b & 0x7f) << shift;
+            if (!(*b & 0x80))
+               return result;
+         }
+         return {};
+      }
+
+      std::optional<std::string_view> name() {
+         auto len = varuint32();
+         if (!len || *len > bytes.size() - pos)
+            return {};
+         std::string_view ret(bytes.data() + pos, *len);
+         pos += *len;
+         return ret;
+      }
+
+      bool skip(size_t n) {
+         if (n > bytes.size() - pos)
+            return false;
+         pos += n;
+         return true;
+      }
+
+      bool skip_limits() {
+         auto flags = byte();
+         if (!flags || !varuint32())
+            return false;
+         return !(*flags & 1) || varuint32().has_value();
+      }
+   };
+
+   constexpr uint8_t custom_section_id = 0;
+   constexpr uint8_t import_section_id = 2;
+   constexpr uint8_t code_section_id   = 10;
+   constexpr uint8_t function_names_subsection_id = 1;
+
+   bool parse_imports(wasm_reader r, wasm_profiler::function_table& table) {
+      auto count = r.varuint32();
+      if (!count)
+         return false;
+      for (uint32_t i = 0; i < *count; ++i) {
+         if (!r.name() || !r.name())
+            return false;
+         auto kind = r.byte();
+         if (!kind)
+            return false;
+         switch (*kind) {
+            case 0: // function
+               if (!r.varuint32())
+                  return false;
+               ++table.imported_functions;
+               break;
+            case 1: // table
+               if (!r.byte() || !r.skip_limits())
+                  return false;
+               break;
+            case 2: // memory
+               if (!r.skip_limits())
+                  return false;
+               break;
+            case 3: // global
+               if (!r.skip(2))
+                  return false;
+               break;
+            default:
+               return false;
+         }
+      }
+      return true;
+   }
+
+   // r.bytes is the whole module so that body offsets are offsets into the module binary
+   bool parse_code(wasm_reader r, size_t end, wasm_profiler::function_table& table) {
+      auto count = r.varuint32();
+      if (!count)
+         return false;
+      table.bodies.reserve(*count);
+      for (uint32_t i = 0; i < *count; ++i) {
+         auto size = r.varuint32();
+         if (!size || *size > end - r.pos)
+            return false;
+         table.bodies.emplace_back(r.pos, r.pos + *size);
+         r.pos += *size;
+      }
+      return true;
+   }
+
+   bool parse_names(wasm_reader r, wasm_profiler::function_table& table) {
+      while (!r.at_end()) {
+         auto id   = r.byte();
+         auto size = r.varuint32();
+         if (!id || !size || *size > r.bytes.size() - r.pos)
+            return false;
+         wasm_reader sub{r.bytes.subspan(r.pos, *size)};
+         r.pos += *size;
+         if (*id != function_names_subsection_id)
+            continue;
+         auto count = sub.varuint32();
+         if (!count)
+            return false;
+         for (uint32_t i = 0; i < *count; ++i) {
+            auto index = sub.varuint32();
+            auto name  = sub.name();
+            if (!index || !name)
+               return false;
+            table.names.emplace(*index, std::string(*name));
+         }
+      }
+      return true;
+   }
+
+   std::span<const char> find_code(const chainbase::database& db, const digest_type& code_hash) {
+      const auto& idx = db.get_index<code_index, by_code_hash>();
+      auto it = idx.lower_bound(boost::make_tuple(code_hash));
+      if (it == idx.end() || it->code_hash != code_hash)
+         return {};
+      return {it->code.data(), it->code.size()};
+   }
+
+   // ---- sampling ------------------------------------------------------------------------------
+
+   constexpr size_t max_samples_per_action = 1024;
+
+   // Written by the signal handler only while active is set; read by the owning thread after clearing
+   // it. Trivially constructible and destructible, so the signal handler never triggers TLS setup.
+   struct thread_samples {
+      volatile sig_atomic_t active = 0;
+      size_t                count  = 0;
+      uintptr_t             pcs[max_samples_per_action];
+   };
+   thread_local thread_samples samples_tls;
+
+#if defined(__linux__)
+   const int sample_signal = SIGRTMIN + 1; // SIGRTMIN is taken by platform_timer
+
+   uintptr_t interrupted_pc(void* uctx) {
+      [[maybe_unused]] const auto* uc = static_cast<const ucontext_t*>(uctx);
+#if defined(__x86_64__)
+      return static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+      return static_cast<uintptr_t>(uc->uc_mcontext.pc);
+#else
+      return 0;
+#endif
+   }
+
+   void sample_handler(int, siginfo_t*, void* uctx) {
+      thread_samples& s = samples_tls;
+      if (!s.active || s.count >= max_samples_per_action)
+         return;
+      s.pcs[s.count] = interrupted_pc(uctx);
+      std::atomic_signal_fence(std::memory_order_release);
+      ++s.count;
+   }
+
+   void install_handler() {
+      static const bool installed = [] {
+         struct sigaction act{};
+         sigemptyset(&act.sa_mask);
+         act.sa_sigaction = sample_handler;
+         act.sa_flags = SA_SIGINFO | SA_RESTART;
+         FC_ASSERT(sigaction(sample_signal, &act, nullptr) == 0, "failed to install wasm profiler signal handler");
+         return true;
+      }();
+      (void)installed;
+   }
+
+   // CPU-time timer of the owning thread, created on its first profiled action
+   struct thread_timer {
+      timer_t id{};
+      bool    created = false;
+
+      ~thread_timer() {
+         if (created)
+            timer_delete(id);
+      }
+
+      bool arm(fc::microseconds interval) {
+         if (!created) {
+            struct sigevent se{};
+            se.sigev_notify = SIGEV_THREAD_ID;
+            se.sigev_signo  = sample_signal;
+            se.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+            if (timer_create(CLOCK_THREAD_CPUTIME_ID, &se, &id) != 0) {
+               wlog("Unable to create wasm profiler timer: {}", strerror(errno));
+               return false;
+            }
+            created = true;
+         }
+         const auto us = interval.count();
+         const timespec ts{static_cast<time_t>(us / 1'000'000), static_cast<long>(us % 1'000'000) * 1000};
+         const itimerspec spec{ts, ts};
+         return timer_settime(id, 0, &spec, nullptr) == 0;
+      }
+
+      void disarm() {
+         const itimerspec spec{};
+         timer_settime(id, 0, &spec, nullptr);
+      }
+   };
+   thread_local thread_timer timer_tls;
+#endif
+}
+
+std::optional<uint32_t> wasm_profiler::function_table::function_at(uint32_t offset) const {
+   auto it = std::upper_bound(bodies.begin(), bodies.end(), offset,
+                              [](uint32_t o, const auto& body) { return o < body.first; });
+   if (it == bodies.begin() || offset >= std::prev(it)->second)
+      return {};
+   return static_cast<uint32_t>(std::prev(it) - bodies.begin());
+}
+
+std::string wasm_profiler::function_table::name_of(uint32_t defined_index) const {
+   const uint32_t index = imported_functions + defined_index;
+   if (auto it = names.find(index); it != names.end())
+      return it->second;
+   return "f" + std::to_string(index);
+}
+
+wasm_profiler::function_table wasm_profiler::function_table::parse(std::span<const char> wasm) {
+   function_table table;
+   wasm_reader r{wasm};
+   if (!r.skip(8)) // magic and version
+      return table;
+   while (!r.at_end()) {
+      auto id   = r.byte();
+      auto size = r.varuint32();
+      if (!id || !size || *size > wasm.size() - r.pos)
+         break;
+      const size_t begin = r.pos, end = r.pos + *size;
+      bool ok = true;
+      if (*id == import_section_id) {
+         ok = parse_imports(wasm_reader{wasm.subspan(begin, *size)}, table);
+      } else if (*id == code_section_id) {
+         ok = parse_code(wasm_reader{wasm.first(end), begin}, end, table);
+      } else if (*id == custom_section_id) {
+         wasm_reader custom{wasm.subspan(begin, *size)};
+         if (auto name = custom.name(); name && *name == "name")
+            ok = parse_names(wasm_reader{custom.bytes.subspan(custom.pos)}, table);
+      }
+      if (!ok)
+         break;
+      r.pos = end;
+   }
+   return table;
+}
+
+wasm_profiler::wasm_profiler(flat_set<account_name> accounts, fc::microseconds interval)
+   : _accounts(std::move(accounts))
+   , _interval(interval)
+{
+   SYS_ASSERT(_interval.count() > 0, misc_exception, "wasm profiler sampling interval must be positive");
+#if defined(__linux__)
+   install_handler();
+#else
+   wlog("WASM sampling profiler is not supported on this platform; profiled accounts will not be sampled");
+#endif
+}
+
+wasm_profiler::~wasm_profiler() = default;
+
+wasm_profiler::scoped_sampling::scoped_sampling(wasm_profiler& profiler, const digest_type& code_hash,
+                                                account_name receiver, resolver_type resolver)
+   : _profiler(profiler)
+   , _code_hash(code_hash)
+   , _receiver(receiver)
+   , _resolver(std::move(resolver))
+{
+#if defined(__linux__)
+   thread_samples& s = samples_tls;
+   s.count = 0;
+   s.active = 1;
+   std::atomic_signal_fence(std::memory_order_seq_cst);
+   _armed = timer_tls.arm(profiler.interval());
+   if (!_armed)
+      s.active = 0;
+#endif
+}
+
+wasm_profiler::scoped_sampling::~scoped_sampling() {
+#if defined(__linux__)
+   if (!_armed)
+      return;
+   thread_samples& s = samples_tls;
+   s.active = 0;
+   std::atomic_signal_fence(std::memory_order_seq_cst);
+   timer_tls.disarm();
+   try {
+      _profiler.add_samples(_code_hash, _receiver, std::span<const uintptr_t>(s.pcs, s.count), _resolver);
+   } FC_LOG_AND_DROP()
+#endif
+}
+
+void wasm_profiler::add_samples(const digest_type& code_hash, account_name receiver, std::span<const uintptr_t> pcs,
+                                const resolver_type& resolver) {
+   std::map<uint32_t, uint64_t> functions;
+   uint64_t host = 0;
+   for (uintptr_t pc : pcs) {
+      if (auto f = resolver(pc))
+         ++functions[*f];
+      else
+         ++host;
+   }
+
+   std::lock_guard g(_mtx);
+   code_samples& cs = _samples[code_hash];
+   cs.accounts.insert(receiver);
+   cs.host_samples += host;
+   for (const auto& [f, n] : functions)
+      cs.functions[f] += n;
+}
+
+std::shared_ptr<const wasm_profiler::function_table>
+wasm_profiler::get_function_table(const chainbase::database& db, const digest_type& code_hash) {
+   {
+      std::lock_guard g(_mtx);
+      if (auto it = _tables.find(code_hash); it != _tables.end())
+         return it->second;
+   }
+   auto table = std::make_shared<const function_table>(function_table::parse(find_code(db, code_hash)));
+   std::lock_guard g(_mtx);
+   return _tables.try_emplace(code_hash, std::move(table)).first->second;
+}
+
+std::vector<wasm_profiler::code_entry> wasm_profiler::report(const chainbase::database& db) {
+   std::map<digest_type, code_samples> samples;
+   {
+      std::lock_guard g(_mtx);
+      samples = _samples;
+   }
+
+   std::vector<code_entry> result;
+   result.reserve(samples.size());
+   for (const auto& [code_hash, cs] : samples) {
+      const auto table = get_function_table(db, code_hash);
+      code_entry entry{.code_hash = code_hash,
+                       .accounts = std::vector<account_name>(cs.accounts.begin(), cs.accounts.end()),
+                       .samples = cs.host_samples,
+                       .host_samples = cs.host_samples};
+      entry.functions.reserve(cs.functions.size());
+      for (const auto& [f, n] : cs.functions) {
+         entry.functions.push_back({table->imported_functions + f, table->name_of(f), n});
+         entry.samples += n;
+      }
+      std::ranges::sort(entry.functions, std::greater{}, &function_entry::samples);
+      result.push_back(std::move(entry));
+   }
+   std::ranges::sort(result, std::greater{}, &code_entry::samples);
+   return result;
+}
+
+std::string wasm_profiler::collapsed(const std::vector<code_entry>& report) {
+   std::string out;
+   for (const auto& code : report) {
+      std::string root;
+      for (const auto& account : code.accounts) {
+         if (!root.empty())
+            root += ',';
+         root += account.to_string();
+      }
+      root += '@' + code.code_hash.str().substr(0, 16) + ';';
+      for (const auto& f : code.functions) {
+         // ';' separates frames and the last ' ' the count; demangled C++ names may hold either
+         std::string frame = f.name;
+         std::ranges::replace(frame, ';', ':');
+         std::ranges::replace(frame, ' ', '_');
+         out += root + frame + ' ' + std::to_string(f.samples) + '\n';
+      }
+      if (code.host_samples)
+         out += root + "[host] " + std::to_string(code.host_samples) + '\n';
+   }
+   return out;
+}
+
+void wasm_profiler::reset() {
+   std::lock_guard g(_mtx);
+   _samples.clear();
+}
+
+}}
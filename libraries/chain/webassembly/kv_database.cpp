@@ -27,6 +27,19 @@ namespace sysio { namespace chain { namespace webassembly {
       return context.kv_contains(checked_table_id(table_id), name(code), key.data(), key.size());
    }
 
+   // KV batched primary operations
+   int32_t interface::kv_get_many(uint32_t table_id, uint64_t code, span<const char> keys, span<char> dest) {
+      return context.kv_get_many(checked_table_id(table_id), name(code), keys.data(), keys.size(), dest.data(), dest.size());
+   }
+
+   int64_t interface::kv_set_many(uint32_t table_id, uint64_t payer, span<const char> rows) {
+      return context.kv_set_many(checked_table_id(table_id), payer, rows.data(), rows.size());
+   }
+
+   int64_t interface::kv_erase_many(uint32_t table_id, span<const char> keys) {
+      return context.kv_erase_many(checked_table_id(table_id), keys.data(), keys.size());
+   }
+
    // KV primary iterators
    uint32_t interface::kv_it_create(uint32_t table_id, uint64_t code, span<const char> prefix) {
       return context.kv_it_create(checked_table_id(table_id), name(code), prefix.data(), prefix.size());
@@ -66,6 +79,10 @@ namespace sysio { namespace chain { namespace webassembly {
       return status;
    }
 
+   int32_t interface::kv_it_read_batch(uint32_t handle, uint32_t max_rows, span<char> dest) {
+      return context.kv_it_read_batch(handle, max_rows, dest.data(), dest.size());
+   }
+
    // KV secondary index operations
    void interface::kv_idx_store(uint64_t payer, uint32_t table_id, span<const char> pri_key, span<const char> sec_key) {
       context.kv_idx_store(payer, checked_table_id(table_id),
@@ -164,6 +164,7 @@ namespace LLVMJIT
 		UnitMemoryManager* unitmemorymanager = nullptr;
 
 		std::map<unsigned, uintptr_t> function_to_offsets;
+		uintptr_t functions_end = 0;
 		std::vector<uint8_t> final_pic_code;
 		uintptr_t table_offset = 0;
 
@@ -241,8 +242,12 @@ namespace LLVMJIT
 				if(symbolSection)
 					loadedAddress += (Uptr)loadedObjInfo->getSectionLoadAddress(*symbolSection.get());
 				Uptr functionDefIndex;
-				if(getFunctionIndexFromExternalName(name->data(),functionDefIndex))
-					function_to_offsets[functionDefIndex] = loadedAddress-(uintptr_t)unitmemorymanager->code->data();
+				if(getFunctionIndexFromExternalName(name->data(),functionDefIndex)) {
+					const uintptr_t offset = loadedAddress-(uintptr_t)unitmemorymanager->code->data();
+					function_to_offsets[functionDefIndex] = offset;
+					if(offset + symbolSizePair.second > functions_end)
+						functions_end = offset + symbolSizePair.second;
+				}
 #if PRINT_DISASSEMBLY
 				disassembleFunction((U8*)loadedAddress, symbolSizePair.second);
 #endif
@@ -315,6 +320,7 @@ namespace LLVMJIT
 		instantiated_code ret;
 		ret.code = jitModule->final_pic_code;
 		ret.function_offsets = jitModule->function_to_offsets;
+		ret.functions_end = jitModule->functions_end;
 		ret.table_offset = jitModule->table_offset;
 		return ret;
 	}
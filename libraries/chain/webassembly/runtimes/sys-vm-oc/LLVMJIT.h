@@ -11,6 +11,7 @@ namespace sysio { namespace chain { namespace sysvmoc {
 struct instantiated_code {
    std::vector<uint8_t> code;
    std::map<unsigned, uintptr_t> function_offsets;
+   uintptr_t functions_end; ///< offset just past the machine code of the last function
    uintptr_t table_offset;
 };
 
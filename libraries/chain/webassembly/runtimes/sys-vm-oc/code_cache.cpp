@@ -22,7 +22,7 @@ static constexpr size_t total_header_size = header_offset + header_size;
 // renumbered: OC bakes ordinal-derived dispatch offsets into the generated machine code, so a cache produced
 // under any other intrinsic table must be discarded even though its file format is otherwise readable.
 // Bump this (together with current_codegen_version) on ANY change to intrinsic ordinals or gs-region layout.
-static constexpr uint64_t header_id = 0x33434f4d56535953ULL; //"SYSVMOC3" little endian
+static constexpr uint64_t header_id = 0x34434f4d56535953ULL; //"SYSVMOC4" little endian
 
 struct code_cache_header {
    uint64_t id = header_id;
@@ -266,7 +266,8 @@ const code_descriptor* const code_cache_sync::get_descriptor_for_code_sync(mode
       .limits = !m.whitelisted ? _sysvmoc_config.non_whitelisted_limits : std::optional<subjective_compile_limits>{}
    };
    auto fd = memfd_for_bytearray(codeobject->code);
-   write_message_with_fds(_compile_monitor_write_socket, msg, std::span<wrapped_fd>{&fd, 1});
+   SYS_ASSERT(write_message_with_fds(_compile_monitor_write_socket, msg, std::span<wrapped_fd>{&fd, 1}), wasm_execution_error,
+              "failed to send compile request to monitor process");
    auto [success, message, fds] = read_message_with_fds(_compile_monitor_read_socket);
    SYS_ASSERT(success, wasm_execution_error, "failed to read response from monitor process");
    SYS_ASSERT(std::holds_alternative<wasm_compilation_result_message>(message), wasm_execution_error, "unexpected response from monitor process");
@@ -450,7 +451,8 @@ void code_cache_base::free_code(const digest_type& code_id, const uint8_t& vm_ve
 
    std::lock_guard g(_mtx);
    if(it != _cache_index.get<by_hash>().end()) {
-      write_message_with_fds(_compile_monitor_write_socket, evict_wasms_message{ {*it} });
+      if(!write_message_with_fds(_compile_monitor_write_socket, evict_wasms_message{ {*it} }))
+         wlog("SYS VM failed to send eviction of {} to OOP manager", code_id);
       _cache_index.get<by_hash>().erase(it);
    }
 
@@ -474,7 +476,8 @@ void code_cache_base::run_eviction_round() {
       _cache_index.pop_back();
    }
    std::lock_guard g(_mtx);
-   write_message_with_fds(_compile_monitor_write_socket, evict_msg);
+   if(!write_message_with_fds(_compile_monitor_write_socket, evict_msg))
+      wlog("SYS VM failed to send eviction of {} codes to OOP manager", evict_msg.codes.size());
 }
 
 // called from main thread
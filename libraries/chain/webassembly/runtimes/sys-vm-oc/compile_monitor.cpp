@@ -127,10 +127,13 @@ struct compile_monitor_session {
          void* code_ptr = nullptr;
          void* mem_ptr = nullptr;
          try {
-            if(success && std::holds_alternative<code_compilation_result_message>(message) && fds.size() == 2) {
+            if(success && std::holds_alternative<code_compilation_result_message>(message) && fds.size() == 3) {
                code_compilation_result_message& result = std::get<code_compilation_result_message>(message);
+               //the function offsets share the initdata allocation, so evicting the code frees them too
+               const size_t initdata_size = get_size_of_fd(fds[1]);
+               const size_t function_offsets_size = get_size_of_fd(fds[2]);
                code_ptr = _allocator->allocate(get_size_of_fd(fds[0]));
-               mem_ptr = _allocator->allocate(get_size_of_fd(fds[1]));
+               mem_ptr = _allocator->allocate(initdata_size + function_offsets_size);
 
                if(code_ptr == nullptr || mem_ptr == nullptr) {
                   _allocator->deallocate(code_ptr);
@@ -140,6 +143,7 @@ struct compile_monitor_session {
                else {
                   copy_memfd_contents_to_pointer(code_ptr, fds[0]);
                   copy_memfd_contents_to_pointer(mem_ptr, fds[1]);
+                  copy_memfd_contents_to_pointer((char*)mem_ptr + initdata_size, fds[2]);
 
                   reply.queued_time = result.queued_time;
                   reply.result = code_descriptor {
@@ -151,8 +155,9 @@ struct compile_monitor_session {
                      result.apply_offset,
                      result.starting_memory_pages,
                      (uintptr_t)mem_ptr - (uintptr_t)_code_mapping,
-                     (unsigned)get_size_of_fd(fds[1]),
-                     result.initdata_prologue_size
+                     (unsigned)initdata_size,
+                     result.initdata_prologue_size,
+                     (unsigned)(function_offsets_size / sizeof(uint32_t) - 1)
                   };
                }
             }
@@ -162,7 +167,11 @@ struct compile_monitor_session {
             _allocator->deallocate(mem_ptr);
          }
 
-         write_message_with_fds(_nodeop_instance_socket, reply);
+         //nodeop never learns of code it was not told about, so do not keep it allocated
+         if(!write_message_with_fds(_nodeop_instance_socket, reply) && std::holds_alternative<code_descriptor>(reply.result)) {
+            _allocator->deallocate(code_ptr);
+            _allocator->deallocate(mem_ptr);
+         }
 
          //either way, we are done
          boost::asio::post(_ctx, [this, current_compile_it]() {
@@ -49,6 +49,14 @@ void run_compile(wrapped_fd&& response_sock, wrapped_fd&& wasm_code, uint64_t st
    else
       result_message.start = code_offset{function_to_offsets.at(module.startFunctionIndex-module.functions.imports.size())};
 
+   //sent as an fd rather than in the message: a datagram could not hold the offsets of a large module.
+   //the end of the last function follows the offsets, so pcs in the data after the code resolve to no function
+   std::vector<uint32_t> function_offsets;
+   function_offsets.reserve(function_to_offsets.size() + 1);
+   for(const auto& [index, offset] : function_to_offsets)
+      function_offsets.push_back(offset);
+   function_offsets.push_back(code.functions_end);
+
    for(const Export& exprt : module.exports) {
       if(exprt.name == "apply")
          result_message.apply_offset = function_to_offsets.at(exprt.index-module.functions.imports.size());
@@ -147,8 +155,10 @@ void run_compile(wrapped_fd&& response_sock, wrapped_fd&& wasm_code, uint64_t st
            receiver, wasm.size()/1024, code.code.size()/1024, get_resource_size()/1024,
            (fc::time_point::now() - start).count()/1000, (fc::time_point::now() - queued_time).count()/1000);
    }
-   std::array<wrapped_fd, 2> fds_to_send{ memfd_for_bytearray(code.code), memfd_for_bytearray(initdata_prep) };
-   write_message_with_fds(response_sock, result_message, fds_to_send);
+   const std::span<const uint8_t> function_offsets_bytes{(const uint8_t*)function_offsets.data(), function_offsets.size()*sizeof(uint32_t)};
+   std::array<wrapped_fd, 3> fds_to_send{ memfd_for_bytearray(code.code), memfd_for_bytearray(initdata_prep), memfd_for_bytearray(function_offsets_bytes) };
+   if(!write_message_with_fds(response_sock, result_message, fds_to_send))
+      std::cerr << "SYS VM OC compile failed to send its result for receiver " << receiver.to_string() << std::endl;
 }
 
 void run_compile_trampoline(int fd) {
@@ -11,6 +11,7 @@
 #include <sysio/chain/exceptions.hpp>
 #include <sysio/chain/types.hpp>
 #include <sysio/chain/global_property_object.hpp>
+#include <sysio/chain/wasm_profiler.hpp>
 
 #include <fc/scoped_exit.hpp>
 
@@ -247,6 +248,36 @@ void executor::execute(const code_descriptor& code, memory& mem, apply_context&
 
    void(*apply_func)(uint64_t, uint64_t, uint64_t) = (void(*)(uint64_t, uint64_t, uint64_t))(cb->running_code_base + code.apply_offset);
 
+   std::optional<wasm_profiler::scoped_sampling> sampling;
+   if(wasm_profiler* profiler = context.control.get_wasm_profiler(); profiler && profiler->is_profiling(context.get_receiver())) {
+      const uintptr_t code_base = cb->running_code_base;
+      const uint8_t* const function_offsets = code_mapping + code.initdata_begin + code.initdata_size;
+      // the end of the last function's code follows the function offsets; data after it belongs to no function
+      uint32_t functions_end;
+      memcpy(&functions_end, function_offsets + code.function_count*sizeof(uint32_t), sizeof(functions_end));
+      // starts holds (code offset, defined function index) sorted by offset, built on the first sample that needs it
+      sampling.emplace(*profiler, code.code_hash, context.get_receiver(),
+                       [code_base, functions_end, function_offsets, count=code.function_count,
+                        starts=std::vector<std::pair<uint32_t, uint32_t>>()](uintptr_t pc) mutable -> std::optional<uint32_t> {
+         if(pc < code_base || pc - code_base >= functions_end || count == 0)
+            return std::nullopt;
+         if(starts.empty()) {
+            starts.reserve(count);
+            for(uint32_t i = 0; i < count; ++i) {
+               uint32_t offset;
+               memcpy(&offset, function_offsets + i*sizeof(uint32_t), sizeof(offset));
+               starts.emplace_back(offset, i);
+            }
+            std::sort(starts.begin(), starts.end());
+         }
+         // functions are not necessarily laid out in index order; pick the closest start at or below pc
+         auto it = std::upper_bound(starts.begin(), starts.end(), std::make_pair((uint32_t)(pc - code_base), UINT32_MAX));
+         if(it == starts.begin())
+            return std::nullopt;
+         return std::prev(it)->second;
+      });
+   }
+
    switch(sigsetjmp(*cb->jmp, 0)) {
       case 0:
          stack.run([&]{
@@ -3,9 +3,6 @@
 
 namespace sysio { namespace chain { namespace sysvmoc {
 
-static constexpr size_t max_message_size = 8192;
-static constexpr size_t max_num_fds = 4;
-
 std::tuple<bool, sysvmoc_message, std::vector<wrapped_fd>> read_message_with_fds(boost::asio::local::datagram_protocol::socket& s) {
    // read_message_with_fds() is intended to be blocking, and sockets it is used with are never explicitly set to non-blocking mode.
    // But when doing an async_wait() on an asio socket, asio will set the underlying file descriptor to non-blocking mode.
@@ -6,6 +6,7 @@
 #include <sysio/chain/transaction_context.hpp>
 #include <sysio/chain/global_property_object.hpp>
 #include <sysio/chain/wasm_sysio_constraints.hpp>
+#include <sysio/chain/wasm_profiler.hpp>
 //sys-vm includes
 #include <sysio/vm/backend.hpp>
 #include <sysio/chain/webassembly/preconditions.hpp>
@@ -155,6 +156,9 @@ class sys_vm_instantiated_module : public wasm_instantiated_module_interface {
                 context.get_action().account.to_uint64_t(),
                 context.get_action().name.to_uint64_t());
          };
+         std::optional<wasm_profiler::scoped_sampling> sampling;
+         if constexpr (std::is_same_v<Impl, sysio::vm::jit>)
+            start_sampling(context, sampling);
          try {
             checktime_watchdog wd(context.trx_context.transaction_timer);
             _runtime->_bkend.timed_run(std::move(wd), std::move(fn));
@@ -172,6 +176,26 @@ class sys_vm_instantiated_module : public wasm_instantiated_module_interface {
       }
 
    private:
+      void start_sampling(apply_context& context, std::optional<wasm_profiler::scoped_sampling>& sampling) {
+         wasm_profiler* profiler = context.control.get_wasm_profiler();
+         if(!profiler || !profiler->is_profiling(context.get_receiver()))
+            return;
+         const auto& db = context.control.db();
+         const digest_type& code_hash = db.get<account_metadata_object, by_name>(context.get_receiver()).code_hash;
+         // the jit keeps a map from machine code back to offsets in the wasm binary
+         const vm::profile_instr_map& debug = _instantiated_module->get_debug();
+         sampling.emplace(*profiler, code_hash, context.get_receiver(),
+                          [&debug, table=profiler->get_function_table(db, code_hash)](uintptr_t pc) -> std::optional<uint32_t> {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(debug.code_base);
+            if(pc < base || pc - base >= debug.code_size)
+               return std::nullopt;
+            const uint32_t offset = debug.translate(reinterpret_cast<const void*>(pc));
+            if(offset == std::numeric_limits<uint32_t>::max())
+               return std::nullopt;
+            return table->function_at(offset);
+         });
+      }
+
       sys_vm_runtime<Impl>*            _runtime;
       std::unique_ptr<backend_t> _instantiated_module;
 };
@@ -518,6 +542,10 @@ REGISTER_HOST_FUNCTION(kv_idx_prev);
 REGISTER_ALIGNED_HOST_FUNCTION(kv_idx_key);
 REGISTER_ALIGNED_HOST_FUNCTION(kv_idx_primary_key);
 REGISTER_HOST_FUNCTION(kv_idx_destroy);
+REGISTER_ALIGNED_HOST_FUNCTION(kv_get_many);
+REGISTER_ALIGNED_HOST_FUNCTION(kv_set_many);
+REGISTER_ALIGNED_HOST_FUNCTION(kv_erase_many);
+REGISTER_ALIGNED_HOST_FUNCTION(kv_it_read_batch);
 
 // memory api
 REGISTER_ALIGNED_CF_HOST_FUNCTION(memcpy);
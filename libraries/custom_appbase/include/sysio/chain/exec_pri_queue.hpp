@@ -2,15 +2,23 @@
 #include <boost/asio.hpp>
 #include <boost/heap/binomial_heap.hpp>
 
+#include <sysio/chain/handler_pool.hpp>
+
+#include <fc/latency_histogram.hpp>
+
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
-#include <numeric>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace appbase {
 // adapted from: https://www.boost.org/doc/libs/1_69_0/doc/html/boost_asio/example/cpp11/invocation/prioritised_handlers.cpp
@@ -52,6 +60,7 @@ class exec_pri_queue : public boost::asio::execution_context
 public:
 
    ~exec_pri_queue() {
+      drain_admission();
       for (auto& q : queues_)
          clear(q);
    }
@@ -92,7 +101,7 @@ public:
       const std::lock_guard<std::mutex> lock_;
       const exec_pri_queue&             q_;
    public:
-      read_view(const exec_pri_queue& q, std::mutex& mtx) : lock_(mtx), q_(q) {}
+      read_view(exec_pri_queue& q, std::mutex& mtx) : lock_(mtx), q_(q) { q.drain_admission(); }
       read_view(const read_view&) = delete;
       read_view& operator=(const read_view&) = delete;
       read_view(read_view&&) noexcept = delete;
@@ -109,7 +118,7 @@ public:
       }
    };
 
-   [[nodiscard]] read_view readable() const { return read_view(*this, mtx_); }
+   [[nodiscard]] read_view readable() { return read_view(*this, mtx_); }
 
 private:
 
@@ -122,12 +131,8 @@ private:
          return std::make_unique<queued_handler<Function>>(handler_id::unique, priority, order, std::forward<Function>(function));
       };
       if (q == exec_queue::read_exclusive || lock_enabled_) {
-         std::unique_ptr<queued_handler_base> handler = create_handler();
          // called directly from any thread for read_exclusive
-         std::scoped_lock g( mtx_ );
-         que.push( handler.release() );
-         if (num_waiting_)
-            cond_.notify_one();
+         admit_handler(q, create_handler().release());
       } else if (q == exec_queue::trx_read_write) {
          std::scoped_lock g( mtx_ );
          if (!force && empty(exec_queue::trx_read_write)) {
@@ -145,6 +150,18 @@ private:
 
 public:
 
+   // Lock-free admission of a unique handler, callable from any thread. Each posting thread pushes onto one of
+   // lane_count intrusive lists of q, so concurrent producers rarely touch the same cache line; whichever thread
+   // next takes from q merges all of its lanes into the queue in one batch. Queue order is (priority, order), so
+   // list order does not matter. Waiting read threads are woken here.
+   // Returns true if the lane was empty, in which case a consumer that only runs when woken, like the main
+   // thread blocked in io_context::run_one(), must be woken by the caller.
+   template <typename Function>
+   bool admit(exec_queue q, int priority, size_t order, Function&& function) {
+      assert( num_read_threads_ > 0 || q != exec_queue::read_exclusive);
+      return admit_handler(q, new queued_handler<Function>(handler_id::unique, priority, order, std::forward<Function>(function)));
+   }
+
    // return false if should be posted instead, force=true then add will add to queue and return true
    template <typename Function>
    bool add(int priority, exec_queue q, size_t order, Function&& function) {
@@ -166,6 +183,7 @@ public:
          // called directly from any thread for read_exclusive
          g.lock();
       }
+      drain_admission(q);
       if (!que.empty()) {
          // find the associated priority
          auto end = que.ordered_end();
@@ -180,12 +198,13 @@ public:
          }
       }
       que.push( new queued_handler<Function>(id, priority, order, std::forward<Function>(function)) );
-      if (g.owns_lock() && num_waiting_)
+      if (g.owns_lock() && num_waiting_.load())
          cond_.notify_one();
    }
 
    // only call when no lock required
    void clear() {
+      drain_admission();
       for (auto& q : queues_)
          q = prio_queue();
    }
@@ -193,9 +212,10 @@ public:
    bool execute_highest_locked(exec_queue q) {
       prio_queue& que = priority_que(q);
       std::unique_lock g(mtx_);
+      drain_admission(q);
       if (que.empty())
          return false;
-      auto t = pop(que);
+      auto t = take(q);
       g.unlock();
       t->execute();
       return true;
@@ -207,6 +227,8 @@ public:
    //   1 means there was one executed and none remain.
    //   > 1 means there was one executed and return-1 remain.
    size_t execute_highest(exec_queue lhs, exec_queue rhs) {
+      drain_admission(lhs);
+      drain_admission(rhs);
       prio_queue& lhs_que = priority_que(lhs);
       prio_queue& rhs_que = priority_que(rhs);
       size_t size = lhs_que.size() + rhs_que.size();
@@ -215,10 +237,9 @@ public:
       exec_queue q = rhs;
       if (!lhs_que.empty() && (rhs_que.empty() || *rhs_que.top() < *lhs_que.top()))
          q = lhs;
-      prio_queue& que = priority_que(q);
-      assert(que.top());
+      assert(priority_que(q).top());
       // pop, then execute since read_write queue is used to switch to read window and the pop needs to happen before that lambda starts
-      auto t = pop(que);
+      auto t = take(q);
       t->execute();
       return size;
    }
@@ -227,9 +248,14 @@ public:
       prio_queue& lhs_que = priority_que(lhs);
       prio_queue& rhs_que = priority_que(rhs);
       std::unique_lock g(mtx_);
-      ++num_waiting_;
+      ++num_waiting_; // before draining, see admit_handler()
       cond_.wait(g, [&](){
          bool exit = exiting_blocking_ || should_exit_();
+         if (!exit) {
+            // once exiting the main thread may own the queues again
+            drain_admission(lhs);
+            drain_admission(rhs);
+         }
          bool empty = lhs_que.empty() && rhs_que.empty();
          if (empty || exit) {
             if (((empty && num_waiting_ == max_waiting_) || exit) && !exiting_blocking_) {
@@ -248,20 +274,23 @@ public:
       exec_queue q = rhs;
       if (!lhs_que.empty() && (rhs_que.empty() || *rhs_que.top() < *lhs_que.top()))
          q = lhs;
-      auto t = pop(priority_que(q));
+      auto t = take(q);
       g.unlock();
       t->execute();
       return true; // this should never return false unless all read threads should exit
    }
 
    // Only call when locking disabled
-   size_t size(exec_queue q) const { return priority_que(q).size(); }
+   size_t size(exec_queue q) const { return priority_que(q).size() + admitted(q); }
    size_t size() const {
-      return std::accumulate(queues_.begin(), queues_.end(), size_t(0), [](size_t s, const prio_queue& q) { return s + q.size(); });
+      size_t s = 0;
+      for (size_t q = 0; q < queues_.size(); ++q)
+         s += size(static_cast<exec_queue>(q));
+      return s;
    }
 
    // Only call when locking disabled
-   bool empty(exec_queue q) const { return priority_que(q).empty(); }
+   bool empty(exec_queue q) const { return priority_que(q).empty() && admitted(q) == 0; }
 
    // Only call when locking disabled
    const auto& top(exec_queue q) const { return priority_que(q).top(); }
@@ -354,8 +383,16 @@ private:
 
       virtual ~queued_handler_base() = default;
 
+      // the virtual destructor makes delete pass the size of the most derived handler
+      static void* operator new(std::size_t size) { return handler_pool::allocate(size); }
+      static void operator delete(void* p, std::size_t size) noexcept { handler_pool::deallocate(p, size); }
+
+      std::chrono::steady_clock::time_point queued_at() const { return queued_at_; }
+
       virtual void execute() = 0;
 
+      queued_handler_base* next_ = nullptr; // admission list link, see admit()
+
       handler_id id() const { return id_; }
       int priority() const { return priority_; }
 
@@ -368,6 +405,7 @@ private:
       handler_id id_; // unique identifier of handler
       int priority_;  // priority of handler, see application_base priority
       size_t order_;  // maintain order within priority grouping
+      std::chrono::steady_clock::time_point queued_at_ = std::chrono::steady_clock::now();
    };
 
    template <typename Function>
@@ -420,20 +458,118 @@ private:
       return t;
    }
 
+   // appbase::priority levels; a handler is reported under the highest level not above its priority
+   static constexpr std::array<std::pair<int, const char*>, 7> priority_bands{{
+      {std::numeric_limits<int>::min(), "lowest"}, {10, "low"}, {25, "medium_low"}, {50, "medium"},
+      {75, "medium_high"}, {100, "high"}, {std::numeric_limits<int>::max(), "highest"}}};
+
+   static size_t priority_band(int priority) {
+      size_t b = 0;
+      while (b + 1 < priority_bands.size() && priority >= priority_bands[b + 1].first)
+         ++b;
+      return b;
+   }
+
+   // pop the highest handler of q for execution, recording how long it waited in the queue
+   std::unique_ptr<exec_pri_queue::queued_handler_base> take(exec_queue q) {
+      static const auto wait_latency = make_wait_histograms();
+      auto t = pop(priority_que(q));
+      wait_latency[static_cast<size_t>(q) * priority_bands.size() + priority_band(t->priority())]
+         ->record(std::chrono::steady_clock::now() - t->queued_at());
+      return t;
+   }
+
+   // one histogram per (queue, priority band), indexed queue * priority_bands.size() + band
+   static std::vector<std::unique_ptr<fc::latency_histogram>> make_wait_histograms() {
+      constexpr std::array<const char*, static_cast<size_t>(exec_queue::size)> queue_names{
+         "read_only", "read_write", "trx_read_write", "read_exclusive"};
+      std::vector<std::unique_ptr<fc::latency_histogram>> histograms;
+      for (const char* queue : queue_names)
+         for (const auto& [_, band] : priority_bands)
+            histograms.push_back(std::make_unique<fc::latency_histogram>(
+               "nodeop_exec_queue_wait_seconds", "time handlers wait in an exec_pri_queue queue before executing",
+               fc::latency_histogram::labels_type{{"queue", queue}, {"priority", band}}));
+      return histograms;
+   }
+
    void clear(prio_queue& que) {
       while (!que.empty())
          pop(que);
    }
 
+   // Push onto the calling thread's lane of q. The push and the load of num_waiting_ are seq_cst, pairing with
+   // the increment of num_waiting_ and the lane load in drain_admission() by a waiting thread: either the
+   // waiter sees the handler before it sleeps or this sees the waiter and notifies it.
+   bool admit_handler(exec_queue q, queued_handler_base* handler) {
+      lane& l = lanes_[static_cast<size_t>(q)][lane_index()];
+      l.size.fetch_add(1, std::memory_order_relaxed);
+      queued_handler_base* head = l.head.load(std::memory_order_relaxed);
+      do {
+         handler->next_ = head;
+      } while (!l.head.compare_exchange_weak(head, handler, std::memory_order_seq_cst, std::memory_order_relaxed));
+      // only read threads wait, and only on read_only and read_exclusive
+      if ((q == exec_queue::read_only || q == exec_queue::read_exclusive) && num_waiting_.load() > 0) {
+         std::scoped_lock g( mtx_ );
+         cond_.notify_one();
+      }
+      return head == nullptr;
+   }
+
+   // a posting thread keeps the lane it was first given
+   static size_t lane_index() {
+      static std::atomic<size_t> next_lane{0};
+      thread_local const size_t index = next_lane.fetch_add(1, std::memory_order_relaxed) % lane_count;
+      return index;
+   }
+
+   // handlers admitted but not yet merged into queue q
+   size_t admitted(exec_queue q) const {
+      size_t n = 0;
+      for (const lane& l : lanes_[static_cast<size_t>(q)])
+         n += l.size.load(std::memory_order_relaxed);
+      return n;
+   }
+
+   // merge the lanes of q into its queue; caller holds mtx_ or is the only thread taking from q
+   void drain_admission(exec_queue q) {
+      prio_queue& que = priority_que(q);
+      for (lane& l : lanes_[static_cast<size_t>(q)]) {
+         // plain load first so idle lanes are not written to
+         if (!l.head.load())
+            continue;
+         queued_handler_base* h = l.head.exchange(nullptr, std::memory_order_acquire);
+         size_t n = 0;
+         for (; h; ++n) {
+            queued_handler_base* next = h->next_;
+            que.push(h);
+            h = next;
+         }
+         l.size.fetch_sub(n, std::memory_order_relaxed);
+      }
+   }
+
+   void drain_admission() {
+      for (size_t q = 0; q < lanes_.size(); ++q)
+         drain_admission(static_cast<exec_queue>(q));
+   }
+
    size_t num_read_threads_ = 0;
    bool lock_enabled_ = false;
    mutable std::mutex mtx_;
    std::condition_variable cond_;
-   uint32_t num_waiting_{0};
+   std::atomic<uint32_t> num_waiting_{0};
    uint32_t max_waiting_{0};
    bool exiting_blocking_{false};
    std::function<bool()> should_exit_; // called holding mtx_
    std::array<prio_queue, static_cast<size_t>(exec_queue::size)> queues_;
+
+   // lock-free admission lists, see admit()
+   static constexpr size_t lane_count = 8;
+   struct alignas(64) lane {
+      std::atomic<queued_handler_base*> head{nullptr};
+      std::atomic<size_t>               size{0};
+   };
+   std::array<std::array<lane, lane_count>, static_cast<size_t>(exec_queue::size)> lanes_;
 };
 
 } // appbase
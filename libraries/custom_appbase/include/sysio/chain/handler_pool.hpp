@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+namespace appbase {
+
+// Size-classed free lists for exec_pri_queue handlers.
+//
+// Handlers are allocated by the posting thread (net, http, chain threads) and freed by the thread that executes
+// them (main or read-only threads), so a plain thread-local cache would only ever fill up on the executing side.
+// Freed blocks are instead pushed onto a process-wide lock-free list per size class; an allocating thread takes the
+// whole list in one exchange into its thread-local cache and serves later allocations from there. Taking the whole
+// list, rather than popping single nodes, is what keeps the list free of ABA races.
+//
+// Blocks are never returned to the heap; the pool holds the high-water mark of outstanding handlers per class.
+// Handlers larger than the largest class use the heap directly.
+class handler_pool {
+public:
+   static constexpr size_t min_block   = 64;
+   static constexpr size_t max_block   = 1024;
+   static constexpr size_t class_count = std::countr_zero(max_block) - std::countr_zero(min_block) + 1;
+
+   static void* allocate(size_t size) {
+      if (size > max_block)
+         return ::operator new(size);
+      const size_t c = size_class(size);
+      node*& cache = local_cache().heads[c];
+      if (!cache)
+         cache = free_lists()[c].exchange(nullptr, std::memory_order_acquire);
+      if (node* n = cache) {
+         cache = n->next;
+         return n;
+      }
+      return ::operator new(block_size(c));
+   }
+
+   static void deallocate(void* p, size_t size) noexcept {
+      if (size > max_block) {
+         ::operator delete(p);
+         return;
+      }
+      push(size_class(size), static_cast<node*>(p));
+   }
+
+private:
+   struct node {
+      node* next;
+   };
+
+   static constexpr size_t size_class(size_t size) {
+      return size <= min_block ? 0 : std::bit_width(size - 1) - std::countr_zero(min_block);
+   }
+
+   static constexpr size_t block_size(size_t c) { return min_block << c; }
+
+   static void push(size_t c, node* n) noexcept {
+      auto& head = free_lists()[c];
+      n->next = head.load(std::memory_order_relaxed);
+      while (!head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed))
+         ;
+   }
+
+   struct cache {
+      std::array<node*, class_count> heads{};
+      // return what this thread holds so another thread can use it
+      ~cache() {
+         for (size_t c = 0; c < class_count; ++c) {
+            while (node* n = heads[c]) {
+               heads[c] = n->next;
+               push(c, n);
+            }
+         }
+      }
+   };
+
+   static std::array<std::atomic<node*>, class_count>& free_lists() {
+      static std::array<std::atomic<node*>, class_count> lists{};
+      return lists;
+   }
+
+   static cache& local_cache() {
+      thread_local cache c;
+      return c;
+   }
+};
+
+} // namespace appbase
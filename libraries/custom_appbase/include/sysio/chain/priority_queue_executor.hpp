@@ -57,17 +57,20 @@ public:
 
    template <typename Func>
    void post( handler_id id, int priority, exec_queue q, Func&& func ) {
-      if (q == exec_queue::read_exclusive || q == exec_queue::trx_read_write) {
+      if (q == exec_queue::read_exclusive) {
          // no reason to post to io_context which then places this in the read_exclusive_handlers queue.
          // read_exclusive tasks are run exclusively by read threads by pulling off the read_exclusive handlers queue.
-         // similarly, trx_read_write trxs are pulled off the queue directly to be executed
          assert(id == handler_id::unique);
-         if (!pri_queue_.add(priority, q, --order_, std::forward<Func>(func))) {
-            // post required to trigger io_ctx_ run_one
-            boost::asio::post(io_ctx_, pri_queue_.wrap(id, priority, q, order_, std::forward<Func>(func)));
-         }
+         pri_queue_.admit(q, priority, --order_, std::forward<Func>(func));
+      } else if (id == handler_id::unique) {
+         // posts arrive from net, http and chain threads; they are admitted without taking the queue lock and
+         // merged in batches by whichever thread next executes from the queue. Only the first into an empty
+         // admission lane wakes the io_context as the main thread may be blocked on io_context.run_one() in
+         // application::exec(), any later one is picked up by the same merge.
+         if (pri_queue_.admit(q, priority, --order_, std::forward<Func>(func)))
+            boost::asio::post(io_ctx_, []() {});
       } else {
-         // post to io_context as the main thread may be blocked on io_context.run_one() in application::exec()
+         // de-duplicated by id against the queue, which requires the main thread or the queue lock
          boost::asio::post(io_ctx_, pri_queue_.wrap(id, priority, q, --order_, std::forward<Func>(func)));
       }
    }
@@ -172,7 +175,7 @@ public:
    bool trx_read_write_queue_empty() { return pri_queue_.empty(exec_queue::trx_read_write); }
    bool read_exclusive_queue_empty() { return pri_queue_.empty(exec_queue::read_exclusive); }
 
-   [[nodiscard]] exec_pri_queue::read_view readable_queue() const { return pri_queue_.readable(); }
+   [[nodiscard]] exec_pri_queue::read_view readable_queue() { return pri_queue_.readable(); }
 
    // members are ordered taking into account that the last one is destructed first
 private:
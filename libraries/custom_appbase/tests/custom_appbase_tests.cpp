@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <thread>
+#include <vector>
 #include <iostream>
 
 using namespace appbase;
@@ -416,6 +417,35 @@ BOOST_AUTO_TEST_CASE( execute_from_read_only_and_read_write_queues ) {
    BOOST_CHECK_LT( rslts[6], rslts[11] );
 }
 
+// verify trx_read_write functions posted concurrently from many threads while exec() runs are all executed,
+// whether they land in an empty admission list (and wake the app thread) or in one being merged
+BOOST_AUTO_TEST_CASE( execute_trx_read_write_posted_concurrently ) {
+   scoped_app_thread app;
+
+   constexpr int num_threads = 8;
+   constexpr int num_per_thread = 5000;
+   std::atomic<int> executed = 0;
+   std::vector<std::thread> threads;
+   for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+         for (int i = 0; i < num_per_thread; ++i) {
+            app->executor().post( priority::high + (i % 3), exec_queue::trx_read_write, [&]() {
+               if (++executed == num_threads * num_per_thread)
+                  app->quit();
+            } );
+            if (i % 1000 == t)
+               std::this_thread::yield(); // let the app thread drain so later posts find an empty admission list
+         }
+      });
+   }
+   for (auto& t : threads)
+      t.join();
+   app.join();
+
+   BOOST_REQUIRE_EQUAL( executed.load(), num_threads * num_per_thread );
+   BOOST_REQUIRE_EQUAL( app->executor().trx_read_write_queue_empty(), true );
+}
+
 // verify functions from queues (read_only, read_write, trx_read_write) are processed in write window, but not read_exclusive
 // trx_read_write are processed after all read_only and read_write
 BOOST_AUTO_TEST_CASE( execute_from_read_only_and_read_write_and_trx_read_write_queues ) {
@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+
+#include <appbase/application_base.hpp>
+#include <sysio/chain/exec_pri_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace appbase;
+
+namespace {
+
+constexpr size_t posts_per_producer = 20000;
+
+// Posts posts_per_producer handlers from each of num_producers threads while one consumer executes them.
+template <typename Post, typename ExecuteOne>
+void run_producers(size_t num_producers, Post&& post, ExecuteOne&& execute_one, std::atomic<size_t>& executed) {
+   const size_t total = num_producers * posts_per_producer;
+   std::atomic<bool> go = false;
+   std::vector<std::thread> producers;
+   for (size_t p = 0; p < num_producers; ++p) {
+      producers.emplace_back([&, p]() {
+         while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+         for (size_t i = 0; i < posts_per_producer; ++i)
+            post(static_cast<int>(priority::medium + (p + i) % 3), p * posts_per_producer + i);
+      });
+   }
+   go.store(true, std::memory_order_release);
+   while (executed.load(std::memory_order_relaxed) < total) {
+      if (!execute_one())
+         std::this_thread::yield();
+   }
+   for (auto& t : producers)
+      t.join();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(exec_pri_queue_tests)
+
+// every handler admitted concurrently is executed exactly once, in priority order per consumer pass
+BOOST_AUTO_TEST_CASE( admit_from_many_threads ) {
+   exec_pri_queue q;
+   constexpr size_t num_producers = 16;
+   std::atomic<size_t> executed = 0;
+   std::vector<std::atomic<int>> seen(num_producers * posts_per_producer);
+   std::atomic<size_t> order{std::numeric_limits<size_t>::max()};
+
+   run_producers(num_producers,
+      [&](int priority, size_t i) {
+         q.admit(exec_queue::trx_read_write, priority, --order, [&, i]() {
+            ++seen[i];
+            executed.fetch_add(1, std::memory_order_relaxed);
+         });
+      },
+      [&]() { return q.execute_highest_locked(exec_queue::trx_read_write); },
+      executed);
+
+   BOOST_TEST(q.empty(exec_queue::trx_read_write));
+   BOOST_TEST(std::all_of(seen.begin(), seen.end(), [](const auto& s) { return s.load() == 1; }));
+}
+
+// admitted handlers are merged with queued ones and ordered by (priority, order)
+BOOST_AUTO_TEST_CASE( admit_merges_in_priority_order ) {
+   exec_pri_queue q;
+   std::vector<int> rslts;
+   size_t order = std::numeric_limits<size_t>::max();
+   q.admit(exec_queue::read_write, priority::low,  --order, [&]() { rslts.push_back(0); });
+   q.admit(exec_queue::read_write, priority::high, --order, [&]() { rslts.push_back(1); });
+   q.add(priority::medium, exec_queue::read_write, --order, [&]() { rslts.push_back(2); });
+   q.admit(exec_queue::read_only,  priority::high, --order, [&]() { rslts.push_back(3); });
+   q.admit(exec_queue::read_write, priority::high, --order, [&]() { rslts.push_back(4); });
+   BOOST_TEST(q.size() == 5u);
+
+   while (q.execute_highest(exec_queue::read_write, exec_queue::read_only))
+      ;
+   BOOST_TEST(rslts == (std::vector<int>{1, 3, 4, 2, 0}));
+   BOOST_TEST(q.size() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -176,5 +176,11 @@ namespace fc {
    }
 }
 
+namespace fc::raw {
+   static_assert( sizeof(fc::sha256) == fc::sha256::byte_size );
+   template<>
+   inline constexpr bool has_raw_layout_v<fc::sha256> = true;
+}
+
 #include <fc/reflect/reflect.hpp>
 FC_REFLECT_TYPENAME( fc::sha256 )
@@ -143,6 +143,9 @@ namespace fc { namespace json_relaxed
 
            while( true )
            {
+               if( append_plain_run( in, token ) )
+                   continue;
+
                char c = in.peek();
 
                if (c == EOF) {
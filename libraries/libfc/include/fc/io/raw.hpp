@@ -299,6 +299,33 @@ namespace fc {
 
     namespace detail {
 
+      template<typename T>
+      struct is_std_array : std::false_type {};
+      template<typename T, std::size_t S>
+      struct is_std_array<std::array<T, S>> : std::true_type {};
+
+      /**
+       * True when fc::raw encodes T as its sizeof(T) object bytes and accepts any bytes back: arithmetic types
+       * other than bool (whose unpack validates), std::array of scalars and has_raw_layout_v opt-ins. Encoding
+       * is native byte order either way, so copying runs of these changes nothing on the wire.
+       */
+      template<typename T>
+      constexpr bool has_raw_encoding() {
+         if constexpr( std::is_integral_v<T> )
+            return !std::is_same_v<T, bool>;
+         else if constexpr( std::is_floating_point_v<T> )
+            return true;
+         else if constexpr( is_std_array<T>::value )
+            return TrivialScalar<typename T::value_type>;
+         else
+            return has_raw_layout_v<T>;
+      }
+
+      /**
+       * Visits the reflected fields of a class in order. Fields with a raw encoding that are adjacent in memory,
+       * in reflection order, form a run written with a single write; any other field ends the run and is packed
+       * on its own. flush() must be called after the visit.
+       */
       template<typename Stream, typename Class>
       struct pack_object_visitor {
         pack_object_visitor(const Class& _c, Stream& _s)
@@ -306,13 +333,33 @@ namespace fc {
 
         template<typename T, typename C, T(C::*p)>
         void operator()( const char* name )const {
-          fc::raw::pack( s, c.*p );
+          if constexpr( has_raw_encoding<std::remove_const_t<T>>() ) {
+            const char* field = reinterpret_cast<const char*>( &(c.*p) );
+            if( field != run_end ) {
+              flush();
+              run_begin = field;
+            }
+            run_end = field + sizeof(T);
+          } else {
+            flush();
+            fc::raw::pack( s, c.*p );
+          }
         }
+
+        void flush()const {
+          if( run_begin != run_end )
+            s.write( run_begin, run_end - run_begin );
+          run_begin = run_end = nullptr;
+        }
+
         private:
-          const Class& c;
-          Stream&      s;
+          const Class&        c;
+          Stream&             s;
+          mutable const char* run_begin = nullptr;
+          mutable const char* run_end   = nullptr;
       };
 
+      /// Counterpart of pack_object_visitor, reading each run of raw fields with a single read.
       template<typename Stream, typename Class>
       struct unpack_object_visitor : public fc::reflector_init_visitor<Class> {
         unpack_object_visitor(Class& _c, Stream& _s)
@@ -320,16 +367,52 @@ namespace fc {
 
         template<typename T, typename C, T(C::*p)>
         inline void operator()( const char* name )const
-        { try {
+        {
           // `const_cast` because we want to be able to populate `const` members of a class, which
           // are typically set only in the constructor, but because of the `reflect` and `raw`
           // interfaces, we have to create the object first and then populate the members.
           // -------------------------------------------------------------------------------------
-          fc::raw::unpack( s, const_cast<std::remove_const_t<T>&>(this->obj.*p) );
-        } FC_RETHROW_EXCEPTIONS( warn, "Error unpacking field {}", name ) }
+          auto& field = const_cast<std::remove_const_t<T>&>(this->obj.*p);
+          if constexpr( has_raw_encoding<std::remove_const_t<T>>() ) {
+            char* begin = reinterpret_cast<char*>( &field );
+            if( begin != run_end ) {
+              flush();
+              run_begin = begin;
+              run_name  = name;
+            }
+            run_end = begin + sizeof(T);
+          } else {
+            flush();
+            try {
+              fc::raw::unpack( s, field );
+            } FC_RETHROW_EXCEPTIONS( warn, "Error unpacking field {}", name )
+          }
+        }
+
+        void flush()const {
+          if( run_begin == run_end )
+            return;
+          try {
+            s.read( run_begin, run_end - run_begin );
+          } FC_RETHROW_EXCEPTIONS( warn, "Error unpacking field {}", run_name )
+          run_begin = run_end = nullptr;
+        }
+
+        // called by reflector<Class>::visit after the last field; the pending run must be read first
+        void reflector_init()const {
+          flush();
+          fc::reflector_init_visitor<Class>::reflector_init();
+        }
+        void reflector_init() {
+          flush();
+          fc::reflector_init_visitor<Class>::reflector_init();
+        }
 
         private:
-          Stream& s;
+          Stream&             s;
+          mutable char*       run_begin = nullptr;
+          mutable char*       run_end   = nullptr;
+          mutable const char* run_name  = nullptr;
       };
 
       template<typename IsClass=fc::true_type>
@@ -356,11 +439,15 @@ namespace fc {
       struct if_enum {
         template<typename Stream, typename T>
         static inline void pack( Stream& s, const T& v ) {
-          fc::reflector<T>::visit( pack_object_visitor<Stream,T>( v, s ) );
+          pack_object_visitor<Stream,T> visitor( v, s );
+          fc::reflector<T>::visit( visitor );
+          visitor.flush();
         }
         template<typename Stream, typename T>
         static inline void unpack( Stream& s, T& v ) {
-          fc::reflector<T>::visit( unpack_object_visitor<Stream,T>( v, s ) );
+          unpack_object_visitor<Stream,T> visitor( v, s );
+          fc::reflector<T>::visit( visitor );
+          visitor.flush();
         }
       };
       template<>
@@ -578,8 +665,13 @@ namespace fc {
     inline void pack( Stream& s, const std::vector<T>& value ) {
       FC_ASSERT( value.size() <= MAX_NUM_ARRAY_ELEMENTS );
       fc::raw::pack( s, unsigned_int((uint32_t)value.size()) );
-      for( const auto& i : value ) {
-         fc::raw::pack( s, i );
+      if constexpr( detail::has_raw_encoding<T>() ) {
+         if( value.size() )
+            s.write( (const char*)value.data(), value.size() * sizeof(T) );
+      } else {
+         for( const auto& i : value ) {
+            fc::raw::pack( s, i );
+         }
       }
     }
 
@@ -588,8 +680,13 @@ namespace fc {
       unsigned_int size; fc::raw::unpack( s, size );
       FC_ASSERT( size.value <= MAX_NUM_ARRAY_ELEMENTS );
       value.resize(size.value);
-      for( auto& i : value ) {
-         fc::raw::unpack( s, i );
+      if constexpr( detail::has_raw_encoding<T>() ) {
+         if( value.size() )
+            s.read( (char*)value.data(), value.size() * sizeof(T) );
+      } else {
+         for( auto& i : value ) {
+            fc::raw::unpack( s, i );
+         }
       }
     }
 
@@ -684,9 +781,13 @@ namespace fc {
     template<typename T>
     inline size_t pack_size(  const T& v )
     {
-      datastream<size_t> ps;
-      fc::raw::pack(ps,v );
-      return ps.tellp();
+      if constexpr( detail::has_raw_encoding<T>() ) {
+         return sizeof(T);
+      } else {
+         datastream<size_t> ps;
+         fc::raw::pack(ps,v );
+         return ps.tellp();
+      }
     }
 
     template<typename T>
@@ -35,6 +35,14 @@ namespace fc {
 
     template<class T>
     concept NotTrivialScalar = !TrivialScalar<T>;
+
+    /**
+     * Opt-in for class types whose raw encoding is exactly their sizeof(T) object bytes, e.g. hashes written
+     * with a single write of the whole object. Reflected structs copy adjacent fields of such types, and of
+     * arithmetic types, with one read or write per run; see detail::has_raw_encoding.
+     */
+    template<typename T>
+    inline constexpr bool has_raw_layout_v = false;
    
     template<typename T>
     inline size_t pack_size(  const T& v );
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fc {
+
+/**
+ * Process-wide latency distribution with lock-free, thread-local recording.
+ *
+ * Durations are recorded in nanoseconds into log-linear buckets in the style of HdrHistogram: values
+ * up to sub_buckets are exact and every power of two above is split into sub_buckets equal buckets,
+ * so a bucket is never wider than 1/sub_buckets of the values it holds. Buckets include their upper
+ * bound, as Prometheus `le` buckets do, so a value equal to a power of two counts towards that bound.
+ * Values above 2^max_exponent nanoseconds (about 18 minutes) land in the last bucket.
+ *
+ * Every thread that records gets its own shard of counters, which only that thread writes; record()
+ * is a thread_local lookup and two relaxed load/store increments with no locked instruction and no
+ * cache line shared with another writer. snapshot() sums the shards and may run concurrently with
+ * recording; it sees each counter either before or after a concurrent increment. Shards of exited
+ * threads keep their counts, so thread pools should be long-lived.
+ *
+ * Histograms register themselves by name in a process-wide list on construction, which is what
+ * exporters such as prometheus_plugin walk. Label values are fixed at construction, so the number of
+ * exported series is the number of histogram objects.
+ */
+class latency_histogram {
+public:
+   static constexpr uint32_t sub_bucket_bits = 3;
+   static constexpr uint32_t sub_buckets     = 1u << sub_bucket_bits;
+   static constexpr uint32_t max_exponent    = 40;
+   static constexpr uint32_t bucket_count    = (max_exponent - sub_bucket_bits + 1) * sub_buckets;
+
+   using labels_type = std::vector<std::pair<std::string, std::string>>;
+
+   struct snapshot_type {
+      std::array<uint64_t, bucket_count> counts{};
+      uint64_t count  = 0;
+      uint64_t sum_ns = 0;
+
+      /// Upper bound in nanoseconds of the bucket holding the q-quantile (0 <= q <= 1), 0 when empty.
+      uint64_t quantile(double q) const;
+      /// Number of recorded values of at most bound_ns; exact when bound_ns is a bucket bound, which
+      /// every power of two is.
+      uint64_t count_at_most(uint64_t bound_ns) const;
+   };
+
+   latency_histogram(std::string name, std::string help, labels_type labels = {});
+   ~latency_histogram();
+
+   latency_histogram(const latency_histogram&) = delete;
+   latency_histogram& operator=(const latency_histogram&) = delete;
+
+   void record(uint64_t ns) {
+      shard& s = local_shard();
+      auto& c = s.counts[bucket_index(ns)];
+      c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      s.sum_ns.store(s.sum_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+   }
+
+   template <typename Rep, typename Period>
+   void record(std::chrono::duration<Rep, Period> d) {
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+      record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+   }
+
+   snapshot_type snapshot() const;
+
+   const std::string& name() const { return name_; }
+   const std::string& help() const { return help_; }
+   const labels_type& labels() const { return labels_; }
+
+   /// Call f on every live histogram, holding the registry lock; f must not construct or destroy one.
+   static void for_each(const std::function<void(const latency_histogram&)>& f);
+
+   /// Bucket i holds (bucket_bound(i), bucket_bound(i + 1)]; bucket 0 also holds 0.
+   static constexpr uint32_t bucket_index(uint64_t ns) {
+      const uint64_t v = ns > 0 ? ns - 1 : 0;
+      if (v < sub_buckets)
+         return static_cast<uint32_t>(v);
+      const uint32_t exponent = std::bit_width(v) - 1;
+      if (exponent >= max_exponent)
+         return bucket_count - 1;
+      const uint32_t shift = exponent - sub_bucket_bits;
+      return (shift + 1) * sub_buckets + static_cast<uint32_t>((v >> shift) - sub_buckets);
+   }
+
+   static constexpr uint64_t bucket_bound(uint32_t i) {
+      if (i < sub_buckets)
+         return i;
+      const uint32_t shift = i / sub_buckets - 1;
+      return (uint64_t{sub_buckets} + i % sub_buckets) << shift;
+   }
+
+   /// Records the time from construction to destruction.
+   class scoped_timer {
+   public:
+      explicit scoped_timer(latency_histogram& h) : h_(h), start_(std::chrono::steady_clock::now()) {}
+      ~scoped_timer() { h_.record(std::chrono::steady_clock::now() - start_); }
+
+      scoped_timer(const scoped_timer&) = delete;
+      scoped_timer& operator=(const scoped_timer&) = delete;
+
+   private:
+      latency_histogram&                    h_;
+      std::chrono::steady_clock::time_point start_;
+   };
+
+private:
+   struct shard {
+      std::array<std::atomic<uint64_t>, bucket_count> counts{};
+      std::atomic<uint64_t>                           sum_ns{0};
+   };
+
+   shard& local_shard() {
+      // indexed by id_; ids are never reused, so entries of destroyed histograms are never read again
+      thread_local std::vector<shard*> shards;
+      if (id_ < shards.size() && shards[id_]) [[likely]]
+         return *shards[id_];
+      return add_shard(shards);
+   }
+
+   shard& add_shard(std::vector<shard*>& thread_shards);
+
+   const size_t                        id_;
+   const std::string                   name_;
+   const std::string                   help_;
+   const labels_type                   labels_;
+   mutable std::mutex                  mtx_;
+   std::vector<std::unique_ptr<shard>> shards_; // guarded by mtx_, append only
+};
+
+} // namespace fc
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace fc {
+
+   /**
+    * Binary framed output for the deep mind tracer, written by a background thread.
+    *
+    * Each record is framed as little-endian
+    *    u32 frame_size                  bytes that follow this field
+    *    u32 text_size, text             event line without the "DMLOG " prefix and the hex payloads
+    *    u32 blob_count
+    *    { u32 blob_size, blob }...      raw packed payloads, in the order the text format prints them as hex
+    * and every stream opened by a writer starts with the 8 byte magic "DMLOGBIN" and a u32 format version.
+    *
+    * write() copies the frame into a preallocated ring and returns; a single writer thread drains all
+    * buffered frames with one write per contiguous range. Only one thread may call write() at a time,
+    * which holds for deep mind since it is emitted by the thread applying blocks.
+    *
+    * When the ring is full, write() either waits for the writer thread (full_policy::block) or discards the
+    * frame (full_policy::drop). Discarded frames are counted and reported in-stream by a "DROPPED <count>"
+    * record preceding the next frame that fits. A frame larger than half the ring is written directly by
+    * the calling thread once the ring has drained, under either policy, so size the ring well above the
+    * largest expected block.
+    *
+    * As with dmlog_sink_mt, a failed write terminates the process with SIGTERM since consumers cannot
+    * recover from a gap in the stream.
+    */
+   class dmlog_binary_writer {
+   public:
+      enum class full_policy { block, drop };
+
+      static constexpr char     magic[8] = {'D', 'M', 'L', 'O', 'G', 'B', 'I', 'N'};
+      static constexpr uint32_t version  = 1;
+
+      /// file "-" or "-stdout" writes to stdout, "-stderr" to stderr, anything else is appended to.
+      /// capacity is rounded up to a power of two.
+      dmlog_binary_writer(const std::string& file, size_t capacity, full_policy policy);
+      /// writes every buffered frame before returning
+      ~dmlog_binary_writer();
+
+      dmlog_binary_writer(const dmlog_binary_writer&) = delete;
+      dmlog_binary_writer& operator=(const dmlog_binary_writer&) = delete;
+
+      void write(std::string_view text, std::initializer_list<std::span<const char>> blobs = {});
+
+      /// frames discarded under full_policy::drop since construction
+      uint64_t dropped() const { return _dropped_total.load(std::memory_order_relaxed); }
+
+   private:
+      static size_t frame_size(std::string_view text, std::initializer_list<std::span<const char>> blobs);
+      bool try_push(std::string_view text, std::initializer_list<std::span<const char>> blobs);
+      void copy_in(uint64_t pos, const char* data, size_t size);
+      void write_fd(const char* data, size_t size);
+      void run();
+
+      const full_policy     _policy;
+      int                   _fd = -1;
+      bool                  _owns_fd = false;
+      std::vector<char>     _ring;
+      uint64_t              _mask = 0;
+      std::atomic<uint64_t> _head{0};   ///< bytes pushed, written by the producer only
+      std::atomic<uint64_t> _tail{0};   ///< bytes written out, written by the writer thread only
+      std::atomic<bool>     _failed{false};
+      uint64_t              _dropped_pending = 0; ///< producer only
+      std::atomic<uint64_t> _dropped_total{0};
+      std::thread           _thread;
+   };
+
+} // namespace fc
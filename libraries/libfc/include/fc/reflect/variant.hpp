@@ -64,6 +64,8 @@ namespace fc
      static inline void to_variant( const T& v, fc::variant& vo ) 
      { 
          mutable_variant_object mvo;
+         if constexpr( fc::reflector<T>::total_member_count > 0 )
+            mvo.reserve( fc::reflector<T>::total_member_count );
          fc::reflector<T>::visit( to_variant_visitor<T>( mvo, v ) );
          vo = std::move(mvo);
      }
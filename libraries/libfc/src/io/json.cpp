@@ -4,13 +4,16 @@
 #include <fc/log/logger.hpp>
 //#include <utfcpp/utf8.h>
 #include <fc/utf8.hpp>
+#include <array>
+#include <bit>
 #include <charconv>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/stream.hpp>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace fc
 {
@@ -24,6 +27,138 @@ namespace fc
     template<typename T, json::parse_type parser_type> variants array_from_stream( T& in, uint32_t max_depth );
     template<typename T, json::parse_type parser_type> variant number_from_stream( T& in );
     template<typename T> variant token_from_stream( T& in );
+
+   namespace detail
+   {
+      constexpr std::array<bool, 256> make_byte_table( bool (*pred)( unsigned ) )
+      {
+         std::array<bool, 256> t{};
+         for( unsigned c = 0; c < t.size(); ++c )
+            t[c] = pred( c );
+         return t;
+      }
+
+      // bytes the string parsers act on: quotes, '\\', ^D, CR, LF and 0xFF (EOF where char is signed)
+      inline constexpr auto string_stop_bytes = make_byte_table( []( unsigned c ) {
+         return c == '"' || c == '\'' || c == '\\' || c == 0x04 || c == '\r' || c == '\n' || c == 0xFF;
+      } );
+
+      // bytes escape_string may rewrite under either escape_control_chars setting
+      inline constexpr auto escape_stop_bytes = make_byte_table( []( unsigned c ) {
+         return c < 0x20 || c == 0x7F || c == '"' || c == '\\';
+      } );
+
+      /// length of the leading run of [begin, end) without any string_stop_bytes
+      inline size_t plain_string_run( const char* const begin, const char* const end )
+      {
+         const char* p = begin;
+#if defined(__SSE2__)
+         const __m128i dq  = _mm_set1_epi8( '"' );
+         const __m128i sq  = _mm_set1_epi8( '\'' );
+         const __m128i bs  = _mm_set1_epi8( '\\' );
+         const __m128i eot = _mm_set1_epi8( 0x04 );
+         const __m128i cr  = _mm_set1_epi8( '\r' );
+         const __m128i lf  = _mm_set1_epi8( '\n' );
+         const __m128i ff  = _mm_set1_epi8( static_cast<char>(0xFF) );
+         for( ; end - p >= 16; p += 16 ) {
+            const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) );
+            const __m128i m = _mm_or_si128( _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, dq ), _mm_cmpeq_epi8( v, sq ) ),
+                                                          _mm_or_si128( _mm_cmpeq_epi8( v, bs ), _mm_cmpeq_epi8( v, eot ) ) ),
+                                            _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, cr ), _mm_cmpeq_epi8( v, lf ) ),
+                                                          _mm_cmpeq_epi8( v, ff ) ) );
+            if( const int bits = _mm_movemask_epi8( m ) )
+               return (p - begin) + std::countr_zero( static_cast<unsigned>(bits) );
+         }
+#endif
+         while( p != end && !string_stop_bytes[static_cast<unsigned char>(*p)] )
+            ++p;
+         return p - begin;
+      }
+
+      /// length of the leading run of [begin, end) without any escape_stop_bytes
+      inline size_t unescaped_run( const char* const begin, const char* const end )
+      {
+         const char* p = begin;
+#if defined(__SSE2__)
+         const __m128i ctrl = _mm_set1_epi8( 0x1F );
+         const __m128i del  = _mm_set1_epi8( 0x7F );
+         const __m128i dq   = _mm_set1_epi8( '"' );
+         const __m128i bs   = _mm_set1_epi8( '\\' );
+         for( ; end - p >= 16; p += 16 ) {
+            const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) );
+            // unsigned v <= 0x1F  <=>  min(v, 0x1F) == v
+            const __m128i m = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( _mm_min_epu8( v, ctrl ), v ), _mm_cmpeq_epi8( v, del ) ),
+                                            _mm_or_si128( _mm_cmpeq_epi8( v, dq ), _mm_cmpeq_epi8( v, bs ) ) );
+            if( const int bits = _mm_movemask_epi8( m ) )
+               return (p - begin) + std::countr_zero( static_cast<unsigned>(bits) );
+         }
+#endif
+         while( p != end && !escape_stop_bytes[static_cast<unsigned char>(*p)] )
+            ++p;
+         return p - begin;
+      }
+
+      /**
+       * Parser input over a contiguous buffer, with the peek()/get()/eof() behavior of the std::istream the parsers
+       * are written against: bytes are returned as unsigned char values, reading at the end returns EOF and sets eof().
+       * Unlike an istream it exposes the unread bytes, which lets string parsing copy runs of plain bytes at once.
+       */
+      class json_buffer_stream
+      {
+         public:
+            json_buffer_stream( const char* data, size_t size ) : _pos( data ), _end( data + size ) {}
+
+            int peek()
+            {
+               if( _pos != _end )
+                  return static_cast<unsigned char>( *_pos );
+               _eof = true;
+               return EOF;
+            }
+
+            int get()
+            {
+               if( _pos != _end )
+                  return static_cast<unsigned char>( *_pos++ );
+               _eof = true;
+               return EOF;
+            }
+
+            bool eof() const { return _eof; }
+
+            /// consumes and returns the plain_string_run at the read position
+            std::string_view take_plain_run()
+            {
+               std::string_view run( _pos, plain_string_run( _pos, _end ) );
+               _pos += run.size();
+               return run;
+            }
+
+         private:
+            const char*       _pos;
+            const char* const _end;
+            bool              _eof = false;
+      };
+   } // namespace detail
+
+   // Appends the run of bytes at the read position that a string parser would copy one at a time, returns its length.
+   // Only json_buffer_stream exposes its buffer; other streams return 0 and are parsed byte by byte.
+   template<typename T> size_t append_plain_run( T&, std::string& ) { return 0; }
+   template<typename T> size_t append_plain_run( T&, std::stringstream& ) { return 0; }
+
+   inline size_t append_plain_run( detail::json_buffer_stream& in, std::string& token )
+   {
+      const auto run = in.take_plain_run();
+      token.append( run );
+      return run.size();
+   }
+
+   inline size_t append_plain_run( detail::json_buffer_stream& in, std::stringstream& token )
+   {
+      const auto run = in.take_plain_run();
+      token.write( run.data(), run.size() );
+      return run.size();
+   }
 }
 
 #include <fc/io/json_relaxed.hpp>
@@ -153,6 +288,8 @@ namespace fc
          in.get();
          while( !in.eof() )
          {
+            if( append_plain_run( in, token ) )
+               continue;
             switch( c = in.peek() )
             {
                case '\\':
@@ -486,8 +623,8 @@ namespace fc
 
    variant json::from_string( const std::string& utf8_str, const json::parse_type ptype, const uint32_t max_depth )
    { try {
-      using stream_t = boost::iostreams::stream<boost::iostreams::array_source>;
-      stream_t in(utf8_str.c_str(), utf8_str.size());
+      using stream_t = detail::json_buffer_stream;
+      stream_t in(utf8_str.data(), utf8_str.size());
       switch( ptype )
       {
           case parse_type::legacy_parser:
@@ -516,10 +653,22 @@ namespace fc
       const auto init_size = str.size();
       const auto start_pos = out.size();
       out.reserve( start_pos + init_size + 13 ); // allow for a few escapes
+      constexpr size_t yield_count = json::escape_string_yield_check_count;
+      const char* const end = str.data() + init_size;
       size_t i = 0;
-      for( auto itr = str.begin(); itr != str.end(); ++i,++itr )
+      for( const char* itr = str.data(); itr != end; ++i,++itr )
       {
-         if( i % json::escape_string_yield_check_count == 0 ) yield( init_size + out.size() );
+         // copy a run needing no escapes at once, yielding with the sizes the bytewise loop would have reported
+         if( const size_t run = detail::unescaped_run( itr, end ) ) {
+            for( size_t y = (i + yield_count - 1) / yield_count * yield_count; y < i + run; y += yield_count )
+               yield( init_size + out.size() + (y - i) );
+            out.append( itr, run );
+            i += run;
+            itr += run;
+            if( itr == end )
+               break;
+         }
+         if( i % yield_count == 0 ) yield( init_size + out.size() );
          switch( *itr )
          {
             case '\x00': out += "\\u0000"; break;
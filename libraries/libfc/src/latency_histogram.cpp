@@ -0,0 +1,90 @@
+#include <fc/latency_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fc {
+
+namespace {
+   struct histogram_registry {
+      std::mutex                       mtx;
+      std::vector<latency_histogram*>  histograms;
+      size_t                           next_id = 0;
+   };
+
+   histogram_registry& registry() {
+      static histogram_registry r;
+      return r;
+   }
+
+   size_t register_histogram(latency_histogram* h) {
+      auto& r = registry();
+      std::lock_guard g(r.mtx);
+      r.histograms.push_back(h);
+      return r.next_id++;
+   }
+}
+
+latency_histogram::latency_histogram(std::string name, std::string help, labels_type labels)
+   : id_(register_histogram(this))
+   , name_(std::move(name))
+   , help_(std::move(help))
+   , labels_(std::move(labels))
+{}
+
+latency_histogram::~latency_histogram() {
+   auto& r = registry();
+   std::lock_guard g(r.mtx);
+   std::erase(r.histograms, this);
+}
+
+latency_histogram::shard& latency_histogram::add_shard(std::vector<shard*>& thread_shards) {
+   std::lock_guard g(mtx_);
+   shard* s = shards_.emplace_back(std::make_unique<shard>()).get();
+   if (thread_shards.size() <= id_)
+      thread_shards.resize(id_ + 1, nullptr);
+   thread_shards[id_] = s;
+   return *s;
+}
+
+latency_histogram::snapshot_type latency_histogram::snapshot() const {
+   snapshot_type ret;
+   std::lock_guard g(mtx_);
+   for (const auto& s : shards_) {
+      for (uint32_t i = 0; i < bucket_count; ++i)
+         ret.counts[i] += s->counts[i].load(std::memory_order_relaxed);
+      ret.sum_ns += s->sum_ns.load(std::memory_order_relaxed);
+   }
+   for (uint64_t c : ret.counts)
+      ret.count += c;
+   return ret;
+}
+
+void latency_histogram::for_each(const std::function<void(const latency_histogram&)>& f) {
+   auto& r = registry();
+   std::lock_guard g(r.mtx);
+   for (const latency_histogram* h : r.histograms)
+      f(*h);
+}
+
+uint64_t latency_histogram::snapshot_type::quantile(double q) const {
+   if (count == 0)
+      return 0;
+   const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)));
+   uint64_t seen = 0;
+   for (uint32_t i = 0; i < bucket_count; ++i) {
+      seen += counts[i];
+      if (seen >= rank)
+         return bucket_bound(i + 1);
+   }
+   return bucket_bound(bucket_count);
+}
+
+uint64_t latency_histogram::snapshot_type::count_at_most(uint64_t bound_ns) const {
+   uint64_t ret = 0;
+   for (uint32_t i = 0; i < bucket_count && bucket_bound(i + 1) <= bound_ns; ++i)
+      ret += counts[i];
+   return ret;
+}
+
+} // namespace fc
@@ -0,0 +1,184 @@
+#include <fc/log/dmlog_binary_writer.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <print>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+namespace fc {
+
+namespace {
+   // set in _head by the destructor; positions never reach 2^63
+   constexpr uint64_t closed_flag = uint64_t{1} << 63;
+
+   std::array<char, 4> little_endian(uint32_t v) {
+      return {static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24)};
+   }
+
+   // put(data, size) is called with consecutive pieces of the frame
+   template <typename Put>
+   void encode_frame(size_t frame_size, std::string_view text, std::initializer_list<std::span<const char>> blobs, Put&& put) {
+      auto put_u32 = [&](size_t v) {
+         const auto bytes = little_endian(static_cast<uint32_t>(v));
+         put(bytes.data(), bytes.size());
+      };
+      put_u32(frame_size - 4);
+      put_u32(text.size());
+      put(text.data(), text.size());
+      put_u32(blobs.size());
+      for (const auto& b : blobs) {
+         put_u32(b.size());
+         put(b.data(), b.size());
+      }
+   }
+}
+
+dmlog_binary_writer::dmlog_binary_writer(const std::string& file, size_t capacity, full_policy policy)
+   : _policy(policy)
+   , _ring(std::bit_ceil(std::max<size_t>(capacity, 4096)))
+   , _mask(_ring.size() - 1)
+{
+   if (file.empty() || file == "-" || file == "-stdout") {
+      _fd = STDOUT_FILENO;
+   } else if (file == "-stderr") {
+      _fd = STDERR_FILENO;
+   } else {
+      _fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+      if (_fd < 0)
+         FC_THROW("Failed to open deep mind binary log file {}: {}", file, strerror(errno));
+      _owns_fd = true;
+   }
+
+   const auto v = little_endian(version);
+   write_fd(magic, sizeof(magic));
+   write_fd(v.data(), v.size());
+
+   _thread = std::thread([this]() { run(); });
+}
+
+dmlog_binary_writer::~dmlog_binary_writer() {
+   _head.fetch_or(closed_flag, std::memory_order_release);
+   _head.notify_one();
+   _thread.join();
+   if (_owns_fd)
+      ::close(_fd);
+}
+
+size_t dmlog_binary_writer::frame_size(std::string_view text, std::initializer_list<std::span<const char>> blobs) {
+   size_t size = 4 + 4 + text.size() + 4;
+   for (const auto& b : blobs)
+      size += 4 + b.size();
+   return size;
+}
+
+void dmlog_binary_writer::copy_in(uint64_t pos, const char* data, size_t size) {
+   const size_t begin = pos & _mask;
+   const size_t first = std::min(size, _ring.size() - begin);
+   memcpy(_ring.data() + begin, data, first);
+   memcpy(_ring.data(), data + first, size - first);
+}
+
+bool dmlog_binary_writer::try_push(std::string_view text, std::initializer_list<std::span<const char>> blobs) {
+   const size_t   size = frame_size(text, blobs);
+   const uint64_t head = _head.load(std::memory_order_relaxed);
+   if (_ring.size() - (head - _tail.load(std::memory_order_acquire)) < size)
+      return false;
+
+   uint64_t pos = head;
+   encode_frame(size, text, blobs, [&](const char* data, size_t n) {
+      copy_in(pos, data, n);
+      pos += n;
+   });
+
+   _head.store(pos, std::memory_order_release);
+   _head.notify_one();
+   return true;
+}
+
+void dmlog_binary_writer::write(std::string_view text, std::initializer_list<std::span<const char>> blobs) {
+   const size_t size = frame_size(text, blobs);
+   auto wait_for_room = [&](size_t needed) {
+      for (uint64_t tail = _tail.load(std::memory_order_acquire);
+           _ring.size() - (_head.load(std::memory_order_relaxed) - tail) < needed;
+           tail = _tail.load(std::memory_order_acquire)) {
+         _tail.wait(tail, std::memory_order_acquire);
+      }
+   };
+   auto push_dropped = [&]() {
+      if (_dropped_pending && try_push("DROPPED " + std::to_string(_dropped_pending), {}))
+         _dropped_pending = 0;
+   };
+
+   if (size > _ring.size() / 2) {
+      // too large to buffer alongside other frames: write it from this thread once the writer is idle
+      wait_for_room(_ring.size());
+      push_dropped();
+      wait_for_room(_ring.size());
+      encode_frame(size, text, blobs, [&](const char* data, size_t n) { write_fd(data, n); });
+      return;
+   }
+
+   push_dropped();
+   if (_dropped_pending || !try_push(text, blobs)) {
+      if (_policy == full_policy::drop) {
+         ++_dropped_pending;
+         _dropped_total.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+      wait_for_room(size);
+      try_push(text, blobs);
+   }
+}
+
+void dmlog_binary_writer::write_fd(const char* data, size_t size) {
+   while (size && !_failed.load(std::memory_order_relaxed)) {
+      const ssize_t written = ::write(_fd, data, size);
+      if (written < 0) {
+         if (errno == EINTR)
+            continue;
+         std::println(stderr, "DMLOG WRITE_FAILED remaining={} {}", size, strerror(errno));
+         std::println(stderr, "DMLOG WRITE_FAILURE_TERMINATED");
+         _failed.store(true, std::memory_order_relaxed);
+         // process targeted signal, SIGTERM may be blocked in this thread
+         kill(getpid(), SIGTERM);
+         return;
+      }
+      data += written;
+      size -= written;
+   }
+}
+
+void dmlog_binary_writer::run() {
+   uint64_t tail = 0;
+   for (;;) {
+      const uint64_t raw  = _head.load(std::memory_order_acquire);
+      const uint64_t head = raw & ~closed_flag;
+      if (head == tail) {
+         if (raw & closed_flag)
+            return;
+         _head.wait(raw, std::memory_order_acquire);
+         continue;
+      }
+
+      // everything buffered so far, in at most two writes; after a failure frames are discarded so that
+      // write() never waits on a writer that stopped
+      const size_t begin = tail & _mask;
+      const size_t size  = head - tail;
+      const size_t first = std::min(size, _ring.size() - begin);
+      write_fd(_ring.data() + begin, first);
+      write_fd(_ring.data(), size - first);
+
+      tail = head;
+      _tail.store(tail, std::memory_order_release);
+      _tail.notify_one();
+   }
+}
+
+} // namespace fc
@@ -6,6 +6,8 @@
 #include <fc/log/logger.hpp>
 #include <fc/exception/exception.hpp>
 
+#include <cstring>
+
 namespace fc {
 
     inline constexpr char hex_digits[] = "0123456789abcdef";
@@ -37,16 +39,32 @@ namespace fc {
    }
 
 
+   // length of the leading ASCII run of str, checked 8 bytes at a time; ASCII is always valid and never in the C1 range
+   static size_t ascii_prefix( const std::string_view& str ) {
+      size_t i = 0;
+      for( ; i + sizeof(uint64_t) <= str.size(); i += sizeof(uint64_t) ) {
+         uint64_t w;
+         std::memcpy( &w, str.data() + i, sizeof(w) );
+         if( w & 0x8080808080808080ull )
+            break;
+      }
+      while( i < str.size() && static_cast<unsigned char>(str[i]) < 0x80 )
+         ++i;
+      return i;
+   }
+
    bool is_valid_utf8( const std::string_view& str ) {
       const auto invalid_range = std::make_pair<uint32_t, uint32_t>(0x80, 0x9F);
-      auto [itr, v] = find_invalid( str.begin(), str.end(), invalid_range );
+      const size_t ascii = ascii_prefix( str );
+      if( ascii == str.size() ) return true;
+      auto [itr, v] = find_invalid( str.begin() + ascii, str.end(), invalid_range );
       return itr == str.end();
    }
 
    // escape 0x80-0x9F C1 control characters
    std::string prune_invalid_utf8( const std::string_view& str ) {
       const auto invalid_range = std::make_pair<uint32_t, uint32_t>(0x80, 0x9F);
-      auto [itr, v] = find_invalid( str.begin(), str.end(), invalid_range );
+      auto [itr, v] = find_invalid( str.begin() + ascii_prefix( str ), str.end(), invalid_range );
       if( itr == str.end() ) return std::string( str );
 
       std::string result;
@@ -3,6 +3,12 @@
 #include <fc/io/json.hpp>
 #include <fc/exception/exception.hpp>
 
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+#include <unistd.h>
+
 using namespace fc;
 
 BOOST_AUTO_TEST_SUITE(json_test_suite)
@@ -306,4 +312,67 @@ BOOST_AUTO_TEST_CASE(parse_escape_lenient_fallback) {
    BOOST_CHECK_EQUAL(parse(R"(\q)"), "q");
 }
 
+// from_string scans string contents in bulk; it must parse exactly like the byte-at-a-time stream path of from_file
+BOOST_AUTO_TEST_CASE(from_string_matches_stream_parsing) {
+   const std::string long_run(100, 'x');
+   const std::vector<std::string> docs = {
+      R"({"a":"b","c":["d",1,-2.5,true,null]})",
+      "\"" + long_run + "\"",
+      "\"" + long_run + R"(\"q\\)" + long_run + R"(\u00e9\n)" + long_run + "\"",
+      "{\"" + long_run + "\":\"" + long_run + "'" + long_run + "\"}",
+      "\"multi\xC3\xA9\xE2\x82\xAC byte " + long_run + "\"",
+      "\"tab\tcr\rlf\n" + long_run + "\"",
+      "\"eot " + long_run + "\x04 after\"",
+      "\"ff " + long_run + "\xFF after\"",
+      "\"unterminated " + long_run,
+      "\"unterminated escape " + long_run + "\\",
+      "'single " + long_run + "\"dq\" end'",
+      "r\"raw " + long_run + "\\n\"",
+      "[\"" + long_run + "\",'" + long_run + "',\"\"]",
+      "'''triple " + long_run + "'''",
+      "{\"k\":\"" + std::string(1000, 'v') + "\"}",
+   };
+
+   const auto file = std::filesystem::temp_directory_path() / ("fc_json_parse_" + std::to_string(::getpid()));
+   for (const auto& doc : docs) {
+      { std::ofstream(file, std::ios::binary) << doc; }
+      for (auto ptype : {json::parse_type::legacy_parser, json::parse_type::legacy_parser_with_string_doubles,
+                         json::parse_type::strict_parser, json::parse_type::relaxed_parser}) {
+         BOOST_TEST_CONTEXT("parser " << static_cast<int>(ptype) << " doc " << doc) {
+            std::optional<std::string> from_string, from_file;
+            std::optional<int64_t> string_error, file_error;
+            try { from_string = json::to_string(json::from_string(doc, ptype), fc::time_point::maximum()); }
+            catch (const fc::exception& e) { string_error = e.code(); }
+            try { from_file = json::to_string(json::from_file(file, ptype), fc::time_point::maximum()); }
+            catch (const fc::exception& e) { file_error = e.code(); }
+            BOOST_CHECK(from_string == from_file);
+            BOOST_CHECK(string_error == file_error);
+         }
+      }
+   }
+   std::filesystem::remove(file);
+}
+
+// escape_string copies unescaped runs in bulk; output and yield points must match escaping one byte at a time
+BOOST_AUTO_TEST_CASE(escape_string_matches_bytewise) {
+   std::string input;
+   for (size_t i = 0; i < 2000; ++i)
+      input += (i % 37 == 0) ? "\"" : (i % 53 == 0) ? "\x01" : (i % 101 == 0) ? "\\" : (i % 97 == 0) ? "\t" : "a";
+
+   for (bool escape_control_chars : {true, false}) {
+      std::string expected;
+      std::vector<size_t> expected_yields;
+      for (size_t i = 0; i < input.size(); ++i) {
+         if (i % json::escape_string_yield_check_count == 0)
+            expected_yields.push_back(input.size() + expected.size());
+         expected += escape_string(input.substr(i, 1), json_test_util::yield_no_limitation, escape_control_chars);
+      }
+
+      std::vector<size_t> yields;
+      const std::string out = escape_string(input, [&](size_t s) { yields.push_back(s); }, escape_control_chars);
+      BOOST_TEST(out == expected);
+      BOOST_TEST(yields == expected_yields);
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
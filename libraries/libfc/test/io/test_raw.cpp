@@ -17,6 +17,63 @@ struct A {
 };
 FC_REFLECT(A, (x)(y)(z))
 
+// reflected out of declaration order, with padding and a non-raw field between raw ones
+struct raw_runs {
+   uint32_t                   a = 0;
+   uint16_t                   b = 0;
+   uint16_t                   c = 0;
+   uint64_t                   d = 0;
+   uint8_t                    e = 0;
+   std::array<uint8_t, 3>     f{};
+   double                     g = 0;
+   std::string                s;
+   uint32_t                   h = 0;
+   uint32_t                   i = 0;
+
+   bool operator==(const raw_runs&) const = default;
+};
+FC_REFLECT(raw_runs, (a)(c)(b)(d)(e)(f)(g)(s)(h)(i))
+
+struct raw_runs_derived : raw_runs {
+   uint32_t                   j = 0;
+   bool                       k = false;
+
+   bool operator==(const raw_runs_derived&) const = default;
+};
+FC_REFLECT_DERIVED(raw_runs_derived, (raw_runs), (j)(k))
+
+struct raw_runs_init : fc::reflect_init {
+   uint32_t                   a = 0;
+   uint32_t                   b = 0;
+   uint64_t                   sum = 0;
+
+   void reflector_init() { sum = uint64_t(a) + b; }
+};
+FC_REFLECT(raw_runs_init, (a)(b))
+
+namespace {
+   raw_runs make_raw_runs(uint32_t n) {
+      return raw_runs{n, uint16_t(n + 1), uint16_t(n + 2), 0x0102030405060708ull * n, uint8_t(n + 3),
+                      {uint8_t(n), uint8_t(n + 4), uint8_t(n + 5)}, n * 1.5, std::string(n % 20, 'x'), n + 6, n + 7};
+   }
+
+   template<typename... T>
+   std::vector<char> pack_each(const T&... fields) {
+      std::vector<char> result;
+      auto append = [&](const auto& f) {
+         const auto p = fc::raw::pack(f);
+         result.insert(result.end(), p.begin(), p.end());
+      };
+      (append(fields), ...);
+      return result;
+   }
+
+   // the encoding reflected structs had before adjacent fields were copied as runs
+   std::vector<char> pack_field_by_field(const raw_runs& r) {
+      return pack_each(r.a, r.c, r.b, r.d, r.e, r.f, r.g, r.s, r.h, r.i);
+   }
+}
+
 BOOST_AUTO_TEST_SUITE(raw_test_suite)
 
 
@@ -335,6 +392,62 @@ BOOST_AUTO_TEST_CASE(packing_list) {
    }
 }
 
+// Adjacent raw fields are copied as one run; the encoding must stay the field by field one
+BOOST_AUTO_TEST_CASE(reflected_raw_runs) {
+   for (uint32_t n : {0u, 1u, 7u, 0xfffffff0u}) {
+      const raw_runs r = make_raw_runs(n);
+      const auto packed = fc::raw::pack(r);
+      BOOST_TEST(packed == pack_field_by_field(r));
+      BOOST_TEST(fc::raw::pack_size(r) == packed.size());
+      BOOST_TEST((fc::raw::unpack<raw_runs>(packed) == r));
+
+      raw_runs_derived d;
+      static_cast<raw_runs&>(d) = r;
+      d.j = n + 8;
+      d.k = true;
+      auto expected = pack_field_by_field(r);
+      const auto tail = pack_each(d.j, d.k);
+      expected.insert(expected.end(), tail.begin(), tail.end());
+      const auto packed_derived = fc::raw::pack(d);
+      BOOST_TEST(packed_derived == expected);
+      BOOST_TEST((fc::raw::unpack<raw_runs_derived>(packed_derived) == d));
+   }
+
+   // a run pending at the end of the fields is read before reflector_init() runs
+   raw_runs_init i;
+   i.a = 40;
+   i.b = 2;
+   const auto packed = fc::raw::pack(i);
+   BOOST_TEST(packed == pack_each(i.a, i.b));
+   BOOST_TEST(fc::raw::unpack<raw_runs_init>(packed).sum == 42u);
+
+   // truncated input still fails instead of reading past the end
+   const auto full = fc::raw::pack(make_raw_runs(3));
+   for (size_t len : {size_t(0), size_t(3), size_t(9), size_t(30), full.size() - 1}) {
+      raw_runs t;
+      datastream<const char*> ds(full.data(), len);
+      BOOST_CHECK_THROW(fc::raw::unpack(ds, t), fc::exception);
+   }
+}
+
+BOOST_AUTO_TEST_CASE(vector_of_raw_elements) {
+   const std::vector<uint32_t> ints = {1, 0x01020304, 0xffffffff};
+   const std::vector<char> expected = pack_each(fc::unsigned_int(3), ints[0], ints[1], ints[2]);
+   BOOST_TEST(fc::raw::pack(ints) == expected);
+   BOOST_TEST((fc::raw::unpack<std::vector<uint32_t>>(expected) == ints));
+
+   const std::vector<std::array<uint16_t, 3>> arrays = {{1, 2, 3}, {4, 5, 6}};
+   const auto packed = fc::raw::pack(arrays);
+   BOOST_TEST(packed.size() == 1 + 2 * 6u);
+   BOOST_TEST((fc::raw::unpack<std::vector<std::array<uint16_t, 3>>>(packed) == arrays));
+   BOOST_TEST(fc::raw::unpack<std::vector<uint32_t>>(fc::raw::pack(std::vector<uint32_t>{})).empty());
+
+   // a size prefix claiming more elements than remain is rejected
+   std::vector<char> truncated = fc::raw::pack(fc::unsigned_int(4));
+   truncated.insert(truncated.end(), expected.begin() + 1, expected.end());
+   BOOST_CHECK_THROW(fc::raw::unpack<std::vector<uint32_t>>(truncated), fc::exception);
+}
+
 // SSO-encoded variants must wire-pack as the legacy string_type so peers running
 // older code (no SSO) can deserialize them.  pack(variant) normalises the SSO tag
 // (13) to string_type (9) on emit; this round-trip locks the invariant.
@@ -0,0 +1,163 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fc/log/dmlog_binary_writer.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct frame {
+   std::string              text;
+   std::vector<std::string> blobs;
+};
+
+struct temp_file {
+   fs::path path = fs::temp_directory_path() / ("fc_dmlog_binary_" + std::to_string(::getpid()) + "_" +
+                                                 std::to_string(reinterpret_cast<uintptr_t>(this)));
+   ~temp_file() { fs::remove(path); }
+};
+
+uint32_t read_u32(const std::string& data, size_t& pos) {
+   BOOST_REQUIRE_LE(pos + 4, data.size());
+   const auto* p = reinterpret_cast<const unsigned char*>(data.data() + pos);
+   pos += 4;
+   return uint32_t{p[0]} | uint32_t{p[1]} << 8 | uint32_t{p[2]} << 16 | uint32_t{p[3]} << 24;
+}
+
+std::string read_bytes(const std::string& data, size_t& pos, size_t n) {
+   BOOST_REQUIRE_LE(pos + n, data.size());
+   std::string ret = data.substr(pos, n);
+   pos += n;
+   return ret;
+}
+
+std::vector<frame> read_frames(const fs::path& file) {
+   std::ifstream in(file, std::ios::binary);
+   const std::string data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+   size_t pos = 0;
+   BOOST_REQUIRE_EQUAL(read_bytes(data, pos, sizeof(fc::dmlog_binary_writer::magic)),
+                       std::string(fc::dmlog_binary_writer::magic, sizeof(fc::dmlog_binary_writer::magic)));
+   BOOST_REQUIRE_EQUAL(read_u32(data, pos), fc::dmlog_binary_writer::version);
+
+   std::vector<frame> frames;
+   while (pos < data.size()) {
+      const uint32_t size = read_u32(data, pos);
+      const size_t   end  = pos + size;
+      frame f;
+      f.text = read_bytes(data, pos, read_u32(data, pos));
+      const uint32_t blobs = read_u32(data, pos);
+      for (uint32_t i = 0; i < blobs; ++i)
+         f.blobs.push_back(read_bytes(data, pos, read_u32(data, pos)));
+      BOOST_REQUIRE_EQUAL(pos, end);
+      frames.push_back(std::move(f));
+   }
+   return frames;
+}
+
+std::span<const char> as_span(const std::string& s) { return {s.data(), s.size()}; }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(dmlog_binary_writer_test)
+
+BOOST_AUTO_TEST_CASE(frames_round_trip) {
+   temp_file file;
+   const std::string block(1000, '\x01');
+   const std::string empty;
+   {
+      fc::dmlog_binary_writer w(file.path.string(), 1 << 16, fc::dmlog_binary_writer::full_policy::block);
+      w.write("START_BLOCK 5");
+      w.write("ACCEPTED_BLOCK_V2 id 5 4", {as_span(block), as_span(empty), as_span("xy")});
+   }
+   const auto frames = read_frames(file.path);
+   BOOST_REQUIRE_EQUAL(frames.size(), 2u);
+   BOOST_TEST(frames[0].text == "START_BLOCK 5");
+   BOOST_TEST(frames[0].blobs.empty());
+   BOOST_TEST(frames[1].text == "ACCEPTED_BLOCK_V2 id 5 4");
+   BOOST_REQUIRE_EQUAL(frames[1].blobs.size(), 3u);
+   BOOST_TEST(frames[1].blobs[0] == block);
+   BOOST_TEST(frames[1].blobs[1].empty());
+   BOOST_TEST(frames[1].blobs[2] == "xy");
+}
+
+// a small ring wraps many times and blocks the producer, yet every frame arrives in order
+BOOST_AUTO_TEST_CASE(block_policy_keeps_every_frame) {
+   temp_file file;
+   constexpr uint32_t count = 20000;
+   {
+      fc::dmlog_binary_writer w(file.path.string(), 4096, fc::dmlog_binary_writer::full_policy::block);
+      for (uint32_t i = 0; i < count; ++i) {
+         const std::string payload(i % 300, static_cast<char>(i));
+         w.write("APPLIED_TRANSACTION " + std::to_string(i), {as_span(payload)});
+      }
+      BOOST_TEST(w.dropped() == 0u);
+   }
+   const auto frames = read_frames(file.path);
+   BOOST_REQUIRE_EQUAL(frames.size(), count);
+   for (uint32_t i = 0; i < count; ++i) {
+      BOOST_REQUIRE_EQUAL(frames[i].text, "APPLIED_TRANSACTION " + std::to_string(i));
+      BOOST_REQUIRE_EQUAL(frames[i].blobs.at(0), std::string(i % 300, static_cast<char>(i)));
+   }
+}
+
+// frames too large for the ring bypass it without reordering
+BOOST_AUTO_TEST_CASE(oversized_frames) {
+   temp_file file;
+   const std::string big(10000, 'b');
+   for (auto policy : {fc::dmlog_binary_writer::full_policy::block, fc::dmlog_binary_writer::full_policy::drop}) {
+      fs::remove(file.path);
+      {
+         fc::dmlog_binary_writer w(file.path.string(), 4096, policy);
+         w.write("a");
+         w.write("big", {as_span(big)});
+         w.write("c");
+      }
+      const auto frames = read_frames(file.path);
+      BOOST_REQUIRE_EQUAL(frames.size(), 3u);
+      BOOST_TEST(frames[0].text == "a");
+      BOOST_TEST(frames[1].blobs.at(0) == big);
+      BOOST_TEST(frames[2].text == "c");
+   }
+}
+
+// dropped frames are counted and announced in-stream; nothing is reordered
+BOOST_AUTO_TEST_CASE(drop_policy_reports_drops) {
+   temp_file file;
+   constexpr uint32_t count = 20000;
+   uint64_t dropped = 0;
+   {
+      fc::dmlog_binary_writer w(file.path.string(), 4096, fc::dmlog_binary_writer::full_policy::drop);
+      const std::string payload(1000, 'p');
+      for (uint32_t i = 0; i < count; ++i)
+         w.write(std::to_string(i), {as_span(payload)});
+      dropped = w.dropped();
+   }
+   const auto frames = read_frames(file.path);
+   uint64_t announced = 0, written = 0;
+   int64_t last = -1;
+   for (const auto& f : frames) {
+      if (f.text.starts_with("DROPPED ")) {
+         announced += std::stoull(f.text.substr(8));
+         continue;
+      }
+      const int64_t i = std::stoll(f.text);
+      BOOST_REQUIRE_GT(i, last);
+      last = i;
+      ++written;
+   }
+   BOOST_TEST(written + dropped == count);
+   // drops after the last written frame have no later frame to announce them
+   BOOST_TEST(announced <= dropped);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
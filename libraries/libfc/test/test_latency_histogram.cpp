@@ -0,0 +1,87 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fc/latency_histogram.hpp>
+
+#include <thread>
+#include <vector>
+
+using fc::latency_histogram;
+
+BOOST_AUTO_TEST_SUITE(latency_histogram_test_suite)
+
+/// Every bucket's bounds map back to it, so the buckets tile the value range without gaps.
+BOOST_AUTO_TEST_CASE(bucket_bounds_round_trip) {
+   BOOST_TEST(latency_histogram::bucket_index(0) == 0u);
+   for (uint32_t i = 0; i + 1 < latency_histogram::bucket_count; ++i) {
+      BOOST_TEST(latency_histogram::bucket_index(latency_histogram::bucket_bound(i) + 1) == i);
+      BOOST_TEST(latency_histogram::bucket_index(latency_histogram::bucket_bound(i + 1)) == i);
+   }
+   BOOST_TEST(latency_histogram::bucket_index(UINT64_MAX) == latency_histogram::bucket_count - 1);
+}
+
+/// A bucket is at most 1/sub_buckets as wide as the values it holds.
+BOOST_AUTO_TEST_CASE(bucket_width_is_bounded) {
+   for (uint32_t i = latency_histogram::sub_buckets; i + 1 < latency_histogram::bucket_count; ++i) {
+      const uint64_t lower = latency_histogram::bucket_bound(i);
+      const uint64_t width = latency_histogram::bucket_bound(i + 1) - lower;
+      BOOST_TEST(width * latency_histogram::sub_buckets <= lower);
+   }
+}
+
+/// Counts recorded from several threads all reach the snapshot.
+BOOST_AUTO_TEST_CASE(records_from_many_threads) {
+   latency_histogram h("test_latency_seconds", "test");
+   constexpr uint64_t per_thread = 10000;
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; ++t)
+      threads.emplace_back([&]() {
+         for (uint64_t v = 1; v <= per_thread; ++v)
+            h.record(v * 1000);
+      });
+   for (auto& t : threads)
+      t.join();
+
+   const auto s = h.snapshot();
+   BOOST_TEST(s.count == 4 * per_thread);
+   BOOST_TEST(s.sum_ns == 4 * 1000 * per_thread * (per_thread + 1) / 2);
+
+   // every value is a whole number of microseconds from 1us to 10ms
+   BOOST_TEST(s.count_at_most(512) == 0u);
+   BOOST_TEST(s.count_at_most(uint64_t{1} << 24) == s.count);
+   const uint64_t median = s.quantile(0.5);
+   BOOST_TEST(median >= 5'000'000u);
+   BOOST_TEST(median <= 5'000'000u + 5'000'000u / latency_histogram::sub_buckets);
+}
+
+/// A value equal to a power of two counts towards that bound, as a Prometheus `le` bucket does.
+BOOST_AUTO_TEST_CASE(bound_is_inclusive) {
+   latency_histogram h("test_bound_seconds", "test");
+   constexpr uint64_t bound = uint64_t{1} << 20;
+   h.record(bound - 1);
+   h.record(bound);
+   h.record(bound + 1);
+
+   const auto s = h.snapshot();
+   BOOST_TEST(s.count_at_most(bound / 2) == 0u);
+   BOOST_TEST(s.count_at_most(bound) == 2u);
+   BOOST_TEST(s.count_at_most(bound * 2) == 3u);
+   BOOST_TEST(s.quantile(0.5) == bound);
+}
+
+/// Exporters find histograms by walking the registry, which drops them on destruction.
+BOOST_AUTO_TEST_CASE(registry_tracks_lifetime) {
+   auto registered = [](const std::string& name) {
+      bool found = false;
+      latency_histogram::for_each([&](const latency_histogram& h) { found |= h.name() == name; });
+      return found;
+   };
+   {
+      latency_histogram h("test_registry_seconds", "test", {{"phase", "one"}});
+      h.record(std::chrono::microseconds(5));
+      BOOST_TEST(registered("test_registry_seconds"));
+      BOOST_TEST(h.labels().size() == 1u);
+   }
+   BOOST_TEST(!registered("test_registry_seconds"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
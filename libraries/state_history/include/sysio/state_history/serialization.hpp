@@ -2,6 +2,7 @@
 
 #include <sysio/chain/account_object.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain/controller.hpp>
 #include <sysio/chain/exceptions.hpp>
 #include <sysio/chain/global_property_object.hpp>
@@ -151,7 +152,7 @@ void history_pack_big_bytes(datastream<ST>& ds, const sysio::chain::bytes& v) {
 }
 
 template <typename ST>
-void history_pack_big_bytes(datastream<ST>& ds, const sysio::chain::shared_blob& b) {
+void history_pack_big_bytes(datastream<ST>& ds, std::string_view b) {
    fc::raw::pack(ds, unsigned_int((uint32_t)b.size()));
    if (b.size())
       ds.write(b.data(), b.size());
@@ -242,7 +243,7 @@ datastream<ST>& operator<<(datastream<ST>& ds, const history_serial_wrapper<sysi
    fc::raw::pack(ds, as_type<uint16_t>(obj.obj.table_id));
    sysio::chain::bytes key_bytes(obj.obj.key.data(), obj.obj.key.data() + obj.obj.key.size());
    history_pack_big_bytes(ds, key_bytes);
-   history_pack_big_bytes(ds, obj.obj.value);
+   history_pack_big_bytes(ds, sysio::chain::kv_value(obj.db, obj.obj));
    return ds;
 }
 
@@ -2,6 +2,7 @@
 #include <sysio/chain/controller.hpp>
 #include <sysio/chain/asset.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain/account_object.hpp>
 #include <sysio/chain/abi_serializer.hpp>
 #include <sysio/chain/contract_action_match.hpp>
@@ -469,7 +470,8 @@ namespace sysio::testing {
                return false;
             }
 
-            fc::raw::unpack(it->value.data(), it->value.size(), obj);
+            const std::string_view value = chain::kv_value(control->db(), *it);
+            fc::raw::unpack(value.data(), value.size(), obj);
             return true;
          }
 
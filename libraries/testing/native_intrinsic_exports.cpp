@@ -388,6 +388,26 @@ void kv_idx_destroy(uint32_t handle) {
    native_context_stack::current()->kv_idx_destroy(handle);
 }
 
+INTRINSIC_EXPORT
+int32_t kv_get_many(uint32_t table_id, uint64_t code, const char* keys, uint32_t keys_len, char* dest, uint32_t dest_len) {
+   return native_context_stack::current()->kv_get_many(table_id, code, aligned_span<const char>{(void*)keys, keys_len}, aligned_span<char>{(void*)dest, dest_len});
+}
+
+INTRINSIC_EXPORT
+int64_t kv_set_many(uint32_t table_id, uint64_t payer, const char* rows, uint32_t rows_len) {
+   return native_context_stack::current()->kv_set_many(table_id, payer, aligned_span<const char>{(void*)rows, rows_len});
+}
+
+INTRINSIC_EXPORT
+int64_t kv_erase_many(uint32_t table_id, const char* keys, uint32_t keys_len) {
+   return native_context_stack::current()->kv_erase_many(table_id, aligned_span<const char>{(void*)keys, keys_len});
+}
+
+INTRINSIC_EXPORT
+int32_t kv_it_read_batch(uint32_t handle, uint32_t max_rows, char* dest, uint32_t dest_len) {
+   return native_context_stack::current()->kv_it_read_batch(handle, max_rows, aligned_span<char>{(void*)dest, dest_len});
+}
+
 // ============================================================================
 // Transaction
 // ============================================================================
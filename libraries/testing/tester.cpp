@@ -5,6 +5,7 @@
 #include <sysio/chain/wast_to_wasm.hpp>
 #include <sysio/chain/sysio_contract.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/testing/bls_utils.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/copy.hpp>
@@ -1217,7 +1218,8 @@ namespace sysio::testing {
       const auto& kv_idx = db.get_index<chain::kv_index, chain::by_code_key>();
       auto kv_itr = kv_idx.find( boost::make_tuple( code, table_id, key.to_string_view() ) );
       if ( kv_itr != kv_idx.end() ) {
-         fc::datastream<const char *> ds(kv_itr->value.data(), kv_itr->value.size());
+         const std::string_view value = kv_value(db, *kv_itr);
+         fc::datastream<const char *> ds(value.data(), value.size());
          fc::raw::unpack(ds, result);
       }
 
@@ -1239,9 +1241,8 @@ namespace sysio::testing {
          auto key = make_kv_scoped_key(scope, id);
          auto kv_itr = kv_idx.find( boost::make_tuple( code, table_id, key.to_string_view() ) );
          if ( kv_itr != kv_idx.end() ) {
-            data.resize( kv_itr->value.size() );
-            if( !data.empty() )
-               memcpy( data.data(), kv_itr->value.data(), data.size() );
+            const std::string_view value = kv_value( db, *kv_itr );
+            data.assign( value.begin(), value.end() );
             return data;
          }
       }
@@ -1253,9 +1254,8 @@ namespace sysio::testing {
          std::string_view key_sv(key_buf, kv_pri_key_size);
          auto kv_itr = kv_idx.find( boost::make_tuple( code, table_id, key_sv ) );
          if ( kv_itr != kv_idx.end() ) {
-            data.resize( kv_itr->value.size() );
-            if( !data.empty() )
-               memcpy( data.data(), kv_itr->value.data(), data.size() );
+            const std::string_view value = kv_value( db, *kv_itr );
+            data.assign( value.begin(), value.end() );
             return data;
          }
       }
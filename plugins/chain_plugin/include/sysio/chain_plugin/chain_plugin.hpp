@@ -13,7 +13,9 @@
 #include <sysio/chain/block.hpp>
 #include <sysio/chain/controller.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain/resource_limits.hpp>
+#include <sysio/chain/state_compaction.hpp>
 #include <sysio/chain/transaction.hpp>
 #include <sysio/chain/abi_serializer.hpp>
 #include <sysio/chain/plugin_interface.hpp>
@@ -569,8 +571,9 @@ public:
          kv_row_view row;
          row.primary_key = chain::kv_decode_be64(kv.data() + chain::kv_scope_prefix_size);
          row.payer = itr->payer;
-         row.value._data = itr->value.data();
-         row.value._size = itr->value.size();
+         const std::string_view value = chain::kv_value(d, *itr);
+         row.value._data = value.data();
+         row.value._size = value.size();
 
          if (!f(row)) break;
          ++itr;
@@ -703,6 +706,8 @@ public:
    const controller& chain() const;
 
    chain::chain_id_type get_chain_id() const;
+   /// Before/after statistics of the state compaction run by compact-state-on-startup, if one ran.
+   std::optional<chain::state_compaction_result> last_state_compaction() const;
    fc::microseconds get_abi_serializer_max_time() const;
    bool api_accept_transactions() const;
    // set true by other plugins if any plugin allows transactions
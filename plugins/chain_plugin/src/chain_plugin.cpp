@@ -11,9 +11,12 @@
 #include <sysio/chain/controller.hpp>
 #include <sysio/chain/contract_action_match.hpp>
 #include <sysio/chain/snapshot.hpp>
+#include <sysio/chain/state_compaction.hpp>
+#include <sysio/chain/streaming_snapshot.hpp>
 #include <sysio/chain/subjective_billing.hpp>
 #include <sysio/chain/deep_mind.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain_plugin/trx_finality_status_processing.hpp>
 #include <sysio/chain/permission_link_object.hpp>
 #include <sysio/chain/global_property_object.hpp>
@@ -32,6 +35,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <fc/io/json.hpp>
+#include <fc/log/dmlog_binary_writer.hpp>
 #include <fc/scoped_exit.hpp>
 #include <fc/variant.hpp>
 #include <fc/network/http/http_client.hpp>
@@ -44,7 +48,9 @@
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string_view>
 
@@ -175,6 +181,70 @@ private:
    uint64_t _previous_downloaded_bytes = 0;
 };
 
+/** Ranged reads of one catalogued snapshot from a snapshot_api_plugin endpoint, for streaming bootstrap. */
+class endpoint_snapshot_range_source : public sysio::chain::snapshot_range_source {
+public:
+   endpoint_snapshot_range_source(fc::url download_url, uint32_t block_num, uint64_t size,
+                                  fc::http::transport_options options)
+      : _download_url(std::move(download_url))
+      , _body(fc::json::to_string(fc::mutable_variant_object()("block_num", block_num), fc::time_point::maximum()))
+      , _size(size)
+      , _options(std::move(options)) {}
+
+   uint64_t size() const override { return _size; }
+
+   void read(uint64_t offset, uint64_t size, char* out) override {
+      // One transport per fetch thread: the blocking adapter must not be re-entered.
+      std::unique_ptr<fc::http::transport> transport;
+      {
+         std::lock_guard g(_mtx);
+         if (!_idle.empty()) {
+            transport = std::move(_idle.back());
+            _idle.pop_back();
+         }
+      }
+      if (!transport)
+         transport = std::make_unique<fc::http::transport>(_options);
+
+      fc::http::request req{
+         .method = fc::http::request_method::post,
+         .target = _download_url,
+         .body = _body,
+         .content_type = "application/json",
+         .user_agent = "wire-libfc-http",
+         .headers = {{"Range", "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1)}},
+      };
+      // Like the whole-file download, the transfer has no read or total deadline; a stalled range
+      // is caught by the idle timeout and retried.
+      fc::http::request_options policy{
+         .max_response_body_bytes = size,
+         .timeouts = {.read = std::nullopt, .total = std::nullopt, .inherit_task_deadline = false},
+         .retry = {.max_attempts = 3},
+         .idempotent = true,
+         .cancel_check = []() { return appbase::app().is_quiting(); },
+      };
+      const auto response = transport->perform(req, policy);
+      SYS_ASSERT(response.status == partial_content_status && response.body.size() == size,
+                 sysio::chain::snapshot_exception,
+                 "Snapshot endpoint answered range {}+{} with status {} and {} bytes",
+                 offset, size, response.status, response.body.size());
+      std::memcpy(out, response.body.data(), size);
+
+      std::lock_guard g(_mtx);
+      _idle.push_back(std::move(transport));
+   }
+
+private:
+   static constexpr uint32_t partial_content_status = 206;
+
+   const fc::url                                     _download_url;
+   const std::string                                 _body;
+   const uint64_t                                    _size;
+   const fc::http::transport_options                 _options;
+   std::mutex                                        _mtx;
+   std::vector<std::unique_ptr<fc::http::transport>> _idle;
+};
+
 } // anonymous namespace
 
 namespace std {
@@ -331,12 +401,15 @@ public:
    std::optional<vm_type>            wasm_runtime;
    fc::microseconds                  abi_serializer_max_time_us;
    std::optional<std::filesystem::path>          snapshot_path;
+   std::optional<chain::state_compaction_result> state_compaction; // set by compact-state-on-startup
 
    // Snapshot attestation verification: set when starting from a snapshot,
    // checked once after syncing past the snapshot block.
    std::optional<uint32_t>    snapshot_loaded_block_num;
    fc::crypto::blake3         snapshot_loaded_root_hash;
    bool                       snapshot_auto_fetched = false; // true when loaded via --snapshot-endpoint
+   // set while a --snapshot-endpoint snapshot is still streaming in; its reader replaces the file reader
+   std::unique_ptr<chain::streaming_snapshot_fetcher> snapshot_stream;
 
    // --native-contract mappings: account -> path to .so
    std::vector<std::pair<chain::name, std::filesystem::path>> native_contracts;
@@ -382,10 +455,13 @@ public:
    void verify_snapshot_attestation(const signed_block_ptr& lib_block);
    /// Download and hash-check a bounded snapshot from a remote provider, leaving snapshot_path
    /// pointing at the downloaded file for the normal snapshot-load path to consume.
+   /// With stream_threads, the snapshot is instead fetched with that many parallel ranged requests
+   /// into snapshot_stream, and loading starts before the download completes.
    void fetch_snapshot_from_endpoint(
       const std::string& endpoint_url,
       const fc::http_file_download_options& download_options,
-      fc::http::transport_options transport_options);
+      fc::http::transport_options transport_options,
+      uint32_t stream_threads);
 
 private:
    static void log_guard_exception(const chain::guard_exception& e);
@@ -464,6 +540,11 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
 #endif
          ("profile-account", boost::program_options::value<vector<string>>()->composing(),
           "The name of an account whose code will be profiled")
+         ("wasm-profile-account", boost::program_options::value<vector<string>>()->composing(),
+          "The name of an account whose actions are sampled by the in-process WASM profiler, see producer_api_plugin get_wasm_profile. "
+          "Supported by the sys-vm-oc and sys-vm-jit runtimes on Linux.")
+         ("wasm-profile-interval-us", bpo::value<uint32_t>()->default_value(1000),
+          "CPU time between two samples of the WASM profiler in microseconds")
          ("abi-serializer-max-time-ms", bpo::value<uint32_t>()->default_value(config::default_abi_serializer_max_time_us / 1000),
           "Override default maximum ABI serialization time allowed in ms")
          ("chain-state-db-size-mb", bpo::value<uint64_t>()->default_value(config::default_state_size / (1024  * 1024)), "Maximum size (in MiB) of the chain state database")
@@ -478,6 +559,15 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
           "print contract's output to console")
          ("deep-mind", bpo::bool_switch()->default_value(false),
           "print deeper information about chain operations")
+         ("deep-mind-binary-file", bpo::value<string>(),
+          "With deep-mind, write binary framed records with raw packed payloads to this file ('-' for stdout) "
+          "from a background thread instead of DMLOG text lines")
+         ("deep-mind-buffer-mb", bpo::value<uint32_t>()->default_value(64),
+          "Size in MiB of the in-memory buffer between block apply and the deep-mind-binary-file writer")
+         ("deep-mind-full-policy", bpo::value<string>()->default_value("block"),
+          "What block apply does when the deep-mind-binary-file buffer is full:\n"
+          "  \"block\" - wait for the writer\n"
+          "  \"drop\" - discard the record; a DROPPED record with the count precedes the next one written")
          ("actor-whitelist", boost::program_options::value<vector<string>>()->composing()->multitoken(),
           "Account added to actor whitelist (may specify multiple times)")
          ("actor-blacklist", boost::program_options::value<vector<string>>()->composing()->multitoken(),
@@ -519,6 +609,16 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
           "In \"locked\" mode database is preloaded, locked in to memory, and will use huge pages if available.\n"
 #endif
          )
+         ("kv-cold-value-threshold", bpo::value<uint32_t>()->default_value(0),
+          "Move KV values of at least this many bytes that no action has written for kv-cold-min-age-blocks blocks out of "
+          "the chain state database into a file in the state directory, read back on access. Node-local, it does not change "
+          "RAM usage, snapshots or the integrity hash. 0 disables spilling.")
+         ("kv-cold-min-age-blocks", bpo::value<uint32_t>()->default_value(config::default_kv_cold_min_age_blocks),
+          "Number of blocks since its last write before a KV value may be moved to the kv cold store file.")
+         ("kv-cold-spills-per-lib", bpo::value<uint32_t>()->default_value(config::default_kv_cold_spills_per_lib),
+          "Maximum number of KV values moved to the kv cold store file each time the last irreversible block advances.")
+         ("kv-cold-max-size-mb", bpo::value<uint64_t>()->default_value(config::default_kv_cold_max_size / (1024 * 1024)),
+          "Maximum size (in MiB) of the kv cold store file.")
 
 #ifdef SYSIO_SYS_VM_OC_RUNTIME_ENABLED
          ("sys-vm-oc-cache-size-mb", bpo::value<uint64_t>()->default_value(sysvmoc::config().cache_size / (1024u*1024u)), "Maximum size (in MiB) of the SYS VM OC code cache")
@@ -554,7 +654,10 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
          ("disable-replay-opts", bpo::bool_switch()->default_value(false),
           "disable optimizations that specifically target replay")
          ("integrity-hash-on-start", bpo::bool_switch(), "Log the state integrity hash on startup")
-         ("integrity-hash-on-stop", bpo::bool_switch(), "Log the state integrity hash on shutdown");
+         ("integrity-hash-on-stop", bpo::bool_switch(), "Log the state integrity hash on shutdown")
+         ("compact-state-on-startup", bpo::bool_switch()->default_value(false),
+          "Before starting, rebuild an existing chain state database into a fresh file, dropping freed buffers held on "
+          "allocator free lists. Needs free disk space for a snapshot and a second state file next to the state directory.");
 
     cfg.add_options()("block-log-retain-blocks", bpo::value<uint32_t>(), "If set to greater than 0, periodically prune the block log to store only configured number of most recent blocks.\n"
         "If set to 0, no blocks are be written to the block log; block log file is removed after startup.");
@@ -595,6 +698,9 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
           "  https://host:port          - fetches latest snapshot\n"
           "  https://host:port/50000    - fetches snapshot at block 50000\n"
           "Requires empty database (use --delete-all-blocks to clear existing data).")
+         ("snapshot-endpoint-stream-threads", bpo::value<uint32_t>()->default_value(0),
+          "Fetch the --snapshot-endpoint snapshot with this many parallel ranged requests and load it while it "
+          "downloads, verifying each section as it arrives. 0 downloads the whole file before loading.")
          ;
       sysio::outbound_http::add_transport_program_options(
          cfg,
@@ -782,8 +888,8 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
       }
 
       protocol_feature_set pfs;
+      std::filesystem::path protocol_features_dir;
       {
-         std::filesystem::path protocol_features_dir;
          auto pfd = options.at( "protocol-features-dir" ).as<std::filesystem::path>();
          if( pfd.is_relative())
             protocol_features_dir = app().config_dir() / pfd;
@@ -815,6 +921,10 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
          wasm_runtime = options.at( "wasm-runtime" ).as<vm_type>();
 
       LOAD_VALUE_SET( options, "profile-account", chain_config->profile_accounts );
+      LOAD_VALUE_SET( options, "wasm-profile-account", chain_config->wasm_profile_accounts );
+      chain_config->wasm_profile_interval = fc::microseconds( options.at( "wasm-profile-interval-us" ).as<uint32_t>() );
+      SYS_ASSERT( chain_config->wasm_profile_interval.count() > 0, plugin_config_exception,
+                  "wasm-profile-interval-us must be greater than 0" );
 
       if( options.count( "native-contract" )) {
          const auto& nc_opts = options["native-contract"].as<std::vector<std::string>>();
@@ -853,6 +963,11 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
       if( options.contains( "chain-state-db-guard-size-mb" ))
          chain_config->state_guard_size = options.at( "chain-state-db-guard-size-mb" ).as<uint64_t>() * 1024 * 1024;
 
+      chain_config->kv_cold.value_threshold = options.at( "kv-cold-value-threshold" ).as<uint32_t>();
+      chain_config->kv_cold.min_age_blocks  = options.at( "kv-cold-min-age-blocks" ).as<uint32_t>();
+      chain_config->kv_cold.spills_per_lib  = options.at( "kv-cold-spills-per-lib" ).as<uint32_t>();
+      chain_config->kv_cold.max_size        = options.at( "kv-cold-max-size-mb" ).as<uint64_t>() * 1024 * 1024;
+
       if( options.contains( "transaction-finality-status-max-storage-size-gb" )) {
          const uint64_t max_storage_size = options.at( "transaction-finality-status-max-storage-size-gb" ).as<uint64_t>() * 1024 * 1024 * 1024;
          if (max_storage_size > 0) {
@@ -1020,7 +1135,8 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
             fetch_snapshot_from_endpoint(
                options.at("snapshot-endpoint").as<std::string>(),
                download_options,
-               std::move(transport_options));
+               std::move(transport_options),
+               options.at("snapshot-endpoint-stream-threads").as<uint32_t>());
          } catch (...) {
             if (app().is_quiting()) {
                SYS_THROW(chain::interrupt_exception, "Snapshot endpoint bootstrap interrupted");
@@ -1040,9 +1156,13 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
 
          // recover genesis information from the snapshot
          // used for validation code below; load_index() is cheap (no hash verification)
-         threaded_snapshot_reader reader(*snapshot_path);
-         reader.load_index();
-         chain_id = controller::extract_chain_id(reader);
+         if (snapshot_stream) {
+            chain_id = controller::extract_chain_id(*snapshot_stream->reader());
+         } else {
+            threaded_snapshot_reader reader(*snapshot_path);
+            reader.load_index();
+            chain_id = controller::extract_chain_id(reader);
+         }
 
          SYS_ASSERT(
            !options.contains( "genesis-timestamp" ),
@@ -1223,6 +1343,16 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
       chain_config->integrity_hash_on_start = options.at("integrity-hash-on-start").as<bool>();
       chain_config->integrity_hash_on_stop = options.at("integrity-hash-on-stop").as<bool>();
 
+      if( options.at( "compact-state-on-startup" ).as<bool>() ) {
+         // a snapshot or replay start already builds a fresh state database
+         if( readonly ) {
+            wlog( "compact-state-on-startup ignored in read-only mode" );
+         } else if( !snapshot_path && std::filesystem::is_regular_file( chain_config->state_dir / "shared_memory.bin" ) ) {
+            ilog( "Compacting chain state database in {}", chain_config->state_dir.generic_string() );
+            state_compaction = compact_chain_state( *chain_config, protocol_features_dir, *chain_id );
+         }
+      }
+
       // Native debug mode: operate on copied state to protect originals
       if( !native_contracts.empty() ) {
          namespace fs = std::filesystem;
@@ -1323,6 +1453,15 @@ void chain_plugin_impl::plugin_initialize(const variables_map& options) {
             "p2p-accept-transactions must be set to false in order to enable deep-mind logging.");
 
          _deep_mind_log.update_logger( deep_mind_logger_name );
+         if( options.contains( "deep-mind-binary-file" ) ) {
+            const auto& policy = options.at( "deep-mind-full-policy" ).as<string>();
+            SYS_ASSERT( policy == "block" || policy == "drop", plugin_config_exception,
+                        "deep-mind-full-policy must be block or drop, not {}", policy );
+            _deep_mind_log.update_binary_writer( std::make_shared<fc::dmlog_binary_writer>(
+               options.at( "deep-mind-binary-file" ).as<string>(),
+               size_t{options.at( "deep-mind-buffer-mb" ).as<uint32_t>()} * 1024 * 1024,
+               policy == "drop" ? fc::dmlog_binary_writer::full_policy::drop : fc::dmlog_binary_writer::full_policy::block ) );
+         }
          chain->enable_deep_mind( &_deep_mind_log );
       }
 
@@ -1449,8 +1588,16 @@ void chain_plugin_impl::plugin_startup()
       };
       auto check_shutdown = [](){ return app().is_quiting(); };
       if (snapshot_path) {
-         auto snapshot_reader = std::make_shared<threaded_snapshot_reader>(*snapshot_path);
+         auto snapshot_reader = snapshot_stream ? snapshot_stream->reader()
+                                                : std::make_shared<threaded_snapshot_reader>(*snapshot_path);
          chain->startup(shutdown, check_shutdown, snapshot_reader);
+         if (snapshot_stream) {
+            // sections the controller does not read are still arriving; keep the file complete
+            snapshot_stream->wait_all();
+            ilog("Streamed snapshot download complete: {} bytes at {}",
+                 snapshot_stream->fetched_bytes(), snapshot_stream->path().string());
+            snapshot_stream.reset();
+         }
          snapshot_loaded_block_num = chain->head().block_num();
          snapshot_loaded_root_hash = snapshot_reader->get_root_hash();
          ilog("Snapshot loaded at block #{} with root hash {}, will verify attestation after sync",
@@ -1668,6 +1815,10 @@ void chain_plugin::accept_transaction(const chain::packed_transaction_ptr& trx,
 controller& chain_plugin::chain() { return *my->chain; }
 const controller& chain_plugin::chain() const { return *my->chain; }
 
+std::optional<chain::state_compaction_result> chain_plugin::last_state_compaction() const {
+   return my->state_compaction;
+}
+
 chain::chain_id_type chain_plugin::get_chain_id()const {
    return my->chain->get_chain_id();
 }
@@ -1687,7 +1838,8 @@ bool chain_plugin::accept_transactions() const {
 void chain_plugin_impl::fetch_snapshot_from_endpoint(
    const std::string& endpoint_url,
    const fc::http_file_download_options& download_options,
-   fc::http::transport_options transport_options) {
+   fc::http::transport_options transport_options,
+   uint32_t stream_threads) {
    // Check for existing chain data
    auto shared_mem_path = chain_config->state_dir / "shared_memory.bin";
    auto chain_head_path = chain_config->state_dir / chain_head_filename;
@@ -1718,7 +1870,7 @@ void chain_plugin_impl::fetch_snapshot_from_endpoint(
    ilog("Fetching snapshot metadata from endpoint: {}",
         fc::http::sanitized_endpoint(fc::url(base_url)));
 
-   fc::http_client http_client(std::move(transport_options));
+   fc::http_client http_client(transport_options);
    http_client.set_cancel_check([]() { return app().is_quiting(); });
    fc::variant metadata_response;
    if (request_block_num) {
@@ -1744,6 +1896,31 @@ void chain_plugin_impl::fetch_snapshot_from_endpoint(
 
    auto download_dest = snapshots_dir / ("snapshot-bootstrap-" + std::to_string(snap_block_num) + ".bin");
 
+   // providers predating streaming bootstrap do not report the file size
+   const auto& metadata_object = metadata_response.get_object();
+   const uint64_t snap_file_size = metadata_object.contains("file_size") ? metadata_object["file_size"].as_uint64() : 0;
+   if (stream_threads && !snap_file_size) {
+      wlog("Snapshot endpoint does not report the snapshot file size; downloading the whole file before loading");
+   } else if (stream_threads) {
+      SYS_ASSERT(snap_file_size <= download_options.max_response_body_bytes, plugin_config_exception,
+                 "Snapshot of {} bytes exceeds the {} byte download limit", snap_file_size,
+                 download_options.max_response_body_bytes);
+      ilog("Streaming snapshot for block #{} ({} bytes) to {} with {} parallel requests",
+           snap_block_num, snap_file_size, download_dest.string(), stream_threads);
+      auto source = std::make_shared<endpoint_snapshot_range_source>(
+         fc::url(base_url + "/v1/snapshot/download"), snap_block_num, snap_file_size, std::move(transport_options));
+      snapshot_stream = std::make_unique<chain::streaming_snapshot_fetcher>(
+         std::move(source), download_dest, snap_root_hash, stream_threads);
+      // verifies the section index against the advertised root hash; every section is verified
+      // against the index as it arrives, before the loader reads it
+      snapshot_stream->start();
+
+      snapshot_path = download_dest;
+      snapshot_auto_fetched = true;
+      snapshot_loaded_root_hash = snap_root_hash;
+      return;
+   }
+
    // Download the snapshot
    ilog("Downloading snapshot for block #{} to {}", snap_block_num, download_dest.string());
    {
@@ -2480,7 +2657,8 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
          raw_row r;
          r.key = std::move(full_key);
          if (itr != pri_idx.end()) {
-            r.value.assign(itr->value.data(), itr->value.data() + itr->value.size());
+            const std::string_view value = chain::kv_value(d, *itr);
+            r.value.assign(value.begin(), value.end());
             r.payer = itr->payer;
          }
          return r;
@@ -2684,7 +2862,8 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
 
          raw_row row;
          row.key.assign(kv.data(), kv.data() + kv.size());
-         row.value.assign(itr->value.data(), itr->value.data() + itr->value.size());
+         const std::string_view value = chain::kv_value(d, *itr);
+         row.value.assign(value.begin(), value.end());
          row.payer = itr->payer;
          hp.rows.emplace_back(std::move(row));
 
@@ -2740,7 +2919,8 @@ read_only::get_table_rows( const read_only::get_table_rows_params& p, const fc::
 
             raw_row row;
             row.key.assign(kv.data(), kv.data() + kv.size());
-            row.value.assign(itr->value.data(), itr->value.data() + itr->value.size());
+            const std::string_view value = chain::kv_value(d, *itr);
+            row.value.assign(value.begin(), value.end());
             row.payer = itr->payer;
             hp.rows.emplace_back(std::move(row));
             last_added_itr = itr;
@@ -3138,10 +3318,11 @@ vector<asset> read_only::get_currency_balance( const read_only::get_currency_bal
       if (kv.size() != chain::kv_scoped_key_size ||
           memcmp(kv.data(), scope_prefix, chain::kv_scope_prefix_size) != 0) break;
 
-      SYS_ASSERT(itr->value.size() >= sizeof(asset), chain::asset_type_exception, "Invalid data on table");
+      const std::string_view value = chain::kv_value(d, *itr);
+      SYS_ASSERT(value.size() >= sizeof(asset), chain::asset_type_exception, "Invalid data on table");
 
       asset cursor;
-      fc::datastream<const char*> ds(itr->value.data(), itr->value.size());
+      fc::datastream<const char*> ds(value.data(), value.size());
       fc::raw::unpack(ds, cursor);
 
       SYS_ASSERT(cursor.get_symbol().valid(), chain::asset_type_exception, "Invalid asset");
@@ -3193,7 +3374,8 @@ fc::variant get_global_row( const database& db, const abi_def& abi, const abi_se
    auto it = kv_idx.find(boost::make_tuple(config::system_account_name, global_tid, key_sv));
    SYS_ASSERT(it != kv_idx.end(), chain::contract_table_query_exception, "Missing row in table global");
 
-   vector<char> data(it->value.data(), it->value.data() + it->value.size());
+   const std::string_view value = chain::kv_value(db, *it);
+   vector<char> data(value.begin(), value.end());
    return abis.binary_to_variant(abis.get_table_type("global"), data, abi_serializer::create_yield_function( abi_serializer_max_time_us ), shorten_abi_errors );
 }
 
@@ -3840,9 +4022,10 @@ read_only::get_account_return_t read_only::get_account( const get_account_params
          const uint16_t accounts_tid = chain::compute_table_id("accounts"_n.to_uint64_t());
          const auto& kv_idx = d.get_index<chain::kv_index, chain::by_code_key>();
          auto it = kv_idx.find(boost::make_tuple(token_code, accounts_tid, key_sv));
-         if (it != kv_idx.end() && it->value.size() >= sizeof(asset)) {
+         const std::string_view value = it != kv_idx.end() ? chain::kv_value(d, *it) : std::string_view{};
+         if (value.size() >= sizeof(asset)) {
             asset bal;
-            fc::datastream<const char*> ds(it->value.data(), it->value.size());
+            fc::datastream<const char*> ds(value.data(), value.size());
             fc::raw::unpack(ds, bal);
             if (bal.get_symbol().valid() && bal.get_symbol() == core_symbol)
                result.core_liquid_balance = bal;
@@ -3859,7 +4042,8 @@ read_only::get_account_return_t read_only::get_account( const get_account_params
          const auto& kv_idx = d.get_index<chain::kv_index, chain::by_code_key>();
          auto it = kv_idx.find(boost::make_tuple(config::roa_account_name, tid, key_sv));
          if (it != kv_idx.end()) {
-            return vector<char>(it->value.data(), it->value.data() + it->value.size());
+            const std::string_view value = chain::kv_value(d, *it);
+            return vector<char>(value.begin(), value.end());
          }
          return {};
       };
@@ -3962,8 +4146,8 @@ chain::symbol read_only::extract_core_symbol()const {
    if (itr != kv_idx.end() && itr->code == "sysio.token"_n && itr->table_id == stat_tid) {
       auto kv = itr->key_view();
       if (kv.size() == chain::kv_scoped_key_size) {
-         vector<char> data(itr->value.data(), itr->value.data() + itr->value.size());
-         fc::datastream<const char*> ds(data.data(), data.size());
+         const std::string_view value = chain::kv_value(d, *itr);
+         fc::datastream<const char*> ds(value.data(), value.size());
          read_only::get_currency_stats_result result;
          fc::raw::unpack(ds, result.supply);
          fc::raw::unpack(ds, result.max_supply);
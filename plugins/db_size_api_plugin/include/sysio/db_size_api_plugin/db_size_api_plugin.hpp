@@ -19,7 +19,10 @@ struct db_size_stats {
    uint64_t                    used_bytes = 0;
    uint64_t                    reclaimable_bytes = 0;
    uint64_t                    size = 0;
+   double                      fragmentation = 0; ///< reclaimable share of used bytes
    vector<db_size_index_count> indices;
+   std::optional<chain::state_compaction_result> last_compaction; ///< set when compact-state-on-startup ran
+   std::optional<chain::kv_cold_stats>           kv_cold;         ///< set when the kv cold store file is open
 };
 
 class db_size_api_plugin : public plugin<db_size_api_plugin> {
@@ -46,4 +49,4 @@ private:
 }
 
 FC_REFLECT( sysio::db_size_index_count, (index)(row_count) )
-FC_REFLECT( sysio::db_size_stats, (free_bytes)(used_bytes)(reclaimable_bytes)(size)(indices) )
+FC_REFLECT( sysio::db_size_stats, (free_bytes)(used_bytes)(reclaimable_bytes)(size)(fragmentation)(indices)(last_compaction)(kv_cold) )
@@ -31,13 +31,19 @@ void db_size_api_plugin::plugin_startup() {
 }
 
 db_size_stats db_size_api_plugin::get() {
-   const chainbase::database& db = app().get_plugin<chain_plugin>().chain().db();
+   const auto& chain_plug = app().get_plugin<chain_plugin>();
+   const chainbase::database& db = chain_plug.chain().db();
    db_size_stats ret;
 
-   ret.free_bytes = db.get_segment_manager()->get_free_memory();
-   ret.size = db.get_segment_manager()->get_size();
-   ret.used_bytes = ret.size - ret.free_bytes;
-   ret.reclaimable_bytes = db.get_reclaimable_memory();
+   const auto stats = chain::chain_state_stats::from_db(db);
+   ret.free_bytes = stats.free_bytes;
+   ret.size = stats.size;
+   ret.used_bytes = stats.used_bytes;
+   ret.reclaimable_bytes = stats.reclaimable_bytes;
+   ret.fragmentation = stats.fragmentation();
+   ret.last_compaction = chain_plug.last_state_compaction();
+   if (const auto* kv_cold = chain::kv_cold_store::find(db))
+      ret.kv_cold = kv_cold->stats();
 
    chainbase::database::database_index_row_count_multiset indices = db.row_count_per_index();
    for(const auto& i : indices)
@@ -4,6 +4,7 @@
 #include <sysio/http_plugin/http_plugin.hpp>
 
 #include <fc/io/raw.hpp>
+#include <fc/latency_histogram.hpp>
 #include <fc/log/logger_config.hpp>
 #include <fc/time.hpp>
 #include <fc/utility.hpp>
@@ -29,6 +30,7 @@
 #include <boost/asio/detail/config.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <map>
 #include <optional>
@@ -93,7 +95,18 @@ struct internal_url_handler {
    internal_url_handler_fn fn;
    api_category category;
    http_content_type content_type = http_content_type::json;
+   std::shared_ptr<fc::latency_histogram> latency; // request to response time, null for raw handlers
 };
+
+/**
+* One latency histogram per registered url, so the exported label cardinality is bounded by the
+* number of registered APIs rather than by request targets.
+*/
+inline std::shared_ptr<fc::latency_histogram> make_url_latency_histogram(const string& path) {
+   return std::make_shared<fc::latency_histogram>("nodeop_http_request_duration_seconds",
+                                                  "time from receiving an HTTP request to sending its response",
+                                                  fc::latency_histogram::labels_type{{"handler", path}});
+}
 /**
 * Helper method to calculate the "in flight" size of a fc::variant
 * This is an estimate based on fc::raw::pack if that process can be successfully executed
@@ -169,18 +182,26 @@ struct http_plugin_state {
 *
 * @param plugin_state - plugin state object, shared state of http_plugin
 * @param session_ptr - beast_http_session object on which to invoke send_response
+* @param latency - optional histogram recording the time from this call until the response is sent
 * @return lambda suitable for url_response_callback
 */
-inline auto make_http_response_handler(http_plugin_state& plugin_state, detail::abstract_conn_ptr session_ptr, http_content_type content_type) {
+inline auto make_http_response_handler(http_plugin_state& plugin_state, detail::abstract_conn_ptr session_ptr, http_content_type content_type,
+                                       std::shared_ptr<fc::latency_histogram> latency = {}) {
    return [&plugin_state,
-           session_ptr{std::move(session_ptr)}, content_type](int code, std::optional<fc::variant> response) mutable {
+           session_ptr{std::move(session_ptr)}, content_type,
+           latency{std::move(latency)}, start = std::chrono::steady_clock::now()](int code, std::optional<fc::variant> response) mutable {
       auto payload_size = detail::in_flight_sizeof(response);
       plugin_state.bytes_in_flight += payload_size;
 
       // post back to an HTTP thread to allow the response handler to be called from any thread
       boost::asio::dispatch(plugin_state.thread_pool.get_executor(),
-                        [&plugin_state, session_ptr{std::move(session_ptr)}, code, payload_size, response = std::move(response), content_type]() {
-                           auto on_exit = fc::make_scoped_exit([&](){plugin_state.bytes_in_flight -= payload_size;});
+                        [&plugin_state, session_ptr{std::move(session_ptr)}, code, payload_size, response = std::move(response), content_type,
+                         latency{std::move(latency)}, start]() {
+                           auto on_exit = fc::make_scoped_exit([&](){
+                              plugin_state.bytes_in_flight -= payload_size;
+                              if (latency)
+                                 latency->record(std::chrono::steady_clock::now() - start);
+                           });
 
                            if(auto error_str = session_ptr->verify_max_bytes_in_flight(0); !error_str.empty()) {
                               session_ptr->send_busy_response(std::move(error_str));
@@ -565,14 +565,18 @@ namespace sysio {
    void http_plugin::add_handler(api_entry&& entry, appbase::exec_queue q, int priority, http_content_type content_type) {
       log_add_handler(my.get(), entry);
       std::string path  = entry.path;
-      auto p = my->plugin_state->url_handlers.emplace(path, my->make_app_thread_url_handler(std::move(entry), q, priority, content_type));
+      auto handler = my->make_app_thread_url_handler(std::move(entry), q, priority, content_type);
+      handler.latency = detail::make_url_latency_histogram(path);
+      auto p = my->plugin_state->url_handlers.emplace(path, std::move(handler));
       SYS_ASSERT( p.second, chain::plugin_config_exception, "http url {} is not unique", path );
    }
 
    void http_plugin::add_async_handler(api_entry&& entry, http_content_type content_type) {
       log_add_handler(my.get(), entry);
       std::string path  = entry.path;
-      auto p = my->plugin_state->url_handlers.emplace(path, my->make_http_thread_url_handler(std::move(entry), content_type));
+      auto handler = my->make_http_thread_url_handler(std::move(entry), content_type);
+      handler.latency = detail::make_url_latency_histogram(path);
+      auto p = my->plugin_state->url_handlers.emplace(path, std::move(handler));
       SYS_ASSERT( p.second, chain::plugin_config_exception, "http url {} is not unique", path );
    }
 
@@ -11,6 +11,9 @@
 namespace sysio {
 
    using send_buffer_type = std::shared_ptr<std::vector<char>>;
+   /// Already serialized message body owned elsewhere (a block's retained wire bytes, a block read from the block log).
+   /// Queued and written after its send_buffer_type frame header instead of being copied into it.
+   using send_body_type = std::shared_ptr<const std::vector<char>>;
 
    struct buffer_factory {
 
@@ -58,62 +61,93 @@ namespace sysio {
          return send_buffer;
       }
 
-      static send_buffer_type create_send_buffer_from_serialized_block( const std::vector<char>& v ) {
+      /// frame header [size][which] of a signed_block message whose serialized block of block_size bytes follows
+      static send_buffer_type create_serialized_block_header( size_t block_size ) {
          constexpr uint32_t signed_block_which = to_index(msg_type_t::signed_block);
 
          // match net_message static_variant pack
          const uint32_t which_size = fc::raw::pack_size( unsigned_int( signed_block_which ) );
-         const uint32_t payload_size = which_size + v.size();
+         const uint32_t payload_size = which_size + block_size;
 
          const char* const header = reinterpret_cast<const char* const>(&payload_size); // avoid variable size encoding of uint32_t
-         const size_t buffer_size = message_header_size + payload_size;
+         const size_t buffer_size = message_header_size + which_size;
 
          auto send_buffer = std::make_shared<vector<char>>( buffer_size );
          fc::datastream<char*> ds( send_buffer->data(), buffer_size );
          ds.write( header, message_header_size );
          fc::raw::pack( ds, unsigned_int( signed_block_which ) );
-         ds.write( v.data(), v.size() );
 
          return send_buffer;
       }
 
    };
 
+   /// Blocks are sent as a small frame header followed by the serialized block itself, so relaying a received
+   /// block or serving one from the block log never copies or repacks the block bytes.
    struct block_buffer_factory : public buffer_factory {
 
       /// caches result for subsequent calls, only provide same signed_block_ptr instance for each invocation.
+      /// Returns the frame header; the block's retained wire bytes are available from get_send_body().
       const send_buffer_type& get_send_buffer( const signed_block_ptr& sb ) {
          if( !send_buffer ) {
-            send_buffer = create_send_buffer( sb );
+            fc_dlog( p2p_blk_log, "sending block {}", sb->block_num() );
+            // aliases sb: the queued body keeps the block alive until written
+            send_body = send_body_type( sb, &sb->packed_signed_block() );
+            send_buffer = create_serialized_block_header( send_body->size() );
          }
          return send_buffer;
       }
 
-      const send_buffer_type& get_send_buffer( const std::vector<char>& sb ) {
+      /// caches result for subsequent calls, takes ownership of ssb (serialized signed block) without copying it.
+      /// Returns the frame header; the block bytes are available from get_send_body().
+      const send_buffer_type& get_send_buffer( std::vector<char>&& ssb ) {
          if( !send_buffer ) {
-            send_buffer = create_send_buffer( sb );
+            send_body = std::make_shared<const std::vector<char>>( std::move(ssb) );
+            send_buffer = create_serialized_block_header( send_body->size() );
          }
          return send_buffer;
       }
 
-   private:
+      /// serialized block to send after the header, only valid after get_send_buffer called
+      const send_body_type& get_send_body() const { return send_body; }
 
-      static send_buffer_type create_send_buffer( const signed_block_ptr& sb ) {
-         // this implementation is to avoid copy of signed_block to net_message
-         // matches which of net_message for signed_block
-         fc_dlog( p2p_blk_log, "sending block {}", sb->block_num() );
-         return buffer_factory::create_send_buffer_from_serialized_block(sb->packed_signed_block());
-      }
+      /// total bytes on the wire, header plus block, only valid after get_send_buffer called
+      size_t send_size() const { return send_buffer->size() + send_body->size(); }
 
-      static send_buffer_type create_send_buffer( const std::vector<char>& ssb ) { // ssb: serialized signed block
-         // this implementation is to avoid copy of signed_block to net_message
-         // matches which of net_message for signed_block
-         return buffer_factory::create_send_buffer_from_serialized_block( ssb );
-      }
+   private:
+      send_body_type send_body;
    };
 
    struct trx_buffer_factory : public buffer_factory {
 
+      trx_buffer_factory() = default;
+
+      /// use the already framed wire bytes of a transaction_message received from a peer, see create_received_send_buffer()
+      explicit trx_buffer_factory( send_buffer_type received ) {
+         send_buffer = std::move( received );
+      }
+
+      /// Frame for relaying a received transaction_message as-is: [size][which][trx_id] is written here and the
+      /// caller fills the trailing body_size bytes of packed_transaction with the bytes read off the wire.
+      static send_buffer_type create_received_send_buffer( const transaction_id_type& id, uint32_t body_size ) {
+         constexpr uint32_t transaction_message_which = to_index(msg_type_t::transaction_message);
+
+         const uint32_t which_size = fc::raw::pack_size( unsigned_int( transaction_message_which ) );
+         const uint32_t id_size = fc::raw::pack_size( id );
+         const uint32_t payload_size = which_size + id_size + body_size;
+
+         const char* const header = reinterpret_cast<const char* const>(&payload_size);
+         const size_t buffer_size = message_header_size + payload_size;
+
+         auto send_buffer = std::make_shared<vector<char>>( buffer_size );
+         fc::datastream<char*> ds( send_buffer->data(), buffer_size );
+         ds.write( header, message_header_size );
+         fc::raw::pack( ds, unsigned_int( transaction_message_which ) );
+         fc::raw::pack( ds, id );
+
+         return send_buffer;
+      }
+
       /// caches result for subsequent calls, only provide same packed_transaction_ptr instance for each invocation.
       const send_buffer_type& get_send_buffer( const packed_transaction_ptr& trx ) {
          if( !send_buffer ) {
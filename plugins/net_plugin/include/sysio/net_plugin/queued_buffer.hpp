@@ -42,6 +42,7 @@ namespace sysio {
          _block_wq.clear();
          _sync_wq.clear();
          _trx_wq.clear();
+         _trx_wq_size = 0;
          _wq_size.store(0, std::memory_order_relaxed);
          _write_drain_pending.store(false, std::memory_order_relaxed);
       }
@@ -61,6 +62,14 @@ namespace sysio {
          _write_drain_pending.store(false, std::memory_order_release);
       }
 
+      // Returns true if caller should arm the trx batch timer; false if a trx batch is already waiting on it.
+      bool try_claim_trx_batch() {
+         return !_trx_batch_pending.exchange(true, std::memory_order_acq_rel);
+      }
+      void release_trx_batch() {
+         _trx_batch_pending.store(false, std::memory_order_release);
+      }
+
       // called from connection strand
       bool ready_to_send(connection_id_t connection_id) const {
          fc::unique_lock g( _mtx );
@@ -75,25 +84,28 @@ namespace sysio {
       }
 
       enum class queue_t { block_sync, general };
-      struct add_result { bool ok; bool needs_drain; };
+      struct add_result { bool ok; bool needs_drain; uint32_t trx_queue_size; };
       add_result add_write_queue(msg_type_t net_msg,
                                  queue_t queue,
                                  const send_buffer_type& buff,
                                  connection_id_t conn_id,
                                  go_away_reason close_after_send,
-                                 std::optional<block_num_type> block_num) {
+                                 std::optional<block_num_type> block_num,
+                                 const send_body_type& body = {}) {
          fc::lock_guard g( _mtx );
          if( net_msg == msg_type_t::transaction_message || net_msg == msg_type_t::transaction_notice_message ) {
-            _trx_wq.push_back( {buff, conn_id, close_after_send, net_msg, block_num} );
+            _trx_wq.push_back( {buff, body, conn_id, close_after_send, net_msg, block_num} );
+            _trx_wq_size += buff->size();
          } else if (queue == queue_t::block_sync) {
-            _sync_wq.push_back( {buff, conn_id, close_after_send, net_msg, block_num} );
+            _sync_wq.push_back( {buff, body, conn_id, close_after_send, net_msg, block_num} );
          } else if (net_msg == msg_type_t::signed_block) {
-            _block_wq.push_back( {buff, conn_id, close_after_send, net_msg, block_num} );
+            _block_wq.push_back( {buff, body, conn_id, close_after_send, net_msg, block_num} );
          } else {
-            _ctrl_wq.push_back( {buff, conn_id, close_after_send, net_msg, block_num} );
+            _ctrl_wq.push_back( {buff, body, conn_id, close_after_send, net_msg, block_num} );
          }
-         auto new_size = _wq_size.fetch_add(buff->size(), std::memory_order_relaxed) + buff->size();
-         return { new_size <= 2 * def_max_write_queue_size, _out_queue.empty() };
+         const uint32_t sz = buff->size() + (body ? body->size() : 0);
+         auto new_size = _wq_size.fetch_add(sz, std::memory_order_relaxed) + sz;
+         return { new_size <= 2 * def_max_write_queue_size, _out_queue.empty(), _trx_wq_size };
       }
 
       void fill_out_buffer( small_buf_vector& bufs ) {
@@ -106,6 +118,7 @@ namespace sysio {
             fill_out_buffer( bufs, _block_wq );
          } else {
             fill_out_buffer( bufs, _trx_wq );
+            _trx_wq_size = 0;
             assert(_trx_wq.empty() && _block_wq.empty() && _sync_wq.empty() &&
                    _ctrl_wq.empty() && _wq_size.load(std::memory_order_relaxed) == 0);
          }
@@ -114,6 +127,7 @@ namespace sysio {
    private:
       struct queued_write {
          send_buffer_type             buff;
+         send_body_type               body; // optional, written directly after buff
          connection_id_t              connection_id{0};
          go_away_reason               close_after_send{go_away_reason::no_reason};
          msg_type_t                   net_msg{};
@@ -125,7 +139,12 @@ namespace sysio {
          while ( !w_queue.empty() ) {
             auto& m = w_queue.front();
             bufs.emplace_back( m.buff->data(), m.buff->size() );
-            _wq_size.fetch_sub(m.buff->size(), std::memory_order_relaxed);
+            uint32_t sz = m.buff->size();
+            if( m.body ) {
+               bufs.emplace_back( m.body->data(), m.body->size() );
+               sz += m.body->size();
+            }
+            _wq_size.fetch_sub(sz, std::memory_order_relaxed);
             _out_queue.emplace_back( m );
             w_queue.pop_front();
          }
@@ -134,6 +153,7 @@ namespace sysio {
       alignas(hardware_destructive_interference_sz)
       std::atomic<uint32_t> _wq_size{0}; // total size of all 4 write queues
       std::atomic<bool>     _write_drain_pending{false}; // coalesces queue_write_mt drain posts
+      std::atomic<bool>     _trx_batch_pending{false};   // trx batch timer armed
 
       alignas(hardware_destructive_interference_sz)
       mutable fc::mutex          _mtx;
@@ -141,6 +161,7 @@ namespace sysio {
       std::deque<queued_write>   _sync_wq     GUARDED_BY(_mtx); // sync blocks
       std::deque<queued_write>   _block_wq    GUARDED_BY(_mtx); // head blocks (signed_block via queue_t::general)
       std::deque<queued_write>   _trx_wq      GUARDED_BY(_mtx); // transactions (lowest priority)
+      uint32_t                   _trx_wq_size GUARDED_BY(_mtx) = 0; // bytes in _trx_wq
       std::deque<queued_write>   _out_queue   GUARDED_BY(_mtx); // currently being async_written
 
    }; // queued_buffer
@@ -37,6 +37,7 @@
 #include <boost/asio/post.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/key.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
 
 #if __has_include(<sys/ioctl.h>)
 #include <sys/ioctl.h>
@@ -219,6 +220,16 @@ namespace sysio {
       mutable fc::mutex      local_txns_mtx;
       local_txn_cache         local_txns GUARDED_BY(local_txns_mtx);
 
+      // Wire bytes of transactions received from peers and handed to chain, relayed as-is by bcast_transaction
+      // once accepted instead of being repacked. Removed on ack/nack; expire_txns drops any left behind.
+      struct received_trx {
+         send_buffer_type buff;
+         time_point_sec   expires;
+      };
+      alignas(hardware_destructive_interference_sz)
+      mutable fc::mutex      received_trxs_mtx;
+      boost::unordered_flat_map<transaction_id_type, received_trx> received_trxs GUARDED_BY(received_trxs_mtx);
+
       // Vote dedup cache: tracks recently seen vote IDs to avoid expensive BLS deserialization for duplicates.
       // Indexed by vote_id for O(1) lookup and by block_num for LIB-based pruning.
       struct vote_dedup_entry {
@@ -248,6 +259,8 @@ namespace sysio {
       void bcast_transaction(const packed_transaction_ptr& trx);
       void bcast_transaction_notify(const packed_transaction_ptr& trx);
       void rejected_transaction(const packed_transaction_ptr& trx);
+      void add_received_trx(const transaction_id_type& id, const time_point_sec& trx_expires, send_buffer_type buff);
+      send_buffer_type take_received_trx(const transaction_id_type& id);
       void bcast_block( const signed_block_ptr& b, const block_id_type& id );
 
       void expire_blocks( uint32_t fork_db_root_num );
@@ -303,6 +316,8 @@ namespace sysio {
    // Since both notice and trx are sent when peer does not have a trx, set a minimum requirement for sending the notice.
    // 4096 chosen as an arbitrary threshold where an additional small notice adds little additional overhead.
    constexpr auto     def_trx_notice_min_size = 4096;
+   constexpr auto     def_trx_batch_delay_us = 1000;
+   constexpr uint32_t def_trx_batch_max_bytes = 64*1024; // flush a trx batch at this size without waiting for the delay
    constexpr auto     def_allowed_clock_skew = fc::seconds(15);
 
    class connections_manager {
@@ -438,6 +453,7 @@ namespace sysio {
       bool                                  p2p_disable_block_nack = false;
       bool                                  p2p_accept_votes = true;
       fc::microseconds                      p2p_dedup_cache_expire_time_us{};
+      std::chrono::microseconds             p2p_trx_batch_delay{0};
 
       chain_id_type                         chain_id;
       fc::sha256                            node_id;
@@ -749,6 +765,10 @@ namespace sysio {
       alignas(hardware_destructive_interference_sz)
       peer_scoring::peer_score peer_score_;
 
+      // coalesces transaction writes while trxs arrive faster than p2p-trx-batch-delay-us, see defer_trx_write
+      boost::asio::steady_timer        trx_batch_timer; // only accessed through strand
+      std::atomic<int64_t>             last_trx_queued_ns{0}; // steady_clock, last trx or trx notice queued
+
       alignas(hardware_destructive_interference_sz)
       fc::mutex                        sync_response_expected_timer_mtx;
       boost::asio::steady_timer        sync_response_expected_timer GUARDED_BY(sync_response_expected_timer_mtx);
@@ -875,12 +895,13 @@ namespace sysio {
       void blk_send_branch(uint32_t msg_head_num, uint32_t fork_db_root_num, uint32_t head_num, peer_sync_state::sync_t sync_type);
 
       void enqueue( const net_message& msg );
-      size_t enqueue_block( const std::vector<char>& sb, uint32_t block_num, queued_buffer::queue_t queue );
+      size_t enqueue_block( std::vector<char>&& sb, uint32_t block_num, queued_buffer::queue_t queue );
       void enqueue_buffer( msg_type_t net_msg,
                            std::optional<block_num_type> block_num,
                            queued_buffer::queue_t queue,
                            const send_buffer_type& send_buffer,
-                           go_away_reason close_after_send);
+                           go_away_reason close_after_send,
+                           const send_body_type& send_body = {});
       void cancel_sync();
       void flush_queues();
       bool enqueue_sync_block();
@@ -896,13 +917,15 @@ namespace sysio {
                        std::optional<block_num_type> block_num,
                        queued_buffer::queue_t queue,
                        const send_buffer_type& buff,
-                       go_away_reason close_after_send);
+                       go_away_reason close_after_send,
+                       const send_body_type& body);
       void do_queue_write(std::optional<block_num_type> block_num);
       // called from any thread; adds to write queue and conditionally posts a drain
       void queue_write_mt(msg_type_t net_msg,
                           queued_buffer::queue_t queue,
                           const send_buffer_type& buff,
                           go_away_reason close_after_send);
+      bool defer_trx_write(const queued_buffer::add_result& result);
       void log_send_buffer_stats() const;
 
       bool is_valid( const handshake_message& msg ) const;
@@ -1146,6 +1169,7 @@ namespace sysio {
         socket( new tcp::socket( strand ) ),
         log_p2p_address( endpoint ),
         connection_id( ++my_impl->current_connection_id ),
+        trx_batch_timer( my_impl->thread_pool.get_executor() ),
         sync_response_expected_timer( my_impl->thread_pool.get_executor() ),
         last_handshake_recv(),
         last_handshake_sent(),
@@ -1166,6 +1190,7 @@ namespace sysio {
         socket( new tcp::socket( std::move(s) ) ),
         listen_address( listen_address ),
         connection_id( ++my_impl->current_connection_id ),
+        trx_batch_timer( my_impl->thread_pool.get_executor() ),
         sync_response_expected_timer( my_impl->thread_pool.get_executor() ),
         last_handshake_recv(),
         last_handshake_sent()
@@ -1386,6 +1411,7 @@ namespace sysio {
       socket->shutdown( tcp::socket::shutdown_both, ec );
       socket->close( ec );
       socket.reset( new tcp::socket( my_impl->thread_pool.get_executor() ) );
+      trx_batch_timer.cancel();
       flush_queues();
       peer_syncing_from_us = false;
       block_status_monitor_.reset();
@@ -1637,8 +1663,9 @@ namespace sysio {
                                 std::optional<block_num_type> block_num,
                                 queued_buffer::queue_t queue,
                                 const send_buffer_type& buff,
-                                go_away_reason close_after_send) {
-      auto result = buffer_queue.add_write_queue( net_msg, queue, buff, connection_id, close_after_send, block_num );
+                                go_away_reason close_after_send,
+                                const send_body_type& body) {
+      auto result = buffer_queue.add_write_queue( net_msg, queue, buff, connection_id, close_after_send, block_num, body );
       if( !result.ok ) {
          peer_wlog( p2p_conn_log, this, "write_queue full {} bytes, giving up on connection", buffer_queue.write_queue_size() );
          close();
@@ -1661,6 +1688,10 @@ namespace sysio {
          });
          return;
       }
+      if( (net_msg == msg_type_t::transaction_message || net_msg == msg_type_t::transaction_notice_message) &&
+          defer_trx_write( result ) ) {
+         return;
+      }
       if( result.needs_drain ) {
          if( buffer_queue.try_claim_drain() ) {
             boost::asio::post(strand, [c = shared_from_this()]() {
@@ -1671,6 +1702,32 @@ namespace sysio {
       }
    }
 
+   // called from any thread; returns true if the trx just queued is left for trx_batch_timer to write together with
+   // the trxs that follow it. Batching only applies while trxs keep arriving within p2p-trx-batch-delay-us of each
+   // other: a trx after a quiet period is written at once and a batch reaching def_trx_batch_max_bytes does not wait.
+   bool connection::defer_trx_write(const queued_buffer::add_result& result) {
+      const std::chrono::nanoseconds delay = my_impl->p2p_trx_batch_delay;
+      if( delay.count() == 0 )
+         return false;
+      const std::chrono::nanoseconds now = std::chrono::steady_clock::now().time_since_epoch();
+      const std::chrono::nanoseconds prev{ last_trx_queued_ns.exchange( now.count(), std::memory_order_relaxed ) };
+      if( !result.needs_drain ) // write in progress, its completion drains the trx queue
+         return false;
+      if( now - prev >= delay || result.trx_queue_size >= def_trx_batch_max_bytes )
+         return false;
+      if( buffer_queue.try_claim_trx_batch() ) {
+         boost::asio::post(strand, [c = shared_from_this(), delay]() {
+            c->trx_batch_timer.expires_after( delay );
+            c->trx_batch_timer.async_wait( boost::asio::bind_executor( c->strand, [c]( boost::system::error_code ec ) {
+               c->buffer_queue.release_trx_batch();
+               if( !ec )
+                  c->do_queue_write(std::nullopt);
+            } ) );
+         });
+      }
+      return true;
+   }
+
    // called from connection strand
    void connection::do_queue_write(std::optional<block_num_type> block_num) {
       if( !buffer_queue.ready_to_send(connection_id) ) {
@@ -1800,7 +1857,7 @@ namespace sysio {
             }
 
             block_sync_throttling = false;
-            auto sent = enqueue_block( blocks[i], block_num, queued_buffer::queue_t::block_sync );
+            auto sent = enqueue_block( std::move(blocks[i]), block_num, queued_buffer::queue_t::block_sync );
             block_sync_total_bytes_sent += sent;
             block_sync_frame_bytes_sent += sent;
             ++peer_requested->last;
@@ -1848,15 +1905,15 @@ namespace sysio {
    }
 
    // called from connection strand
-   size_t connection::enqueue_block( const std::vector<char>& b, uint32_t block_num, queued_buffer::queue_t queue ) {
+   size_t connection::enqueue_block( std::vector<char>&& b, uint32_t block_num, queued_buffer::queue_t queue ) {
       peer_dlog( p2p_blk_log, this, "enqueue block {}", block_num );
       verify_strand_in_this_thread( strand, __func__, __LINE__ );
 
       block_buffer_factory buff_factory;
-      const auto& sb = buff_factory.get_send_buffer( b );
+      const auto& sb = buff_factory.get_send_buffer( std::move(b) );
       latest_blk_time = std::chrono::steady_clock::now();
-      enqueue_buffer( msg_type_t::signed_block, block_num, queue, sb, go_away_reason::no_reason);
-      return sb->size();
+      enqueue_buffer( msg_type_t::signed_block, block_num, queue, sb, go_away_reason::no_reason, buff_factory.get_send_body() );
+      return buff_factory.send_size();
    }
 
    // called from connection strand
@@ -1864,9 +1921,10 @@ namespace sysio {
                                     std::optional<block_num_type> block_num, // only valid for net_msg == signed_block variant which
                                     queued_buffer::queue_t queue,
                                     const send_buffer_type& send_buffer,
-                                    go_away_reason close_after_send)
+                                    go_away_reason close_after_send,
+                                    const send_body_type& send_body)
    {
-      queue_write(net_msg, block_num, queue, send_buffer, close_after_send);
+      queue_write(net_msg, block_num, queue, send_buffer, close_after_send, send_body);
    }
 
    // thread safe
@@ -2745,6 +2803,11 @@ namespace sysio {
                                                        fc::time_point_sec{now});
          end_size = start_size - removed;
       }
+      {
+         fc::lock_guard g( received_trxs_mtx );
+         const fc::time_point_sec cutoff{now - def_allowed_clock_skew};
+         boost::unordered::erase_if( received_trxs, [&]( const auto& v ) { return v.second.expires <= cutoff; } );
+      }
 
       fc_dlog( p2p_trx_log, "expire_local_txns size {} removed {} in {}us", start_size, start_size - end_size, fc::time_point::now() - now );
    }
@@ -2807,13 +2870,14 @@ namespace sysio {
          }
 
          const send_buffer_type& sb = buff_factory.get_send_buffer( b );
+         const send_body_type& body = buff_factory.get_send_body();
 
-         boost::asio::post(cp->strand, [cp, bnum, sb]() {
+         boost::asio::post(cp->strand, [cp, bnum, sb, body]() {
             cp->latest_blk_time = std::chrono::steady_clock::now();
             bool has_block = cp->peer_fork_db_root_num.load( std::memory_order_relaxed ) >= bnum;
             if( !has_block ) {
                peer_dlog( p2p_blk_log, cp, "bcast block {}", bnum );
-               cp->enqueue_buffer( msg_type_t::signed_block, bnum, queued_buffer::queue_t::general, sb, go_away_reason::no_reason );
+               cp->enqueue_buffer( msg_type_t::signed_block, bnum, queued_buffer::queue_t::general, sb, go_away_reason::no_reason, body );
             }
          });
       } );
@@ -2831,7 +2895,7 @@ namespace sysio {
 
    // called from any thread
    void dispatch_manager::bcast_transaction(const packed_transaction_ptr& trx) {
-      trx_buffer_factory buff_factory;
+      trx_buffer_factory buff_factory( take_received_trx( trx->id() ) ); // repacks only if not received from a peer
       const auto trx_connections = peer_connections(trx->id());
       my_impl->connections.for_each_connection( [&]( const connection_ptr& cp ) {
          if( !cp->is_transactions_connection() || !cp->current() ) {
@@ -2865,6 +2929,24 @@ namespace sysio {
    void dispatch_manager::rejected_transaction(const packed_transaction_ptr& trx) {
       fc_dlog( p2p_trx_log, "not sending rejected transaction {}", trx->id() );
       // keep rejected transaction around for awhile so we don't broadcast it, don't remove from local_txns
+      take_received_trx( trx->id() );
+   }
+
+   // called from connection strand
+   void dispatch_manager::add_received_trx(const transaction_id_type& id, const time_point_sec& trx_expires, send_buffer_type buff) {
+      fc::lock_guard g( received_trxs_mtx );
+      received_trxs.insert_or_assign( id, received_trx{std::move(buff), trx_expires} );
+   }
+
+   // thread safe, returns nullptr if id was not received from a peer or was already taken
+   send_buffer_type dispatch_manager::take_received_trx(const transaction_id_type& id) {
+      fc::lock_guard g( received_trxs_mtx );
+      auto i = received_trxs.find( id );
+      if( i == received_trxs.end() )
+         return {};
+      send_buffer_type buff = std::move( i->second.buff );
+      received_trxs.erase( i );
+      return buff;
    }
 
    //------------------------------------------------------------------------
@@ -3321,11 +3403,20 @@ namespace sysio {
       const uint32_t trx_in_progress_sz = this->trx_in_progress_size.load();
 
       auto now = fc::time_point::now();
+      // Keep the packed_transaction bytes as read off the wire so an accepted trx is relayed without repacking.
+      // Peeked before the unpack below consumes (and may release) the message buffer holding them.
+      const uint32_t body_size = message_length - header_bytes;
+      send_buffer_type relay_buffer = trx_buffer_factory::create_received_send_buffer( trx_id, body_size );
+      auto body_index = pending_message_buffer.read_index();
+      pending_message_buffer.peek( relay_buffer->data() + relay_buffer->size() - body_size, body_size, body_index );
+
       // shared_ptr<packed_transaction> needed here because packed_transaction_ptr is shared_ptr<const packed_transaction>
       std::shared_ptr<packed_transaction> ptr = std::make_shared<packed_transaction>();
       // ds is bounded to message_length, so the body cannot be unpacked from bytes belonging to a
       // following pipelined frame; advance to the frame boundary once the body is consumed.
       fc::raw::unpack( ds, *ptr );
+      if( bytes_before - pending_message_buffer.bytes_to_read() != message_length )
+         relay_buffer.reset(); // trailing bytes in the frame are not part of the trx, repack on relay
       advance_to_frame_end( bytes_before, message_length );
 
       // Validate that the wire ID matches the actual transaction ID.
@@ -3372,6 +3463,8 @@ namespace sysio {
          my_impl->dispatcher.bcast_transaction_notify(ptr);
       }
 
+      if( relay_buffer )
+         my_impl->dispatcher.add_received_trx( tid, ptr->expiration(), std::move(relay_buffer) );
       handle_message( ptr );
       return true;
    }
@@ -4588,6 +4681,9 @@ namespace sysio {
          ( "connection-cleanup-period", bpo::value<int>()->default_value(def_conn_retry_wait), "number of seconds to wait before cleaning up dead connections")
          ( "max-cleanup-time-msec", bpo::value<uint32_t>()->default_value(10), "max connection cleanup time per cleanup call in milliseconds")
          ( "p2p-dedup-cache-expire-time-sec", bpo::value<uint32_t>()->default_value(10), "Maximum time to track transaction for duplicate optimization")
+         ( "p2p-trx-batch-delay-us", bpo::value<uint32_t>()->default_value(def_trx_batch_delay_us),
+           "Maximum microseconds a transaction is held to be written to a peer together with the transactions that follow it."
+           " Only applies while transactions arrive faster than this; 0 writes every transaction immediately.")
          ( "net-threads", bpo::value<uint16_t>()->default_value(my->thread_pool_size),
            "Number of worker threads in net_plugin thread pool" )
          ( "sync-fetch-span", bpo::value<uint32_t>()->default_value(def_sync_fetch_span),
@@ -4629,6 +4725,7 @@ namespace sysio {
 
          expire_timer_period = def_expire_timer_wait;
          p2p_dedup_cache_expire_time_us = fc::seconds( options.at( "p2p-dedup-cache-expire-time-sec" ).as<uint32_t>() );
+         p2p_trx_batch_delay = std::chrono::microseconds( options.at( "p2p-trx-batch-delay-us" ).as<uint32_t>() );
          resp_expected_period = def_resp_expected_wait;
          max_nodes_per_host = options.at( "p2p-max-nodes-per-host" ).as<int>();
          p2p_accept_transactions = options.at( "p2p-accept-transactions" ).as<bool>();
@@ -4776,6 +4873,9 @@ namespace sysio {
 
    void net_plugin_impl::plugin_startup() {
       fc_ilog( p2p_conn_log, "my node_id is {}", node_id );
+#ifdef BOOST_ASIO_HAS_IO_URING_AS_DEFAULT
+      fc_ilog( p2p_conn_log, "using io_uring for p2p socket io" );
+#endif
 
       producer_plug = app().find_plugin<producer_plugin>();
       assert(producer_plug);
@@ -186,6 +186,46 @@ BOOST_AUTO_TEST_CASE(test_trx_buffer_factory_format) {
    BOOST_CHECK_EQUAL( ds.remaining(), 0u );
 }
 
+// Verify a transaction relayed from its received wire bytes is byte-identical to one repacked by trx_buffer_factory.
+BOOST_AUTO_TEST_CASE(test_trx_received_send_buffer_matches_repack) {
+   auto ptr = std::make_shared<packed_transaction>( make_packed_trx() );
+   const auto body = fc::raw::pack( *ptr );
+
+   auto received = trx_buffer_factory::create_received_send_buffer( ptr->id(), body.size() );
+   memcpy( received->data() + received->size() - body.size(), body.data(), body.size() );
+
+   trx_buffer_factory repack_factory;
+   const auto& repacked = repack_factory.get_send_buffer( ptr );
+   BOOST_CHECK( *received == *repacked );
+
+   // a factory seeded with the received bytes hands them out as-is
+   trx_buffer_factory relay_factory( received );
+   BOOST_CHECK( relay_factory.get_send_buffer( ptr ) == received );
+}
+
+// Verify block_buffer_factory frames a serialized block as [size][which] followed by the untouched block bytes.
+BOOST_AUTO_TEST_CASE(test_block_buffer_factory_header_and_body) {
+   std::vector<char> ssb( 1000, 'z' );
+   const char* const ssb_data = ssb.data();
+
+   block_buffer_factory factory;
+   const auto& header = factory.get_send_buffer( std::move(ssb) );
+   const auto& body = factory.get_send_body();
+   BOOST_REQUIRE( body );
+   BOOST_CHECK( body->data() == ssb_data ); // moved, not copied
+   BOOST_CHECK_EQUAL( factory.send_size(), header->size() + 1000u );
+
+   uint32_t payload_size = 0;
+   memcpy( &payload_size, header->data(), sizeof(payload_size) );
+   BOOST_CHECK_EQUAL( payload_size, header->size() - message_header_size + body->size() );
+
+   fc::datastream<const char*> ds( header->data() + message_header_size, header->size() - message_header_size );
+   unsigned_int which{};
+   fc::raw::unpack( ds, which );
+   BOOST_CHECK_EQUAL( which.value, to_index(msg_type_t::signed_block) );
+   BOOST_CHECK_EQUAL( ds.remaining(), 0u );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(net_message_session_gate)
@@ -82,6 +82,56 @@ BOOST_AUTO_TEST_CASE(trx_notice_routes_to_trx_queue) {
    BOOST_CHECK_EQUAL(qb.write_queue_size(), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(enqueue_block_with_body_and_drain) {
+   queued_buffer qb;
+   auto header = make_buffer(6);
+   send_body_type body = std::make_shared<const std::vector<char>>(400, 'b');
+   qb.add_write_queue(msg_type_t::signed_block, queued_buffer::queue_t::general,
+                       header, 1, go_away_reason::no_reason, block_num_type{10}, body);
+   BOOST_CHECK_EQUAL(qb.write_queue_size(), 406u);
+
+   small_buf_vector bufs;
+   qb.fill_out_buffer(bufs);
+   // header then body, body written in place from the shared bytes
+   BOOST_REQUIRE_EQUAL(bufs.size(), 2u);
+   BOOST_CHECK_EQUAL(bufs[0].size(), 6u);
+   BOOST_CHECK_EQUAL(bufs[1].size(), 400u);
+   BOOST_CHECK(bufs[1].data() == body->data());
+   BOOST_CHECK_EQUAL(qb.write_queue_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(trx_queue_size_tracks_pending_trx_bytes) {
+   queued_buffer qb;
+   auto r = qb.add_write_queue(msg_type_t::transaction_message, queued_buffer::queue_t::general,
+                                make_buffer(150), 1, go_away_reason::no_reason, std::nullopt);
+   BOOST_CHECK_EQUAL(r.trx_queue_size, 150u);
+   r = qb.add_write_queue(msg_type_t::vote_message, queued_buffer::queue_t::general,
+                           make_buffer(40), 1, go_away_reason::no_reason, std::nullopt);
+   BOOST_CHECK_EQUAL(r.trx_queue_size, 150u); // non-trx messages do not count
+   r = qb.add_write_queue(msg_type_t::transaction_notice_message, queued_buffer::queue_t::general,
+                           make_buffer(50), 1, go_away_reason::no_reason, std::nullopt);
+   BOOST_CHECK_EQUAL(r.trx_queue_size, 200u);
+
+   small_buf_vector bufs;
+   qb.fill_out_buffer(bufs); // ctrl first, trx stays queued
+   BOOST_CHECK_EQUAL(bufs.size(), 1u);
+   bufs.clear();
+   qb.fill_out_buffer(bufs);
+   BOOST_CHECK_EQUAL(bufs.size(), 2u);
+
+   r = qb.add_write_queue(msg_type_t::transaction_message, queued_buffer::queue_t::general,
+                           make_buffer(10), 1, go_away_reason::no_reason, std::nullopt);
+   BOOST_CHECK_EQUAL(r.trx_queue_size, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(trx_batch_claim) {
+   queued_buffer qb;
+   BOOST_CHECK(qb.try_claim_trx_batch());
+   BOOST_CHECK(!qb.try_claim_trx_batch());
+   qb.release_trx_batch();
+   BOOST_CHECK(qb.try_claim_trx_batch());
+}
+
 // ---- Priority ordering ----
 
 BOOST_AUTO_TEST_CASE(priority_ctrl_before_sync) {
@@ -109,6 +109,8 @@ void producer_api_plugin::plugin_startup() {
                      INVOKE_R_R_D(producer, get_unapplied_transactions, producer_plugin::get_unapplied_transactions_params), 200),
        CALL_WITH_400(producer, producer_ro, producer, get_snapshot_requests,
                      INVOKE_R_V(producer, get_snapshot_requests), 201),
+       CALL_WITH_400(producer, producer_ro, producer, get_wasm_profile,
+            INVOKE_R_R_II(producer, get_wasm_profile, producer_plugin::get_wasm_profile_params), 201),
    }, appbase::exec_queue::read_only, appbase::priority::medium_high);
 
    // Not safe to run in parallel
@@ -137,6 +139,8 @@ void producer_api_plugin::plugin_startup() {
             INVOKE_R_V(producer, get_integrity_hash), 201),
        CALL_WITH_400(producer, producer_rw, producer, schedule_protocol_feature_activations,
             INVOKE_V_R(producer, schedule_protocol_feature_activations, producer_plugin::scheduled_protocol_feature_activations), 201),
+       CALL_WITH_400(producer, producer_rw, producer, reset_wasm_profile,
+            INVOKE_V_V(producer, reset_wasm_profile), 201),
    }, appbase::exec_queue::read_write, appbase::priority::medium_high);
 }
 
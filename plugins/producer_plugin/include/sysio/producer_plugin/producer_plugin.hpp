@@ -2,6 +2,7 @@
 
 #include <sysio/chain_plugin/chain_plugin.hpp>
 #include <sysio/chain/snapshot_scheduler.hpp>
+#include <sysio/chain/wasm_profiler.hpp>
 #include <sysio/signature_provider_manager_plugin/signature_provider_manager_plugin.hpp>
 
 #include <sysio/chain/application.hpp>
@@ -107,6 +108,19 @@ public:
 
    fc::variants get_supported_protocol_features( const get_supported_protocol_features_params& params ) const;
 
+   struct get_wasm_profile_params {
+      std::optional<string> format; ///< "json" (default) fills codes, "collapsed" fills collapsed for flamegraph.pl
+   };
+
+   struct get_wasm_profile_result {
+      std::vector<chain::wasm_profiler::code_entry> codes;
+      string                                        collapsed;
+   };
+
+   /// Samples of wasm-profile-account receivers gathered since startup or the last reset_wasm_profile
+   get_wasm_profile_result get_wasm_profile( const get_wasm_profile_params& params ) const;
+   void reset_wasm_profile();
+
    struct get_unapplied_transactions_params {
       string      lower_bound;  /// transaction id
       std::optional<uint32_t>    limit = 100;
@@ -170,3 +184,5 @@ FC_REFLECT(sysio::producer_plugin::get_unapplied_transactions_params, (lower_bou
 FC_REFLECT(sysio::producer_plugin::unapplied_trx, (trx_id)(expiration)(trx_type)(first_auth)(first_receiver)(first_action)(total_actions)(accounts_billing)(size))
 FC_REFLECT(sysio::producer_plugin::get_unapplied_transactions_result, (unapplied_size)(queued_size)(unapplied_trxs)(queued_trxs)(more))
 FC_REFLECT(sysio::producer_plugin::pause_at_block_params, (block_num));
+FC_REFLECT(sysio::producer_plugin::get_wasm_profile_params, (format));
+FC_REFLECT(sysio::producer_plugin::get_wasm_profile_result, (codes)(collapsed));
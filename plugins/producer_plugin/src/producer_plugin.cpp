@@ -813,6 +813,11 @@ public:
    unapplied_transaction_queue                       _unapplied_transactions;
    alignas(hardware_destructive_interference_sz)
    std::atomic<int32_t>                              _max_transaction_time_ms; // modified by app thread, read by net_plugin thread pool
+   // Estimated size of trxs whose keys are recovered and that wait in the trx_read_write queue. Admission beyond
+   // incoming-transaction-queue-size-mb is refused on the recovering thread, before the main thread sees the trx.
+   alignas(hardware_destructive_interference_sz)
+   std::atomic<uint64_t>                             _admitted_trx_bytes{0};
+   uint64_t                                          _max_admitted_trx_bytes = 1024*1024*1024;
    // Floor for the speculative-retry CPU cap applied in push_transaction(). That cap is normally
    // 2x the transaction's previously measured wall-clock cost, which guards against "producer bombs"
    // (transactions that speculate cheaply but consume large CPU when produced into a block). For very
@@ -1118,18 +1123,21 @@ public:
                    bool is_transient,
                    next_function<transaction_trace_ptr> next,
                    bool api_trx,
-                   bool return_failure_traces)
+                   bool return_failure_traces,
+                   uint64_t admitted_bytes)
          : self(self)
          , trx_meta(std::move(trx_meta))
          , is_transient(is_transient)
          , next(std::move(next))
          , api_trx(api_trx)
          , return_failure_traces(return_failure_traces)
+         , admitted_bytes(admitted_bytes)
       {}
 
       const transaction_metadata_ptr& get_trx_meta() const { return trx_meta; }
 
       void operator()() {
+         self->_admitted_trx_bytes.fetch_sub(admitted_bytes, std::memory_order_relaxed);
          auto start       = fc::time_point::now();
          auto idle_time   = self->_time_tracker.add_idle_time(start);
          fc_tlog(_log, "Time since last trx: {}us", idle_time);
@@ -1156,6 +1164,7 @@ public:
       next_function<transaction_trace_ptr> next;
       bool api_trx;
       bool return_failure_traces;
+      uint64_t admitted_bytes;
    };
 
    void on_incoming_transaction_async(const packed_transaction_ptr&        trx,
@@ -1202,10 +1211,21 @@ public:
                  chain::controller& chain = chain_plug->chain();
                  transaction_metadata_ptr trx_meta;
                  int priority = priority::low;
+                 uint64_t admitted_bytes = 0;
                  try {
                     trx_meta = transaction_metadata::recover_keys(trx, chain.get_chain_id(), time_limit, trx_type,
                                                                   chain.configured_subjective_signature_length_limit());
                     priority = _trx_priority_db.get_trx_priority(trx->get_transaction());
+
+                    admitted_bytes = trx_meta->get_estimated_size();
+                    const uint64_t queued = _admitted_trx_bytes.fetch_add(admitted_bytes, std::memory_order_relaxed);
+                    if (queued + admitted_bytes > _max_admitted_trx_bytes) {
+                       _admitted_trx_bytes.fetch_sub(admitted_bytes, std::memory_order_relaxed);
+                       SYS_THROW(tx_resource_exhaustion,
+                                 "Transaction {}, size {} bytes would exceed configured incoming-transaction-queue-size-mb {} "
+                                 "of transactions waiting to execute, currently {} bytes",
+                                 trx->id(), admitted_bytes, _max_admitted_trx_bytes/(1024*1024), queued);
+                    }
                  } catch (...) {
                     // use read_write when read is likely fine; maintains previous behavior of next() always being called from the main thread
                     app().executor().post(
@@ -1226,7 +1246,7 @@ public:
                     return;
                  }
 
-                 trx_executor executor{this, std::move(trx_meta), is_transient, std::move(next), api_trx, return_failure_traces};
+                 trx_executor executor{this, std::move(trx_meta), is_transient, std::move(next), api_trx, return_failure_traces, admitted_bytes};
 
                  // key recovery complete, post to the trx queue
                  app().executor().post(priority, exec_queue::trx_read_write, std::move(executor));
@@ -1588,6 +1608,7 @@ void producer_plugin_impl::plugin_initialize(const boost::program_options::varia
               "incoming-transaction-queue-size-mb {} must be greater than 0", max_incoming_transaction_queue_size);
 
    _unapplied_transactions.set_max_transaction_queue_size(max_incoming_transaction_queue_size);
+   _max_admitted_trx_bytes = max_incoming_transaction_queue_size;
 
    chain.get_mutable_subjective_billing().set_subjective_account_cpu_allowed(fc::microseconds(options.at("subjective-account-cpu-allowed-us").as<int64_t>()));
    _disable_subjective_p2p_billing = options.at("disable-subjective-p2p-billing").as<bool>();
@@ -2000,6 +2021,30 @@ void producer_plugin::set_whitelist_blacklist(const producer_plugin::whitelist_b
       chain.set_key_blacklist(*params.key_blacklist);
 }
 
+producer_plugin::get_wasm_profile_result producer_plugin::get_wasm_profile(const get_wasm_profile_params& params) const {
+   const std::string format = params.format.value_or("json");
+   SYS_ASSERT(format == "json" || format == "collapsed", chain::invalid_http_request,
+              "Unknown format {}, expected json or collapsed", format);
+
+   chain::controller& chain = my->chain_plug->chain();
+   chain::wasm_profiler* profiler = chain.get_wasm_profiler();
+   SYS_ASSERT(profiler, chain::invalid_http_request, "WASM profiler is not enabled, see wasm-profile-account");
+
+   get_wasm_profile_result result;
+   result.codes = profiler->report(chain.db());
+   if (format == "collapsed") {
+      result.collapsed = chain::wasm_profiler::collapsed(result.codes);
+      result.codes.clear();
+   }
+   return result;
+}
+
+void producer_plugin::reset_wasm_profile() {
+   chain::wasm_profiler* profiler = my->chain_plug->chain().get_wasm_profiler();
+   SYS_ASSERT(profiler, chain::invalid_http_request, "WASM profiler is not enabled, see wasm-profile-account");
+   profiler->reset();
+}
+
 producer_plugin::integrity_hash_information producer_plugin::get_integrity_hash() const {
    return my->get_integrity_hash();
 }
@@ -2045,7 +2090,8 @@ producer_plugin::schedule_snapshot(const chain::snapshot_scheduler::snapshot_req
       .block_spacing   = srp.block_spacing ? *srp.block_spacing : 0,
       .start_block_num = srp.start_block_num ? *srp.start_block_num : head_block_num + 1,
       .end_block_num   = srp.end_block_num ? *srp.end_block_num : std::numeric_limits<uint32_t>::max(),
-      .snapshot_description = srp.snapshot_description ? *srp.snapshot_description : ""
+      .snapshot_description = srp.snapshot_description ? *srp.snapshot_description : "",
+      .full_snapshot_spacing = srp.full_snapshot_spacing ? *srp.full_snapshot_spacing : 0
    };
    //treat a 0 end_block_num as max for compatibility with leap4 behavior
    if(sri.end_block_num == 0)
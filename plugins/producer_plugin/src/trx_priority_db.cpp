@@ -3,6 +3,7 @@
 #include <sysio/chain/abi_serializer.hpp>
 #include <sysio/chain/account_object.hpp>
 #include <sysio/chain/kv_table_objects.hpp>
+#include <sysio/chain/kv_cold_store.hpp>
 #include <sysio/chain/wasm_interface_private.hpp>
 #include <sysio/producer_plugin/trx_priority_db.hpp>
 #include <vector>
@@ -66,7 +67,8 @@ std::vector<char> get_global_row(const controller& control, name code, name tabl
    auto itr = kv_idx.find(boost::make_tuple(code, tid, key_sv));
    if (itr == kv_idx.end())
       return {};
-   return {itr->value.data(), itr->value.data() + itr->value.size()};
+   const std::string_view value = kv_value(db, *itr);
+   return {value.begin(), value.end()};
 }
 
 block_timestamp_type get_last_trx_priority_update(const controller& control) {
@@ -105,7 +107,8 @@ void trx_priority_db::load_trx_priority_map(const controller& control, trx_prior
             break;
 
          trx_prio tmp;
-         datastream<const char*> ds(itr->value.data(), itr->value.size());
+         const std::string_view value = kv_value(db, *itr);
+         datastream<const char*> ds(value.data(), value.size());
          fc::raw::unpack(ds, tmp);
          m.insert({tmp.receiver, tmp});
 
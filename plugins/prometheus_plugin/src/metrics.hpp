@@ -5,14 +5,17 @@
 #include <sysio/producer_plugin/producer_plugin.hpp>
 #include <sysio/chain_plugin/tracked_votes.hpp>
 
+#include <fc/latency_histogram.hpp>
 #include <fc/network/http/http_client.hpp>
 #include <prometheus/counter.h>
 #include <prometheus/info.h>
+#include <prometheus/metric_family.h>
 #include <prometheus/registry.h>
 #include <prometheus/text_serializer.h>
 #include <fc/log/logger.hpp>
 
 #include <array>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -233,12 +236,46 @@ struct catalog_type {
    std::string report() {
       update_outbound_http_metrics();
       const prometheus::TextSerializer serializer;
-      auto                             result = serializer.Serialize(registry.Collect());
+      auto                             families = registry.Collect();
+      auto                             histograms = collect_latency_histograms();
+      families.insert(families.end(), std::make_move_iterator(histograms.begin()), std::make_move_iterator(histograms.end()));
+      auto                             result = serializer.Serialize(families);
       bytes_transferred.Increment(result.size());
       num_scrapes.Increment(1);
       return result;
    }
 
+   /**
+    * Export every fc::latency_histogram as a Prometheus histogram, one family per histogram name.
+    * Buckets are the power of two nanosecond boundaries from about 1us to 34s. They fall on
+    * fc::latency_histogram bucket boundaries, so each cumulative count is exact for values below its bound.
+    */
+   static std::vector<prometheus::MetricFamily> collect_latency_histograms() {
+      constexpr uint32_t min_bucket_exponent = 10;
+      constexpr uint32_t max_bucket_exponent = 35;
+
+      std::vector<prometheus::MetricFamily> families;
+      std::map<std::string, size_t>         family_index;
+      fc::latency_histogram::for_each([&](const fc::latency_histogram& h) {
+         auto [it, inserted] = family_index.try_emplace(h.name(), families.size());
+         if (inserted)
+            families.push_back({.name = h.name(), .help = h.help(), .type = prometheus::MetricType::Histogram});
+
+         const auto snapshot = h.snapshot();
+         prometheus::ClientMetric metric;
+         for (const auto& [name, value] : h.labels())
+            metric.label.push_back({name, value});
+         metric.histogram.sample_count = snapshot.count;
+         metric.histogram.sample_sum   = snapshot.sum_ns / 1e9;
+         for (uint32_t e = min_bucket_exponent; e <= max_bucket_exponent; ++e) {
+            const uint64_t bound_ns = uint64_t{1} << e;
+            metric.histogram.bucket.push_back({.cumulative_count = snapshot.count_at_most(bound_ns), .upper_bound = bound_ns / 1e9});
+         }
+         families[it->second].metric.push_back(std::move(metric));
+      });
+      return families;
+   }
+
    /** Copy process-wide monotonic outbound transport deltas into Prometheus counters. */
    void update_outbound_http_metrics() {
       const auto current = fc::http::get_metrics_snapshot();
@@ -32,6 +32,7 @@ struct snapshot_metadata {
    chain::block_id_type block_id;
    fc::time_point       block_time;
    fc::crypto::blake3   root_hash;
+   uint64_t             file_size = 0;
 };
 
 struct by_block_params {
@@ -44,7 +45,7 @@ struct download_params {
 
 } // namespace sysio
 
-FC_REFLECT(sysio::snapshot_metadata, (block_num)(block_id)(block_time)(root_hash))
+FC_REFLECT(sysio::snapshot_metadata, (block_num)(block_id)(block_time)(root_hash)(file_size))
 FC_REFLECT(sysio::by_block_params, (block_num))
 FC_REFLECT(sysio::download_params, (block_num))
 
@@ -183,7 +184,7 @@ void snapshot_api_plugin::plugin_startup() {
                 cb(404, fc::variant(fc::mutable_variant_object()("message", "No snapshots available")));
                 return;
              }
-             snapshot_metadata meta{entry->block_num, entry->block_id, entry->block_time, entry->root_hash};
+             snapshot_metadata meta{entry->block_num, entry->block_id, entry->block_time, entry->root_hash, entry->file_size};
              cb(200, fc::variant(meta));
           } catch (...) {
              http_plugin::handle_exception("snapshot", "latest", body, cb);
@@ -203,7 +204,7 @@ void snapshot_api_plugin::plugin_startup() {
                 cb(404, fc::variant(fc::mutable_variant_object()("message", "No snapshot found for block " + std::to_string(params.block_num))));
                 return;
              }
-             snapshot_metadata meta{entry->block_num, entry->block_id, entry->block_time, entry->root_hash};
+             snapshot_metadata meta{entry->block_num, entry->block_id, entry->block_time, entry->root_hash, entry->file_size};
              cb(200, fc::variant(meta));
           } catch (...) {
              http_plugin::handle_exception("snapshot", "by_block", body, cb);
@@ -5,6 +5,7 @@
 #include <boost/unordered/unordered_flat_set.hpp>
 #include <fc/io/cfile.hpp>
 #include <sysio/chain/name.hpp>
+#include <sysio/trace_api/mapped_slice.hpp>
 #include <sysio/trace_api/trace.hpp>
 
 #include <cstdint>
@@ -142,7 +143,13 @@ public:
    bloom_reader() = default;
 
    explicit bloom_reader(const std::filesystem::path& path) {
-      load(path);
+      if (auto mapping = mapped_slice::map(path))
+         load(*mapping);
+   }
+
+   /// Parse the sidecar straight out of a (possibly cached and shared) mapping of its file.
+   explicit bloom_reader(const mapped_slice& mapping) {
+      load(mapping);
    }
 
    bool valid() const noexcept { return _valid; }
@@ -159,19 +166,17 @@ public:
    }
 
 private:
-   void load(const std::filesystem::path& path) {
+   void load(const mapped_slice& mapping) {
       // Any failure here leaves _valid == false, which fails safe: the probe methods return true and the caller
-      // scans the slice.  fc::cfile throws std::ios_base::failure on open/read errors; we catch broadly to keep
-      // that guarantee without propagating to the query path.
+      // scans the slice.  The filter allocations below can throw; we catch broadly to keep that guarantee without
+      // propagating to the query path.
       try {
-         std::error_code ec;
-         const auto file_size = std::filesystem::file_size(path, ec);
-         if (ec || file_size < sizeof(bloom::header) + sizeof(uint32_t)) return;
-
-         fc::cfile in(path, fc::cfile::read_only_mode);
+         const char*       in        = mapping.data();
+         const std::size_t file_size = mapping.size();
+         if (file_size < sizeof(bloom::header) + sizeof(uint32_t)) return;
 
          bloom::header hdr;
-         in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+         std::memcpy(&hdr, in, sizeof(hdr));
          if (hdr.magic                      != bloom::magic_value)   return;
          if (hdr.version                    != bloom::file_version)  return;
          if (hdr.k_hash_count               != bloom::k_hashes)      return;
@@ -188,17 +193,16 @@ private:
          const std::size_t expected_size = sizeof(bloom::header) + recv_bytes + ra_bytes + sizeof(uint32_t);
          if (file_size != expected_size) return;
 
-         std::vector<unsigned char> recv_buf(recv_bytes);
-         std::vector<unsigned char> ra_buf(ra_bytes);
-         in.read(reinterpret_cast<char*>(recv_buf.data()), recv_bytes);
-         in.read(reinterpret_cast<char*>(ra_buf.data()),   ra_bytes);
+         // Both filter bodies are read in place out of the mapping; the only copy is into the filters themselves.
+         const char* recv_buf = in + sizeof(hdr);
+         const char* ra_buf   = recv_buf + recv_bytes;
          uint32_t file_crc = 0;
-         in.read(reinterpret_cast<char*>(&file_crc), sizeof(file_crc));
+         std::memcpy(&file_crc, ra_buf + ra_bytes, sizeof(file_crc));
 
          boost::crc_32_type crc;
-         crc.process_bytes(&hdr,             sizeof(hdr));
-         crc.process_bytes(recv_buf.data(),  recv_buf.size());
-         crc.process_bytes(ra_buf.data(),    ra_buf.size());
+         crc.process_bytes(&hdr,     sizeof(hdr));
+         crc.process_bytes(recv_buf, recv_bytes);
+         crc.process_bytes(ra_buf,   ra_bytes);
          if (crc.checksum() != file_crc) return;
 
          // boost::bloom guarantees filter{f.capacity()}.capacity() == f.capacity() (see boost/bloom/detail/core.hpp
@@ -206,16 +210,16 @@ private:
          // size-equality check below is a belt-and-suspenders guard against a future boost::bloom change.
          bloom::filter_t recv_f{hdr.recv_capacity_bits};
          bloom::filter_t ra_f{hdr.recv_action_capacity_bits};
-         if (recv_f.array().size() != recv_buf.size())  return;
-         if (ra_f.array().size()   != ra_buf.size())    return;
-         std::memcpy(recv_f.array().data(), recv_buf.data(), recv_buf.size());
-         std::memcpy(ra_f.array().data(),   ra_buf.data(),   ra_buf.size());
+         if (recv_f.array().size() != recv_bytes)  return;
+         if (ra_f.array().size()   != ra_bytes)    return;
+         std::memcpy(recv_f.array().data(), recv_buf, recv_bytes);
+         std::memcpy(ra_f.array().data(),   ra_buf,   ra_bytes);
 
          _recv        = std::move(recv_f);
          _recv_action = std::move(ra_f);
          _valid       = true;
       } catch (const std::exception&) {
-         // File-system or read error: leave _valid == false so may_contain_* returns true -> scan fallback.
+         // Allocation failure: leave _valid == false so may_contain_* returns true -> scan fallback.
          _valid = false;
       }
    }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <fc/io/datastream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace sysio::trace_api {
+
+// ---------------------------------------------------------------------------
+// Read-only, shared memory mapping of a slice file.
+//
+// Slice files are append-only (trace_<range>.log) or immutable once renamed
+// into place (trx_id index, receiver bloom), so a mapping of the first size()
+// bytes stays valid and correct for its whole lifetime: appends land past the
+// mapped range, and an unlink by retention pruning or compression leaves the
+// pages alive until the last reference drops.  MAP_SHARED keeps the mapping
+// coherent with the page cache the writer fills, so a hot slice is resident
+// once no matter how many request threads read it.
+// ---------------------------------------------------------------------------
+
+class mapped_slice {
+public:
+   /// Map the current contents of path.  Returns nullptr when the file is missing, empty or cannot be mapped;
+   /// callers fall back to the buffered fc::cfile read path.
+   static std::shared_ptr<const mapped_slice> map(const std::filesystem::path& path);
+
+   mapped_slice(const mapped_slice&)            = delete;
+   mapped_slice& operator=(const mapped_slice&) = delete;
+   ~mapped_slice();
+
+   const char* data() const noexcept { return _base; }
+   uint64_t    size() const noexcept { return _size; }
+
+   /// Datastream over [offset, size()).  Unpacking past the mapped range throws fc::out_of_range_exception.
+   fc::datastream<const char*> create_datastream(uint64_t offset) const;
+
+   /// MADV_WILLNEED over [offset, offset + length), clamped to the mapping.  Advisory only: never throws.
+   void will_need(uint64_t offset, uint64_t length) const noexcept;
+
+private:
+   mapped_slice(const char* base, uint64_t size) : _base(base), _size(size) {}
+
+   const char* _base = nullptr;
+   uint64_t    _size = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Bounded LRU of slice mappings keyed by file path, shared by all request
+// threads.  A lookup returns the cached mapping when it already covers the
+// requested number of bytes; otherwise the file is remapped at its current
+// size (it has grown since the cached mapping was taken) and replaces the
+// entry.  Readers holding the older mapping keep it until they are done.
+// Capacity 0 disables caching: get() always returns nullptr.
+// ---------------------------------------------------------------------------
+
+class mapped_slice_cache {
+public:
+   explicit mapped_slice_cache(size_t capacity) : _capacity(capacity) {}
+
+   /// Mapping of path covering at least min_size bytes, or nullptr when the file is missing, shorter than
+   /// min_size, or caching is disabled.
+   std::shared_ptr<const mapped_slice> get(const std::filesystem::path& path, uint64_t min_size);
+
+   /// Drop a cached mapping, e.g. when maintenance compresses or removes the slice file.
+   void erase(const std::filesystem::path& path);
+
+   size_t capacity() const noexcept { return _capacity; }
+
+private:
+   using lru_list = std::list<std::pair<std::string, std::shared_ptr<const mapped_slice>>>;
+
+   const size_t                                         _capacity;
+   std::mutex                                           _mtx;
+   lru_list                                             _lru; // front = most recently used
+   std::unordered_map<std::string, lru_list::iterator>  _by_path;
+};
+
+} // namespace sysio::trace_api
@@ -329,6 +329,10 @@ namespace sysio::trace_api {
          result.last_block_num = query.block_num_end;
 
          const uint64_t end = query.block_num_end;
+         // Start read-ahead of the range's trace data before decoding the first block.  The HTTP layer has already
+         // clamped the range to trace-max-block-range and the recorded watermark, so this touches a slice or two.
+         if (query.block_num_start <= end)
+            logfile_provider.prefetch_blocks(query.block_num_start, query.block_num_end);
          for (uint64_t bn = query.block_num_start; bn <= end; ++bn) {
             // bn <= end <= UINT32_MAX throughout the loop body, so this narrowing is value-preserving.
             const uint32_t block_num = static_cast<uint32_t>(bn);
@@ -13,6 +13,7 @@
 #include <sysio/trace_api/common.hpp>
 #include <sysio/trace_api/compressed_file.hpp>
 #include <sysio/trace_api/data_log.hpp>
+#include <sysio/trace_api/mapped_slice.hpp>
 #include <sysio/trace_api/metadata_log.hpp>
 #include <sysio/trace_api/trx_id_index.hpp>
 
@@ -126,8 +127,13 @@ namespace sysio::trace_api {
       };
 
       enum class open_state { read /*read from front to back*/, write /*write to end of file*/ };
+
+      // Default number of slice file mappings (trace logs, trx_id indexes, receiver blooms) kept by the read path.
+      static constexpr size_t default_mapped_slice_cache_size = 64;
+
       slice_directory(const std::filesystem::path& slice_dir, uint32_t width, std::optional<uint32_t> minimum_irreversible_history_blocks,
-                      std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride);
+                      std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride,
+                      size_t mapped_slice_cache_size = default_mapped_slice_cache_size);
 
       /**
        * Return the slice number that would include the passed in block_height
@@ -200,6 +206,31 @@ namespace sysio::trace_api {
        */
       bool find_trace_slice(uint32_t slice_number, open_state state, fc::cfile& trace_file, bool open_file = true) const;
 
+      /**
+       * Shared read-only mapping of the uncompressed trace file for slice_number covering at least min_size bytes.
+       * The mapping comes from a bounded LRU shared by all request threads and is remapped when the file has grown
+       * past the cached mapping.
+       *
+       * @param slice_number : slice number of the requested slice file
+       * @param min_size : number of leading bytes of the file the mapping must cover
+       * @return the mapping, or nullptr if the file does not exist, is shorter than min_size, cannot be mapped, or
+       *         the mapping cache is disabled; callers then fall back to the fc::cfile read path
+       */
+      std::shared_ptr<const mapped_slice> map_trace_slice(uint32_t slice_number, uint64_t min_size) const;
+
+      /**
+       * Shared read-only mapping of the receiver bloom sidecar for slice_number, or nullptr if it does not exist or
+       * the mapping cache is disabled.
+       */
+      std::shared_ptr<const mapped_slice> map_bloom_slice(uint32_t slice_number) const;
+
+      /**
+       * Hint the kernel to read ahead the trace data of blocks [first_block, last_block] (MADV_WILLNEED on the
+       * mapped trace slices), so a block-range scan decodes from resident pages instead of faulting them in one
+       * at a time.  Advisory: silently does nothing for slices that are compressed, missing or not mappable.
+       */
+      void prefetch_blocks(uint32_t first_block, uint32_t last_block) const;
+
       /**
        * Find the read-only compressed trace file associated with the indicated slice_number
        *
@@ -388,6 +419,9 @@ namespace sysio::trace_api {
       std::optional<uint32_t> _last_bloomed_slice;
       const size_t _compression_seek_point_stride;
 
+      // Read path mappings of slice files, shared across request threads.  Internally synchronized.
+      mutable mapped_slice_cache _mapped_slices;
+
       mutable std::mutex _maintenance_mtx;
       std::condition_variable _maintenance_condition;
       std::thread _maintenance_thread;
@@ -406,7 +440,8 @@ namespace sysio::trace_api {
       using open_state = slice_directory::open_state;
 
       store_provider(const std::filesystem::path& slice_dir, uint32_t stride_width, std::optional<uint32_t> minimum_irreversible_history_blocks,
-            std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride);
+            std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride,
+            size_t mapped_slice_cache_size = slice_directory::default_mapped_slice_cache_size);
 
       template<typename BlockTrace>
       void append(const BlockTrace& bt);
@@ -483,6 +518,14 @@ namespace sysio::trace_api {
 
       get_block_n get_trx_block_number(const chain::transaction_id_type& trx_id, const yield_function& yield= {});
 
+      /**
+       * Ask the kernel to read ahead the trace data for blocks [first_block, last_block] ahead of a range scan.
+       * Advisory only.
+       */
+      void prefetch_blocks(uint32_t first_block, uint32_t last_block) const {
+         _slice_directory.prefetch_blocks(first_block, last_block);
+      }
+
       /**
        * Return {first, last} block numbers recorded across all index slice files, or nullopt
        * if the slice directory is empty.  Used at startup to verify continuity between existing
@@ -560,6 +603,25 @@ namespace sysio::trace_api {
       std::optional<data_log_entry> read_data_log( uint32_t block_height, uint64_t offset ) {
          const uint32_t slice_number = _slice_directory.slice_number(block_height);
 
+         // Hot path: decode straight out of the shared mapping of the slice.  The mapping only has to cover the
+         // entry's first byte up front; an entry appended after the mapping was taken runs past its end, in which
+         // case remap at the file's current size and decode once more.
+         if (auto mapped = _slice_directory.map_trace_slice(slice_number, offset + 1)) {
+            for (int attempt = 0;; ++attempt) {
+               try {
+                  data_log_entry entry;
+                  auto ds = mapped->create_datastream(offset);
+                  fc::raw::unpack(ds, entry);
+                  return entry;
+               } catch (const fc::out_of_range_exception&) {
+                  auto grown = attempt == 0 ? _slice_directory.map_trace_slice(slice_number, mapped->size() + 1) : nullptr;
+                  if (!grown)
+                     throw;
+                  mapped = std::move(grown);
+               }
+            }
+         }
+
          fc::cfile trace;
          if( !_slice_directory.find_trace_slice(slice_number, open_state::read, trace) ) {
             // attempt to read a compressed trace if one exists
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <sysio/trace_api/common.hpp>
+#include <sysio/trace_api/mapped_slice.hpp>
 #include <sysio/chain/types.hpp>
 #include <fc/io/cfile.hpp>
 #include <fc/reflect/reflect.hpp>
@@ -8,6 +9,7 @@
 #include <cstring>
 #include <deque>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -89,9 +91,11 @@ private:
 // A lookup touches at most a handful of buckets (load factor <= 0.5), so the
 // file is mmap'd rather than bulk-read: only the probed pages fault in, the
 // kernel page cache shares them across requests, and a not-found probe across
-// many slices stays O(1) I/O per slice instead of O(file size).  Move-only;
-// the destructor unmaps.  Files are immutable once written (temp + rename),
-// and an unlink by retention pruning leaves an existing mapping valid.
+// many slices stays O(1) I/O per slice instead of O(file size).  The mapping
+// is a shared mapped_slice, so store_provider can hand every request thread
+// the same cached mapping instead of re-mapping the file per lookup.  Files
+// are immutable once written (temp + rename), and an unlink by retention
+// pruning leaves an existing mapping valid.
 //
 // Collisions (two trx_ids sharing a 64-bit prefix) are not explicitly
 // confirmed - callers confirm hits against the recorded block data.
@@ -100,11 +104,8 @@ private:
 class trx_id_index_reader {
 public:
    explicit trx_id_index_reader(const std::filesystem::path& path);
-   trx_id_index_reader(trx_id_index_reader&& other) noexcept;
-   trx_id_index_reader& operator=(trx_id_index_reader&& other) noexcept;
-   trx_id_index_reader(const trx_id_index_reader&)            = delete;
-   trx_id_index_reader& operator=(const trx_id_index_reader&) = delete;
-   ~trx_id_index_reader();
+   // Validate an index out of an existing mapping of path (e.g. from mapped_slice_cache).
+   trx_id_index_reader(std::shared_ptr<const mapped_slice> mapping, const std::filesystem::path& path);
 
    bool valid() const { return _valid; }
 
@@ -112,13 +113,12 @@ public:
    std::optional<uint32_t> lookup(const chain::transaction_id_type& trx_id) const;
 
 private:
-   void unmap() noexcept;
+   void load(std::shared_ptr<const mapped_slice> mapping, const std::filesystem::path& path);
 
-   const trx_id_bucket* _buckets      = nullptr; // into the mapping, just past the header
-   uint32_t             _bucket_count = 0;
-   void*                _map_base     = nullptr;
-   std::size_t          _map_size     = 0;
-   bool                 _valid        = false;
+   std::shared_ptr<const mapped_slice> _mapping;
+   const trx_id_bucket*                _buckets      = nullptr; // into the mapping, just past the header
+   uint32_t                            _bucket_count = 0;
+   bool                                _valid        = false;
 };
 
 } // namespace sysio::trace_api
@@ -0,0 +1,108 @@
+#include <sysio/trace_api/mapped_slice.hpp>
+#include <sysio/trace_api/logging.hpp>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sysio::trace_api {
+
+namespace {
+
+// Closes the wrapped fd on scope exit; the mmap'd region taken from it stays valid.
+struct fd_closer {
+   int fd;
+   ~fd_closer() {
+      if (fd >= 0)
+         ::close(fd);
+   }
+};
+
+} // namespace
+
+std::shared_ptr<const mapped_slice> mapped_slice::map(const std::filesystem::path& path) {
+   const fd_closer fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+   if (fd.fd < 0)
+      return {};
+
+   struct stat st{};
+   if (::fstat(fd.fd, &st) != 0 || st.st_size <= 0)
+      return {};
+   const uint64_t size = static_cast<uint64_t>(st.st_size);
+
+   void* base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.fd, 0);
+   if (base == MAP_FAILED) {
+      fc_wlog(_log, "trace_api: failed to mmap slice {}", path.generic_string());
+      return {};
+   }
+   return std::shared_ptr<const mapped_slice>(new mapped_slice(static_cast<const char*>(base), size));
+}
+
+mapped_slice::~mapped_slice() {
+   if (_base)
+      ::munmap(const_cast<char*>(_base), _size);
+}
+
+fc::datastream<const char*> mapped_slice::create_datastream(uint64_t offset) const {
+   const uint64_t start = std::min(offset, _size);
+   return fc::datastream<const char*>(_base + start, _size - start);
+}
+
+void mapped_slice::will_need(uint64_t offset, uint64_t length) const noexcept {
+   if (offset >= _size || length == 0)
+      return;
+   // madvise needs a page-aligned start; round down and extend the length to keep the requested end.
+   static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+   const uint64_t aligned = offset & ~(page_size - 1);
+   const uint64_t end     = std::min(_size, offset + length);
+   ::madvise(const_cast<char*>(_base) + aligned, end - aligned, MADV_WILLNEED);
+}
+
+std::shared_ptr<const mapped_slice> mapped_slice_cache::get(const std::filesystem::path& path, uint64_t min_size) {
+   if (_capacity == 0)
+      return {};
+
+   const std::string key = path.native();
+   {
+      std::lock_guard g(_mtx);
+      if (auto it = _by_path.find(key); it != _by_path.end()) {
+         _lru.splice(_lru.begin(), _lru, it->second);
+         if (it->second->second->size() >= min_size)
+            return it->second->second;
+      }
+   }
+
+   // Map outside the lock: mmap of a large file can stall on the filesystem and must not serialize lookups of
+   // other slices.  Two threads racing on the same cold slice both map it; the later insert wins, harmlessly.
+   auto mapping = mapped_slice::map(path);
+   if (!mapping || mapping->size() < min_size)
+      return {};
+
+   std::lock_guard g(_mtx);
+   if (auto it = _by_path.find(key); it != _by_path.end()) {
+      if (it->second->second->size() < mapping->size())
+         it->second->second = mapping;
+      _lru.splice(_lru.begin(), _lru, it->second);
+      return mapping;
+   }
+   _lru.emplace_front(key, mapping);
+   _by_path.emplace(key, _lru.begin());
+   while (_lru.size() > _capacity) {
+      _by_path.erase(_lru.back().first);
+      _lru.pop_back();
+   }
+   return mapping;
+}
+
+void mapped_slice_cache::erase(const std::filesystem::path& path) {
+   std::lock_guard g(_mtx);
+   if (auto it = _by_path.find(path.native()); it != _by_path.end()) {
+      _lru.erase(it->second);
+      _by_path.erase(it);
+   }
+}
+
+} // namespace sysio::trace_api
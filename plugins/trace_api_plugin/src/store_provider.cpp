@@ -53,8 +53,10 @@ namespace {
 
 namespace sysio::trace_api {
       store_provider::store_provider(const std::filesystem::path& slice_dir, uint32_t stride_width, std::optional<uint32_t> minimum_irreversible_history_blocks,
-                                  std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride)
-   : _slice_directory(slice_dir, stride_width, minimum_irreversible_history_blocks, minimum_uncompressed_irreversible_history_blocks, compression_seek_point_stride)
+                                  std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride,
+                                  size_t mapped_slice_cache_size)
+   : _slice_directory(slice_dir, stride_width, minimum_irreversible_history_blocks, minimum_uncompressed_irreversible_history_blocks, compression_seek_point_stride,
+                      mapped_slice_cache_size)
    , _abi_log(slice_dir / "abi_log.log") {
       // The abi_log constructor restores its reversible overlay from its own durable journal
       // sidecar (both lazy global_seq-0 and setabi records), so no overlay rebuild is needed here.
@@ -109,6 +111,10 @@ namespace sysio::trace_api {
    }
 
    bloom_reader store_provider::get_bloom(uint32_t slice_number) const {
+      // Sidecars are immutable once renamed into place, so the cached mapping is parsed in place and its pages are
+      // shared by every request probing this slice.
+      if (auto mapped = _slice_directory.map_bloom_slice(slice_number))
+         return bloom_reader{*mapped};
       const auto path = _slice_directory.bloom_slice_path(slice_number);
       std::error_code ec;
       if (!std::filesystem::exists(path, ec)) return bloom_reader{};
@@ -279,12 +285,13 @@ namespace sysio::trace_api {
       return result;
    }
 
-   slice_directory::slice_directory(const std::filesystem::path& slice_dir, uint32_t width, std::optional<uint32_t> minimum_irreversible_history_blocks, std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride)
+   slice_directory::slice_directory(const std::filesystem::path& slice_dir, uint32_t width, std::optional<uint32_t> minimum_irreversible_history_blocks, std::optional<uint32_t> minimum_uncompressed_irreversible_history_blocks, size_t compression_seek_point_stride, size_t mapped_slice_cache_size)
    : _slice_dir(slice_dir)
    , _width(width)
    , _minimum_irreversible_history_blocks(minimum_irreversible_history_blocks)
    , _minimum_uncompressed_irreversible_history_blocks(minimum_uncompressed_irreversible_history_blocks)
    , _compression_seek_point_stride(compression_seek_point_stride)
+   , _mapped_slices(mapped_slice_cache_size)
    , _best_known_lib(0) {
       if (!exists(_slice_dir)) {
          std::filesystem::create_directories(slice_dir);
@@ -361,6 +368,36 @@ namespace sysio::trace_api {
       return _slice_dir / make_filename(_trace_recv_bloom_prefix, _trace_ext, slice_number, _width);
    }
 
+   std::shared_ptr<const mapped_slice> slice_directory::map_trace_slice(uint32_t slice_number, uint64_t min_size) const {
+      return _mapped_slices.get(_slice_dir / make_filename(_trace_prefix, _trace_ext, slice_number, _width), min_size);
+   }
+
+   std::shared_ptr<const mapped_slice> slice_directory::map_bloom_slice(uint32_t slice_number) const {
+      return _mapped_slices.get(bloom_slice_path(slice_number), 0);
+   }
+
+   void slice_directory::prefetch_blocks(uint32_t first_block, uint32_t last_block) const {
+      // Per slice touched by the range, advise from the first block's trace offset up to the offset of the block
+      // following the range (or the end of the mapping when the range runs to the end of the slice or that block
+      // is not recorded).  Fork re-writes append out of order, so an inverted pair also falls back to the end of
+      // the mapping; over-advising only costs read-ahead of pages the scan is likely to touch anyway.
+      for (uint64_t bn = first_block; bn <= last_block;) {
+         const uint32_t slice       = slice_number(static_cast<uint32_t>(bn));
+         const uint64_t slice_last  = (uint64_t{slice} + 1) * _width - 1;
+         const uint64_t range_last  = std::min<uint64_t>(slice_last, last_block);
+         if (auto mapped = map_trace_slice(slice, 1)) {
+            const uint64_t begin = lookup_block_offset(static_cast<uint32_t>(bn)).value_or(0);
+            uint64_t end = mapped->size();
+            if (range_last < slice_last) {
+               if (const auto next = lookup_block_offset(static_cast<uint32_t>(range_last + 1)); next && *next > begin)
+                  end = *next;
+            }
+            mapped->will_need(begin, end - begin);
+         }
+         bn = range_last + 1;
+      }
+   }
+
    std::optional<compressed_file> slice_directory::find_compressed_trace_slice(uint32_t slice_number, bool open_file ) const {
       auto filename = make_filename(_trace_prefix, _compressed_trace_ext, slice_number, _width);
       const auto slice_path = _slice_dir / filename;
@@ -673,9 +710,17 @@ namespace sysio::trace_api {
    std::optional<trx_id_index_reader> slice_directory::find_trx_id_index_slice(uint32_t slice_number) const {
       auto filename = make_filename(_trace_trx_id_index_prefix, _trace_ext, slice_number, _width);
       const auto path = _slice_dir / filename;
-      if (!std::filesystem::exists(path))
+      std::error_code ec;
+      const uint64_t size = std::filesystem::file_size(path, ec);
+      if (ec)
          return std::nullopt;
-      trx_id_index_reader reader(path);
+      // Indexes are immutable once renamed into place, so every lookup shares one cached mapping.  Files over the
+      // reader's size cap (or with caching disabled) go through the path constructor, which rejects them before
+      // reserving address space.
+      const uint64_t max_size = sizeof(trx_id_index_header) +
+                                uint64_t{trx_id_index_header::max_bucket_count} * sizeof(trx_id_bucket);
+      auto mapping = size <= max_size ? _mapped_slices.get(path, 0) : nullptr;
+      trx_id_index_reader reader = mapping ? trx_id_index_reader(std::move(mapping), path) : trx_id_index_reader(path);
       if (!reader.valid())
          return std::nullopt;
       return reader;
@@ -994,6 +1039,7 @@ namespace sysio::trace_api {
             if (trace_found) {
                log(std::string("Removing: ") + trace.get_file_path().generic_string());
                std::filesystem::remove(trace.get_file_path());
+               _mapped_slices.erase(trace.get_file_path());
             }
             const bool trx_id_found = find_trx_id_slice(slice_to_clean, open_state::read, trx_id, dont_open_file);
             if (trx_id_found) {
@@ -1005,6 +1051,7 @@ namespace sysio::trace_api {
             if (std::filesystem::exists(idx_path)) {
                log(std::string("Removing: ") + idx_path.generic_string());
                std::filesystem::remove(idx_path);
+               _mapped_slices.erase(idx_path);
             }
 
             auto blk_idx_filename = make_filename(_trace_blk_idx_prefix, _trace_ext, slice_to_clean, _width);
@@ -1018,6 +1065,7 @@ namespace sysio::trace_api {
             if (std::filesystem::exists(bloom_path)) {
                log(std::string("Removing: ") + bloom_path.generic_string());
                std::filesystem::remove(bloom_path);
+               _mapped_slices.erase(bloom_path);
             }
 
             auto ctrace = find_compressed_trace_slice(slice_to_clean, dont_open_file);
@@ -1076,6 +1124,8 @@ namespace sysio::trace_api {
                // after compression is complete, delete the old uncompressed file
                log(std::string("Removing: ") + trace.get_file_path().generic_string());
                std::filesystem::remove(trace.get_file_path());
+               // readers already holding the mapping keep it; new reads go to the compressed file
+               _mapped_slices.erase(trace.get_file_path());
             }
          });
       }
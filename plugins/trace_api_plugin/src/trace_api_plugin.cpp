@@ -140,6 +140,10 @@ namespace {
          return store->get_bloom(slice_number);
       }
 
+      void prefetch_blocks(uint32_t first_block, uint32_t last_block) const {
+         store->prefetch_blocks(first_block, last_block);
+      }
+
       std::shared_ptr<Store> store;
    };
 }
@@ -175,6 +179,9 @@ struct trace_api_common_impl {
                   "next request's block_num_start to block_num_end + 1; do not advance by a fixed step,\n"
                   "because the scan can also stop short of the requested end when a response reaches the\n"
                   "per-response limit on the number of actions returned.");
+      cfg_options("trace-slice-mmap-cache-size", bpo::value<uint32_t>()->default_value(slice_directory::default_mapped_slice_cache_size),
+                  "Number of slice files (trace logs, trx_id indexes, receiver blooms) kept memory-mapped for the query path.\n"
+                  "Mappings are shared by all HTTP threads and evicted least-recently-used. 0 disables the mapped read path.");
    }
 
    void plugin_initialize(const appbase::variables_map& options) {
@@ -210,12 +217,15 @@ struct trace_api_common_impl {
                  "\"trace-max-block-range\" must be in [1, 10000]; got {}", block_range);
       max_block_range = block_range;
 
+      mapped_slice_cache_size = options.at("trace-slice-mmap-cache-size").as<uint32_t>();
+
       store = std::make_shared<store_provider>(
          trace_dir,
          slice_stride,
          minimum_irreversible_history_blocks,
          minimum_uncompressed_irreversible_history_blocks,
-         compression_seek_point_stride
+         compression_seek_point_stride,
+         mapped_slice_cache_size
       );
    }
 
@@ -240,6 +250,7 @@ struct trace_api_common_impl {
    static constexpr uint32_t compression_seek_point_stride = 6 * 1024 * 1024; // 6 MiB strides for clog seek points
 
    uint32_t max_block_range = default_max_block_range;
+   size_t mapped_slice_cache_size = slice_directory::default_mapped_slice_cache_size;
    std::shared_ptr<store_provider> store;
 };
 
@@ -8,26 +8,8 @@
 #include <bit>
 #include <cstring>
 
-#include <fcntl.h>
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <unistd.h>
-
 namespace sysio::trace_api {
 
-namespace {
-
-// Closes the wrapped fd on scope exit; the mmap'd region taken from it stays valid.
-struct fd_closer {
-   int fd;
-   ~fd_closer() {
-      if (fd >= 0)
-         ::close(fd);
-   }
-};
-
-} // namespace
-
 void trx_id_index_writer::add(const chain::transaction_id_type& trx_id, uint32_t block_num) {
    _entries.emplace_back(trx_id_prefix(trx_id), block_num);
 }
@@ -89,21 +71,15 @@ void trx_id_index_writer::write(const std::filesystem::path& path) const {
 // ---------------------------------------------------------------------------
 
 trx_id_index_reader::trx_id_index_reader(const std::filesystem::path& path) {
-   const fd_closer fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
-   if (fd.fd < 0) {
-      fc_wlog(_log, "trace_api: failed to open trx_id index {}", path.generic_string());
-      return;
-   }
-
-   struct stat st{};
-   if (::fstat(fd.fd, &st) != 0) {
-      fc_wlog(_log, "trace_api: failed to stat trx_id index {}", path.generic_string());
-      return;
-   }
-   const uint64_t actual_size = static_cast<uint64_t>(st.st_size);
    // Reject before mapping: too small for a header, or larger than the biggest
    // index the cap permits (guards the address-space reservation against a
    // corrupt/malicious sparse file).
+   std::error_code ec;
+   const uint64_t actual_size = std::filesystem::file_size(path, ec);
+   if (ec) {
+      fc_wlog(_log, "trace_api: failed to stat trx_id index {}", path.generic_string());
+      return;
+   }
    const uint64_t max_size = sizeof(trx_id_index_header) +
                              uint64_t{trx_id_index_header::max_bucket_count} * sizeof(trx_id_bucket);
    if (actual_size < sizeof(trx_id_index_header) || actual_size > max_size) {
@@ -111,29 +87,38 @@ trx_id_index_reader::trx_id_index_reader(const std::filesystem::path& path) {
               path.generic_string(), actual_size, sizeof(trx_id_index_header), max_size);
       return;
    }
+   load(mapped_slice::map(path), path);
+}
 
-   void* base = ::mmap(nullptr, actual_size, PROT_READ, MAP_PRIVATE, fd.fd, 0);
-   if (base == MAP_FAILED) {
+trx_id_index_reader::trx_id_index_reader(std::shared_ptr<const mapped_slice> mapping, const std::filesystem::path& path) {
+   load(std::move(mapping), path);
+}
+
+void trx_id_index_reader::load(std::shared_ptr<const mapped_slice> mapping, const std::filesystem::path& path) {
+   if (!mapping) {
       fc_wlog(_log, "trace_api: failed to mmap trx_id index {}", path.generic_string());
       return;
    }
-   _map_base = base;
-   _map_size = actual_size;
+   const uint64_t actual_size = mapping->size();
+   if (actual_size < sizeof(trx_id_index_header)) {
+      fc_wlog(_log, "trace_api: trx_id index {} size {} smaller than its header, ignoring",
+              path.generic_string(), actual_size);
+      return;
+   }
 
-   // Validate the header out of the mapping.  Any failure below unmaps and
-   // leaves the reader invalid; callers fall back to the linear scan.
+   // Validate the header out of the mapping.  Any failure below leaves the
+   // reader invalid (the mapping is released); callers fall back to the
+   // linear scan.
    trx_id_index_header header{};
-   std::memcpy(&header, _map_base, sizeof(header));
+   std::memcpy(&header, mapping->data(), sizeof(header));
 
    if (header.magic != trx_id_index_header::magic_value) {
       fc_wlog(_log, "trace_api: trx_id index {} has wrong magic, ignoring", path.generic_string());
-      unmap();
       return;
    }
    if (header.version != trx_id_index_header::current_version) {
       fc_wlog(_log, "trace_api: trx_id index {} has unsupported version {}, ignoring",
               path.generic_string(), header.version);
-      unmap();
       return;
    }
    // File length must equal header + bucket_count * sizeof(bucket).  Checked
@@ -145,12 +130,10 @@ trx_id_index_reader::trx_id_index_reader(const std::filesystem::path& path) {
    if (actual_size != expected_size) {
       fc_wlog(_log, "trace_api: trx_id index {} size {} != expected {}, ignoring",
               path.generic_string(), actual_size, expected_size);
-      unmap();
       return;
    }
    if (header.bucket_count == 0) {
       // Valid empty index: every lookup misses.  No bucket array to point at.
-      unmap();
       _valid = true;
       return;
    }
@@ -158,13 +141,11 @@ trx_id_index_reader::trx_id_index_reader(const std::filesystem::path& path) {
    if (!std::has_single_bit(header.bucket_count)) {
       fc_wlog(_log, "trace_api: trx_id index {} bucket_count {} is not a power of two, ignoring",
               path.generic_string(), header.bucket_count);
-      unmap();
       return;
    }
    if (header.bucket_count > trx_id_index_header::max_bucket_count) {
       fc_wlog(_log, "trace_api: trx_id index {} bucket_count {} exceeds cap {}, ignoring",
               path.generic_string(), header.bucket_count, trx_id_index_header::max_bucket_count);
-      unmap();
       return;
    }
 
@@ -173,55 +154,12 @@ trx_id_index_reader::trx_id_index_reader(const std::filesystem::path& path) {
    // wrote the buckets little-endian with no padding (see the bulk-write note
    // in trx_id_index_writer::write), so the on-disk bytes are the in-memory
    // representation on x86_64 LE.
-   _buckets      = reinterpret_cast<const trx_id_bucket*>(static_cast<const char*>(_map_base) + sizeof(header));
+   _mapping      = std::move(mapping);
+   _buckets      = reinterpret_cast<const trx_id_bucket*>(_mapping->data() + sizeof(header));
    _bucket_count = header.bucket_count;
    _valid        = true;
 }
 
-trx_id_index_reader::trx_id_index_reader(trx_id_index_reader&& other) noexcept
-   : _buckets(other._buckets)
-   , _bucket_count(other._bucket_count)
-   , _map_base(other._map_base)
-   , _map_size(other._map_size)
-   , _valid(other._valid) {
-   other._buckets      = nullptr;
-   other._bucket_count = 0;
-   other._map_base     = nullptr;
-   other._map_size     = 0;
-   other._valid        = false;
-}
-
-trx_id_index_reader& trx_id_index_reader::operator=(trx_id_index_reader&& other) noexcept {
-   if (this != &other) {
-      unmap();
-      _buckets      = other._buckets;
-      _bucket_count = other._bucket_count;
-      _map_base     = other._map_base;
-      _map_size     = other._map_size;
-      _valid        = other._valid;
-      other._buckets      = nullptr;
-      other._bucket_count = 0;
-      other._map_base     = nullptr;
-      other._map_size     = 0;
-      other._valid        = false;
-   }
-   return *this;
-}
-
-trx_id_index_reader::~trx_id_index_reader() {
-   unmap();
-}
-
-void trx_id_index_reader::unmap() noexcept {
-   if (_map_base) {
-      ::munmap(_map_base, _map_size);
-      _map_base = nullptr;
-      _map_size = 0;
-   }
-   _buckets      = nullptr;
-   _bucket_count = 0;
-}
-
 std::optional<uint32_t> trx_id_index_reader::lookup(const chain::transaction_id_type& trx_id) const {
    if (!_valid || _bucket_count == 0)
       return std::nullopt;
@@ -47,6 +47,9 @@ struct get_actions_fixture {
          return fixture.mock_get_bloom(slice_number);
       }
 
+      // Read-ahead is advisory; the mock has no files to advise.
+      void prefetch_blocks(uint32_t, uint32_t) const {}
+
       get_actions_fixture& fixture;
    };
 
@@ -0,0 +1,134 @@
+#include <boost/test/unit_test.hpp>
+#include <fc/io/cfile.hpp>
+#include <fc/io/raw.hpp>
+
+#include <sysio/trace_api/mapped_slice.hpp>
+#include <sysio/trace_api/store_provider.hpp>
+#include <sysio/trace_api/test_common.hpp>
+
+using namespace sysio;
+using namespace sysio::trace_api;
+using namespace sysio::trace_api::test_common;
+
+namespace {
+
+void append_bytes(const std::filesystem::path& path, const std::string& bytes) {
+   fc::cfile f;
+   f.set_file_path(path);
+   f.open(fc::cfile::create_or_update_rw_mode);
+   f.seek_end(0);
+   f.write(bytes.data(), bytes.size());
+   f.flush();
+}
+
+block_trace_v0 make_block(uint32_t number) {
+   block_trace_v0 bt;
+   bt.id          = chain::block_id_type::hash(std::to_string(number));
+   bt.number      = number;
+   bt.previous_id = chain::block_id_type::hash(std::to_string(number - 1));
+   return bt;
+}
+
+struct mapped_slice_fixture {
+   fc::temp_directory tempdir;
+
+   std::filesystem::path file_path() const {
+      return tempdir.path() / "slice.log";
+   }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(mapped_slice_tests)
+
+BOOST_FIXTURE_TEST_CASE(missing_and_empty_files_do_not_map, mapped_slice_fixture) {
+   BOOST_CHECK(!mapped_slice::map(file_path()));
+   append_bytes(file_path(), "");
+   BOOST_CHECK(!mapped_slice::map(file_path()));
+}
+
+BOOST_FIXTURE_TEST_CASE(datastream_reads_mapped_bytes, mapped_slice_fixture) {
+   append_bytes(file_path(), "abcdef");
+   auto m = mapped_slice::map(file_path());
+   BOOST_REQUIRE(m);
+   BOOST_REQUIRE_EQUAL(m->size(), 6u);
+
+   auto ds = m->create_datastream(2);
+   char buf[4] = {};
+   ds.read(buf, 4);
+   BOOST_CHECK_EQUAL(std::string(buf, 4), "cdef");
+   BOOST_CHECK_THROW(ds.read(buf, 1), fc::out_of_range_exception);
+
+   // advisory calls outside the mapping are ignored
+   m->will_need(0, 6);
+   m->will_need(100, 6);
+}
+
+BOOST_FIXTURE_TEST_CASE(cache_remaps_grown_file, mapped_slice_fixture) {
+   mapped_slice_cache cache(4);
+   append_bytes(file_path(), "abc");
+
+   auto first = cache.get(file_path(), 1);
+   BOOST_REQUIRE(first);
+   BOOST_CHECK_EQUAL(first->size(), 3u);
+   BOOST_CHECK(cache.get(file_path(), 3) == first);   // covered: same mapping is shared
+   BOOST_CHECK(!cache.get(file_path(), 4));           // file is not that long yet
+
+   append_bytes(file_path(), "def");
+   auto grown = cache.get(file_path(), 4);
+   BOOST_REQUIRE(grown);
+   BOOST_CHECK_EQUAL(grown->size(), 6u);
+   BOOST_CHECK(cache.get(file_path(), 1) == grown);
+   // the older mapping stays usable by whoever still holds it
+   BOOST_CHECK_EQUAL(std::string(first->data(), first->size()), "abc");
+}
+
+BOOST_FIXTURE_TEST_CASE(cache_evicts_least_recently_used, mapped_slice_fixture) {
+   mapped_slice_cache cache(2);
+   const auto a = tempdir.path() / "a.log";
+   const auto b = tempdir.path() / "b.log";
+   const auto c = tempdir.path() / "c.log";
+   append_bytes(a, "a");
+   append_bytes(b, "b");
+   append_bytes(c, "c");
+
+   auto ma = cache.get(a, 1);
+   auto mb = cache.get(b, 1);
+   BOOST_CHECK(cache.get(a, 1) == ma); // a is now most recently used
+   cache.get(c, 1);                    // evicts b
+   BOOST_CHECK(cache.get(a, 1) == ma);
+   BOOST_CHECK(cache.get(b, 1) != mb);
+
+   cache.erase(a);
+   BOOST_CHECK(cache.get(a, 1) != ma);
+}
+
+BOOST_FIXTURE_TEST_CASE(disabled_cache_returns_nothing, mapped_slice_fixture) {
+   mapped_slice_cache cache(0);
+   append_bytes(file_path(), "abc");
+   BOOST_CHECK(!cache.get(file_path(), 1));
+}
+
+BOOST_FIXTURE_TEST_CASE(store_reads_blocks_appended_after_mapping, mapped_slice_fixture) {
+   store_provider sp(tempdir.path(), 100, std::optional<uint32_t>(), std::optional<uint32_t>(), 0);
+   sp.append(make_block(5));
+   auto b5 = sp.get_block(5);
+   BOOST_REQUIRE(b5);
+   BOOST_CHECK_EQUAL(std::get<block_trace_v0>(std::get<0>(*b5)).number, 5u);
+
+   // block 6 lands past the mapping taken for block 5; the read path must remap rather than fail
+   sp.append(make_block(6));
+   sp.prefetch_blocks(5, 6);
+   auto b6 = sp.get_block(6);
+   BOOST_REQUIRE(b6);
+   BOOST_CHECK_EQUAL(std::get<block_trace_v0>(std::get<0>(*b6)).number, 6u);
+   BOOST_CHECK(std::get<block_trace_v0>(std::get<0>(*b6)).id == make_block(6).id);
+
+   // identical results with the mapped read path disabled
+   store_provider unmapped(tempdir.path(), 100, std::optional<uint32_t>(), std::optional<uint32_t>(), 0, 0);
+   auto u6 = unmapped.get_block(6);
+   BOOST_REQUIRE(u6);
+   BOOST_CHECK(std::get<block_trace_v0>(std::get<0>(*u6)) == std::get<block_trace_v0>(std::get<0>(*b6)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,7 @@
 #include <boost/program_options.hpp>
 
 #include <chrono>
+#include <thread>
 
 #ifndef _WIN32
 #define FOPEN(p, m) fopen(p, m)
@@ -112,7 +113,9 @@ void blocklog_actions::setup(CLI::App& app) {
    merge_blocks->add_option("--output-dir", opt->output_dir, "The output directory for the merged block log.")->required();
 
    // subcommand - smoke test
-   sub->add_subcommand("smoke-test", "Quick test that blocks.log and blocks.index are well formed and agree with each other.")->callback([err_guard]() { err_guard(&blocklog_actions::smoke_test); });
+   auto* smoke_test = sub->add_subcommand("smoke-test", "Quick test that blocks.log and blocks.index are well formed and agree with each other.")->callback([err_guard]() { err_guard(&blocklog_actions::smoke_test); });
+   smoke_test->add_flag("--full", opt->full_validate, "Unpack and hash every block, checking block numbers, links and positions, instead of sampling a few.");
+   smoke_test->add_option("--threads,-t", opt->threads, "Number of threads for --full (default is the number of hardware threads).");
 
    // subcommand - vacuum
    sub->add_subcommand("vacuum", "Vacuum a pruned blocks.log in to an un-pruned blocks.log")->callback([err_guard]() { err_guard(&blocklog_actions::do_vacuum); });
@@ -240,7 +243,14 @@ int blocklog_actions::smoke_test() {
    using namespace std;
    std::filesystem::path block_dir = opt->blocks_dir;
    cout << "\nSmoke test of blocks.log and blocks.index in directory " << block_dir << '\n';
-   block_log::smoke_test(block_dir, 0);
+   if (opt->full_validate) {
+      const uint32_t threads = opt->threads ? opt->threads : std::max(std::thread::hardware_concurrency(), 1u);
+      report_time rt("full validation");
+      block_log::full_validate(block_dir, threads);
+      rt.report();
+   } else {
+      block_log::smoke_test(block_dir, 0);
+   }
    cout << "\nno problems found\n"; // if get here there were no exceptions
    return 0;
 }
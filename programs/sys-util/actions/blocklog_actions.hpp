@@ -14,10 +14,12 @@ struct blocklog_options {
    std::string  output_dir  = "";
    uint32_t     stride      = 100000;
    print_from_t print_from  = print_from_t::both;
+   uint32_t     threads     = 0;
 
    // flags
    bool no_pretty_print = false;
    bool as_json_array = false;
+   bool full_validate = false;
 
    block_log_config blog_conf;
 };
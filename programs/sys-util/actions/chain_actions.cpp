@@ -8,11 +8,24 @@
 #include <chainbase/environment.hpp>
 #include <sysio/chain/app.hpp>
 #include <sysio/chain/config.hpp>
+#include <sysio/chain/state_compaction.hpp>
 
 using namespace sysio::chain;
 
 namespace {
   namespace fs = std::filesystem;
+
+  // absolute path for a directory option, falling back to def when not specified
+  fs::path resolve_dir(const std::string& dir, const fs::path& def) {
+    if (dir.empty()) {
+      return def;
+    }
+    fs::path p = dir;
+    if (p.is_relative()) {
+      p = std::filesystem::current_path() / p;
+    }
+    return p;
+  }
 } // namespace
 
 void chain_actions::setup(CLI::App& app) {
@@ -45,6 +58,44 @@ void chain_actions::setup(CLI::App& app) {
       if (rc) throw(CLI::RuntimeError(rc));
     }
   );
+
+  auto* compact = sub->add_subcommand(
+    "compact",
+    "rebuild the state database into a fresh file, dropping allocator free lists and fragmentation; the node must be stopped"
+  );
+  compact->add_option(
+    "--blocks-dir",
+    opt->compact_blocks_dir,
+    "The location of the blocks directory of the node (absolute path or relative to the current directory)"
+  );
+  compact->add_option(
+    "--protocol-features-dir",
+    opt->compact_protocol_features_dir,
+    "The location of the protocol features directory of the node (absolute path or relative to the current directory)"
+  );
+  compact->add_option(
+    "--db-size",
+    opt->compact_db_size,
+    "Maximum size (in MiB) of the rebuilt state database, 0 keeps the size of the existing state file"
+  )->capture_default_str();
+  compact->add_option(
+    "--guard-size",
+    opt->compact_guard_size,
+    "Safety guard size (in MiB) of the rebuilt state database"
+  )->capture_default_str();
+  compact->callback(
+    [&] {
+      int rc = 0;
+      try {
+        rc = run_subcommand_compact();
+      } catch (...) {
+        print_exception();
+        rc = -1;
+      }
+      // properly return err code in main
+      if (rc) throw(CLI::RuntimeError(rc));
+    }
+  );
 }
 
 int chain_actions::run_subcommand_build_info() {
@@ -64,18 +115,7 @@ int chain_actions::run_subcommand_build_info() {
 }
 
 int chain_actions::run_subcommand_sstate() {
-  fs::path state_dir = "";
-
-  // default state dir, if none specified
-  if (opt->sstate_state_dir.empty()) {
-    state_dir = default_data_path() / config::default_state_dir_name;
-  } else {
-    // adjust if path relative
-    state_dir = opt->sstate_state_dir;
-    if (state_dir.is_relative()) {
-      state_dir = std::filesystem::current_path() / state_dir;
-    }
-  }
+  fs::path state_dir = resolve_dir(opt->sstate_state_dir, default_data_path() / config::default_state_dir_name);
 
   auto shared_mem_path = state_dir / "shared_memory.bin";
 
@@ -108,3 +148,34 @@ int chain_actions::run_subcommand_sstate() {
   std::cout << "Database state is clean" << std::endl;
   return 0;
 }
+
+int chain_actions::run_subcommand_compact() {
+  fs::path state_dir = resolve_dir(opt->sstate_state_dir, default_data_path() / config::default_state_dir_name);
+  fs::path blocks_dir = resolve_dir(opt->compact_blocks_dir, default_data_path() / config::default_blocks_dir_name);
+  fs::path protocol_features_dir = resolve_dir(opt->compact_protocol_features_dir, default_config_path() / "protocol_features");
+
+  auto shared_mem_path = state_dir / "shared_memory.bin";
+  if (!std::filesystem::exists(shared_mem_path)) {
+    std::cerr << "Unable to compact state: file not found: " << shared_mem_path << std::endl;
+    return -1;
+  }
+
+  auto chain_id = controller::extract_chain_id_from_db(state_dir);
+  if (!chain_id) {
+    std::cerr << "Unable to compact state: no chain id in " << state_dir << std::endl;
+    return -1;
+  }
+
+  controller::config cfg;
+  cfg.blocks_dir = blocks_dir;
+  cfg.state_dir = state_dir;
+  cfg.state_size = opt->compact_db_size ? opt->compact_db_size * 1024 * 1024 : std::filesystem::file_size(shared_mem_path);
+  cfg.state_guard_size = opt->compact_guard_size ? opt->compact_guard_size * 1024 * 1024 : config::default_state_guard_size;
+
+  auto result = compact_chain_state(cfg, protocol_features_dir, *chain_id);
+
+  std::cout << fc::json::to_pretty_string(result) << std::endl;
+  std::cout << "Reclaimable share of used bytes: " << result.before.fragmentation() * 100 << "% -> "
+            << result.after.fragmentation() * 100 << "%" << std::endl;
+  return 0;
+}
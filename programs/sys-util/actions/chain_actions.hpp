@@ -7,12 +7,16 @@
 struct chain_options {
   bool build_just_print = false;      ///< `build-info --print`: dump build environment JSON to stdout
   std::string build_output_file = ""; ///< `build-info --output-file`: write build environment JSON here
-  std::string sstate_state_dir = "";  ///< `--state-dir` override for `last-shutdown-state`
+  std::string sstate_state_dir = "";  ///< `--state-dir` override for `last-shutdown-state` and `compact`
+  std::string compact_blocks_dir = "";            ///< `compact --blocks-dir`: block log the state is checked against
+  std::string compact_protocol_features_dir = ""; ///< `compact --protocol-features-dir`
+  uint64_t compact_db_size = 0;                   ///< `compact --db-size` in MiB, 0 keeps the size of the existing state file
+  uint64_t compact_guard_size = 0;                ///< `compact --guard-size` in MiB
 };
 
 /**
- * sys-util `chain-state` diagnostics: build environment information and
- * last-shutdown (clean/dirty) database state detection.
+ * sys-util `chain-state` diagnostics: build environment information,
+ * last-shutdown (clean/dirty) database state detection and offline state compaction.
  */
 class chain_actions : public base_actions<chain_options> {
   public:
@@ -28,4 +32,7 @@ class chain_actions : public base_actions<chain_options> {
 
     /// `chain-state last-shutdown-state`: report whether the last shutdown was clean. Returns a process exit code.
     int run_subcommand_sstate();
+
+    /// `chain-state compact`: rebuild the state database into a fresh segment. Returns a process exit code.
+    int run_subcommand_compact();
 };
@@ -4,6 +4,7 @@
 #include <sysio/chain/config.hpp>
 #include <sysio/chain/controller.hpp>
 #include <sysio/chain/fork_database.hpp>
+#include <sysio/chain/snapshot_diff.hpp>
 
 #include <memory>
 
@@ -45,6 +46,19 @@ void snapshot_actions::setup(CLI::App& app) {
    to_json->add_option("--chain-id", opt->chain_id, "Specify a chain id in case it is not included in a snapshot or you want to override it.");
    to_json->add_option("--db-size", opt->db_size, "Maximum size (in MiB) of the chain state database")->capture_default_str();
    to_json->callback([err_guard]() {err_guard(&snapshot_actions::run_tojson);});
+
+   // subcommand - differential snapshots
+   auto diff = sub->add_subcommand("diff", "Write a differential snapshot of a snapshot against a base snapshot");
+   diff->add_option("--base,-b", opt->base_file, "Base snapshot file")->required();
+   diff->add_option("--input-file,-i", opt->input_file, "Snapshot file to diff against the base")->required();
+   diff->add_option("--output-file,-o", opt->output_file, "The differential snapshot file to write")->required();
+   diff->callback([err_guard]() {err_guard(&snapshot_actions::run_diff);});
+
+   auto apply_diff = sub->add_subcommand("apply-diff", "Reconstruct a full snapshot from a base snapshot and a chain of differential snapshots");
+   apply_diff->add_option("--base,-b", opt->base_file, "Base snapshot file")->required();
+   apply_diff->add_option("--diff,-d", opt->diff_files, "Differential snapshot file; repeat to apply a chain of diffs in order")->required();
+   apply_diff->add_option("--output-file,-o", opt->output_file, "The full snapshot file to write")->required();
+   apply_diff->callback([err_guard]() {err_guard(&snapshot_actions::run_apply_diff);});
 }
 
 int snapshot_actions::run_info() {
@@ -121,3 +135,16 @@ int snapshot_actions::run_tojson() {
    ilog("Completed writing snapshot: {}", json_path.string());
    return 0;
 }
+
+int snapshot_actions::run_diff() {
+   auto root_hash = create_snapshot_diff(opt->base_file, opt->input_file, opt->output_file);
+   ilog("Wrote differential snapshot {}, root hash {}", opt->output_file, root_hash.str());
+   return 0;
+}
+
+int snapshot_actions::run_apply_diff() {
+   std::vector<std::filesystem::path> diffs(opt->diff_files.begin(), opt->diff_files.end());
+   auto root_hash = apply_snapshot_diffs(opt->base_file, diffs, opt->output_file);
+   ilog("Wrote snapshot {}, root hash {}", opt->output_file, root_hash.str());
+   return 0;
+}
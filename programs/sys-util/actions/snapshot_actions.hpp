@@ -6,6 +6,8 @@ struct snapshot_options {
    uint64_t db_size = 65536ull;
    uint64_t guard_size = 1;
    std::string chain_id = "";
+   std::string base_file = "";
+   std::vector<std::string> diff_files;
 };
 
 class snapshot_actions : public base_actions<snapshot_options> {
@@ -16,4 +18,6 @@ public:
    // callbacks
    int run_info();
    int run_tojson();
+   int run_diff();
+   int run_apply_diff();
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <sysio/chain/authority.hpp>
 #include <sysio/chain/exceptions.hpp>
+#include <sysio/chain/pending_snapshot.hpp>
 #include <sysio/producer_plugin/producer_plugin.hpp>
 #include <sysio/testing/tester.hpp>
 
@@ -716,4 +717,43 @@ BOOST_AUTO_TEST_CASE(unscheduling_a_delivered_request_does_not_re_resolve_caller
    BOOST_TEST(f.scheduler.get_snapshot_requests().snapshot_requests.empty());
 }
 
+
+// A recurring request whose full snapshot went missing writes a new full one, and the following
+// differential snapshots are taken against that one rather than falling back to full every time.
+BOOST_AUTO_TEST_CASE(missing_diff_base_is_replaced) {
+   testing::tester            chain;
+   scheduler_callback_fixture f;
+
+   chain.produce_block();
+   chain.control->abort_block(); // snapshot creation requires no pending block
+   const uint32_t start_block_num = chain.control->head().block_num();
+
+   snapshot_request_information sri;
+   sri.block_spacing         = 1;
+   sri.start_block_num       = start_block_num;
+   sri.full_snapshot_spacing = 4;
+   sri.snapshot_description  = "recurring differential snapshots";
+   f.scheduler.schedule_snapshot(sri, {});
+
+   // runs the request at the next height and returns the pending snapshot it wrote
+   auto snapshot_next = [&](uint32_t i) {
+      chain.control->abort_block();
+      const auto head_id = chain.control->head().id();
+      f.scheduler.on_start_block(start_block_num + 1 + i, *chain.control);
+      chain.produce_block();
+      const auto full = pending_snapshot<snapshot_scheduler::snapshot_information>::get_pending_path(head_id, f.temp_dir.path(), "bin");
+      const auto diff = pending_snapshot<snapshot_scheduler::snapshot_information>::get_pending_path(head_id, f.temp_dir.path(), "diff");
+      BOOST_REQUIRE(fs::exists(full) != fs::exists(diff));
+      return fs::exists(full) ? full : diff;
+   };
+
+   const auto first = snapshot_next(0);
+   BOOST_TEST(first.extension() == ".bin");
+   BOOST_TEST(snapshot_next(1).extension() == ".diff");
+
+   fs::remove(first);
+   BOOST_TEST(snapshot_next(2).extension() == ".bin");
+   BOOST_TEST(snapshot_next(3).extension() == ".diff");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -812,4 +812,84 @@ BOOST_AUTO_TEST_CASE( authority_threshold_not_lowered ) { try {
    );
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( check_cache_follows_undo ) { try {
+   validating_tester chain;
+   chain.create_accounts( {"alice"_n} );
+   chain.produce_block();
+
+   const auto old_key = chain.get_public_key("alice"_n, "active");
+   const auto new_key = chain.get_public_key("alice"_n, "rotated");
+   auto& authz = chain.control->get_mutable_authorization_manager();
+   auto& db = chain.control->mutable_db();
+   const vector<action> actions{ action{ {{"alice"_n, config::active_name}}, config::system_account_name, "reqauth"_n, bytes{} } };
+
+   authz.check_authorization( actions, {old_key} );
+   BOOST_TEST( authz.check_cache().size() > 0u );
+   authz.check_authorization( actions, {old_key} ); // cached
+   BOOST_CHECK_THROW( authz.check_authorization( actions, {new_key} ), unsatisfied_authorization );
+   // a cached satisfied permission still reports the extra key as irrelevant
+   BOOST_CHECK_THROW( authz.check_authorization( actions, {old_key, new_key} ), tx_irrelevant_sig );
+
+   {
+      auto session = db.start_undo_session(true);
+      authz.modify_permission( authz.get_permission({"alice"_n, config::active_name}), authority(new_key), false );
+      BOOST_CHECK_THROW( authz.check_authorization( actions, {old_key} ), unsatisfied_authorization );
+      authz.check_authorization( actions, {new_key} ); // cached against the modified permission
+      session.undo();
+   }
+
+   // undoing the session that rotated the key must drop results cached against it
+   BOOST_CHECK_THROW( authz.check_authorization( actions, {new_key} ), unsatisfied_authorization );
+   authz.check_authorization( actions, {old_key} );
+
+   {
+      // a session that does not touch permissions keeps the cache across its undo
+      auto session = db.start_undo_session(true);
+      authz.check_authorization( actions, {old_key} );
+      const auto cached = authz.check_cache().size();
+      session.undo();
+      BOOST_TEST( authz.check_cache().size() == cached );
+   }
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( check_cache_follows_producer_schedule ) { try {
+   validating_tester chain;
+   const vector<account_name> old_producers{ "proda"_n, "prodb"_n, "prodc"_n };
+   const vector<account_name> new_producers{ "prodd"_n, "prode"_n, "prodf"_n };
+   chain.create_accounts( old_producers );
+   chain.create_accounts( new_producers );
+   chain.produce_block();
+
+   auto wait_for_schedule = [&]( const vector<account_name>& producers ) {
+      const auto expected = chain.get_producer_authorities( producers );
+      for( uint32_t i = 0; i < 100 && chain.control->active_producers().producers != expected; ++i )
+         chain.produce_block();
+      BOOST_REQUIRE( chain.control->active_producers().producers == expected );
+      chain.produce_block(); // sysio.prods is updated when the next block starts
+   };
+   auto provided = []( const vector<account_name>& producers ) {
+      flat_set<permission_level> levels;
+      for( auto p : producers )
+         levels.insert( {p, config::active_name} );
+      return levels;
+   };
+
+   chain.set_producers( old_producers );
+   wait_for_schedule( old_producers );
+
+   auto& authz = chain.control->get_mutable_authorization_manager();
+   const vector<action> actions{ action{ {{config::producers_account_name, config::active_name}}, config::system_account_name, "reqauth"_n, bytes{} } };
+
+   authz.check_authorization( actions, {}, provided(old_producers) );
+   BOOST_TEST( authz.check_cache().size() > 0u );
+   authz.check_authorization( actions, {}, provided(old_producers) ); // cached
+
+   chain.set_producers( new_producers );
+   wait_for_schedule( new_producers );
+
+   // the controller rewrites sysio.prods directly; results cached against the old schedule must be gone
+   BOOST_CHECK_THROW( authz.check_authorization( actions, {}, provided(old_producers) ), unsatisfied_authorization );
+   authz.check_authorization( actions, {}, provided(new_producers) );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
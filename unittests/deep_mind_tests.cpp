@@ -1,6 +1,8 @@
 #include <sysio/testing/tester.hpp>
 #include <fc/log/logger_config.hpp>
 #include <fc/io/cfile.hpp>
+#include <fc/crypto/hex.hpp>
+#include <fc/log/dmlog_binary_writer.hpp>
 #include <sysio/chain/deep_mind.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -43,16 +45,53 @@ struct deep_mind_log_fixture
    }
 };
 
+struct deep_mind_binary_log_fixture
+{
+   fc::temp_cfile tmp;
+   deep_mind_handler deep_mind_logger;
+
+   deep_mind_binary_log_fixture()
+   {
+      tmp.file().close();
+      deep_mind_logger.update_config(deep_mind_handler::deep_mind_config{.zero_elapsed = true});
+      deep_mind_logger.update_binary_writer(std::make_shared<fc::dmlog_binary_writer>(
+         tmp.file().get_file_path().string(), 1024 * 1024, fc::dmlog_binary_writer::full_policy::block));
+   }
+};
+
 // We only test deep-mind in Savanna
-struct deep_mind_tester : deep_mind_log_fixture, savanna_validating_tester
+template <typename LogFixture>
+struct basic_deep_mind_tester : LogFixture, savanna_validating_tester
 {
    // do not load roa, so test does not have to be updated everytime roa changes
-   deep_mind_tester() : savanna_validating_tester({}, &deep_mind_logger, setup_policy::preactivate_feature_only) {
+   basic_deep_mind_tester() : savanna_validating_tester({}, &this->deep_mind_logger, setup_policy::preactivate_feature_only) {
       set_bios_contract();
       produce_block();
    }
+
+   void run_scenario() {
+      // We have already transitioned into Savanna
+      create_account( "alice"_n );
+      push_action(config::system_account_name, "updateauth"_n, "alice"_n, fc::mutable_variant_object()
+                  ("account", "alice")
+                  ("permission", "test1")
+                  ("parent", "active")
+                  ("auth", authority{{"sysio"_n, "active"_n}}));
+      produce_block();
+
+      // Update proposer schedule
+      vector<account_name> producers = { "bob"_n, "carol"_n, "charlie"_n };
+      create_accounts(producers);
+      set_producers(producers);
+
+      // Produce 2 rounds to make the schedule active
+      produce_blocks(config::producer_repetitions * 2);
+   }
 };
 
+using deep_mind_tester        = basic_deep_mind_tester<deep_mind_log_fixture>;
+using deep_mind_binary_tester = basic_deep_mind_tester<deep_mind_binary_log_fixture>;
+
 namespace {
 
 void compare_files(const std::string& filename1, const std::string& filename2)
@@ -81,28 +120,58 @@ void compare_files(const std::string& filename1, const std::string& filename2)
    }
 }
 
+uint32_t read_u32(const std::string& data, size_t& pos)
+{
+   BOOST_REQUIRE_LE(pos + 4, data.size());
+   const auto* p = reinterpret_cast<const unsigned char*>(data.data() + pos);
+   pos += 4;
+   return uint32_t{p[0]} | uint32_t{p[1]} << 8 | uint32_t{p[2]} << 16 | uint32_t{p[3]} << 24;
+}
+
+std::string read_hex(const std::string& data, size_t& pos)
+{
+   const uint32_t size = read_u32(data, pos);
+   BOOST_REQUIRE_LE(pos + size, data.size());
+   pos += size;
+   return fc::to_hex(data.data() + pos - size, size);
+}
+
+// Render binary deep mind frames as the equivalent DMLOG text lines
+void binary_to_text(const std::filesystem::path& binary, const std::filesystem::path& text)
+{
+   std::ifstream in(binary, std::ios::binary);
+   const std::string data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+   std::ofstream out(text);
+
+   size_t pos = sizeof(fc::dmlog_binary_writer::magic) + 4;
+   BOOST_REQUIRE_LE(pos, data.size());
+   while (pos < data.size()) {
+      read_u32(data, pos); // frame size
+      const uint32_t text_size = read_u32(data, pos);
+      BOOST_REQUIRE_LE(pos + text_size, data.size());
+      const std::string line = data.substr(pos, text_size);
+      pos += text_size;
+      out << "DMLOG " << line;
+      const uint32_t blobs = read_u32(data, pos);
+      if (line.starts_with("KV_OP UPD")) {
+         BOOST_REQUIRE_EQUAL(blobs, 3u);
+         out << ' ' << read_hex(data, pos) << ' ' << read_hex(data, pos);
+         out << ':' << read_hex(data, pos);
+      } else {
+         for (uint32_t i = 0; i < blobs; ++i)
+            out << ' ' << read_hex(data, pos);
+      }
+      out << '\n';
+   }
+}
+
 } // namespace
 
 BOOST_AUTO_TEST_SUITE(deep_mind_tests)
 
 BOOST_FIXTURE_TEST_CASE(deep_mind, deep_mind_tester)
 {
-   // We have already transitioned into Savanna
-   create_account( "alice"_n );
-   push_action(config::system_account_name, "updateauth"_n, "alice"_n, fc::mutable_variant_object()
-               ("account", "alice")
-               ("permission", "test1")
-               ("parent", "active")
-               ("auth", authority{{"sysio"_n, "active"_n}}));
-   produce_block();
-
-   // Update proposer schedule
-   vector<account_name> producers = { "bob"_n, "carol"_n, "charlie"_n };
-   create_accounts(producers);
-   set_producers(producers);
-
-   // Produce 2 rounds to make the schedule active
-   produce_blocks(config::producer_repetitions * 2);
+   run_scenario();
 
    bool save_log = [](){
       auto argc = boost::unit_test::framework::master_test_suite().argc;
@@ -122,4 +191,18 @@ BOOST_FIXTURE_TEST_CASE(deep_mind, deep_mind_tester)
    }
 }
 
+// binary framed output carries the same events and payloads as the text log
+BOOST_FIXTURE_TEST_CASE(deep_mind_binary, deep_mind_binary_tester)
+{
+   run_scenario();
+
+   // dropping the writer flushes everything buffered
+   deep_mind_logger.update_binary_writer(nullptr);
+
+   fc::temp_cfile text;
+   text.file().close();
+   binary_to_text(tmp.file().get_file_path(), text.file().get_file_path());
+   compare_files(text.file().get_file_path().string(), DEEP_MIND_LOGFILE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
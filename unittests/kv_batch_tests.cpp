@@ -0,0 +1,293 @@
+// Contract-level tests of the KV_BATCH_INTRINSICS host functions, driven by kv_batch_wast.
+
+#include <boost/test/unit_test.hpp>
+#include <sysio/testing/tester.hpp>
+#include <sysio/chain/exceptions.hpp>
+#include <sysio/chain/resource_limits.hpp>
+#include <sysio/chain/kv_context.hpp>
+#include <sysio/chain/kv_table_objects.hpp>
+
+#include <test_wasts.hpp>
+
+#include <cstring>
+
+using namespace sysio;
+using namespace sysio::chain;
+using namespace sysio::testing;
+
+namespace {
+   const name batch_account = "kvbatch"_n;
+
+   constexpr int64_t KV_OVERHEAD = config::billable_size_v<kv_object>;
+
+   enum class batch_op : uint8_t { set, set_many, erase, erase_many, get_many, read_batch, read_batch_count };
+
+   // 4-byte big-endian row key, so rows iterate in numeric order
+   std::string key(uint32_t i) {
+      return {static_cast<char>(i >> 24), static_cast<char>(i >> 16), static_cast<char>(i >> 8), static_cast<char>(i)};
+   }
+
+   // Builds [u32 size][bytes] batches the way a contract packs them.
+   struct packer {
+      bytes buf;
+
+      packer& u32(uint32_t v) {
+         const char* p = reinterpret_cast<const char*>(&v);
+         buf.insert(buf.end(), p, p + sizeof(v));
+         return *this;
+      }
+      packer& raw(std::string_view s) {
+         buf.insert(buf.end(), s.begin(), s.end());
+         return *this;
+      }
+      packer& field(std::string_view s) { return u32(s.size()).raw(s); }
+      packer& row(std::string_view k, std::string_view v) { return field(k).field(v); }
+   };
+
+   template <typename T>
+   T read_at(const bytes& b, size_t pos) {
+      BOOST_REQUIRE_LE(pos + sizeof(T), b.size());
+      T v;
+      memcpy(&v, b.data() + pos, sizeof(T));
+      return v;
+   }
+
+   struct read_batch_result {
+      int32_t                                          rows = 0;
+      int32_t                                          status = 0;
+      std::string                                      current_key;
+      std::vector<std::pair<std::string, std::string>> copied;
+   };
+
+   struct kv_batch_tester : validating_tester {
+      kv_batch_tester() {
+         create_accounts({batch_account});
+         produce_block();
+         set_code(batch_account, kv_batch_wast);
+         produce_block();
+      }
+
+      bytes run(batch_op op, const bytes& payload) {
+         bytes data{static_cast<char>(op)};
+         data.insert(data.end(), payload.begin(), payload.end());
+         signed_transaction trx;
+         trx.actions.emplace_back(vector<permission_level>{{batch_account, config::active_name}},
+                                  batch_account, "run"_n, std::move(data));
+         set_transaction_headers(trx);
+         trx.sign(get_private_key(batch_account, "active"), control->get_chain_id());
+         auto trace = push_transaction(trx);
+         produce_block();
+         return trace->action_traces.at(0).return_value;
+      }
+
+      int64_t run_delta(batch_op op, const packer& p) {
+         auto r = run(op, p.buf);
+         BOOST_REQUIRE_EQUAL(r.size(), sizeof(int64_t));
+         return read_at<int64_t>(r, 0);
+      }
+
+      int64_t set(std::string_view k, std::string_view v) { return run_delta(batch_op::set, packer().row(k, v)); }
+      int64_t erase(std::string_view k)                   { return run_delta(batch_op::erase, packer().field(k)); }
+
+      read_batch_result read_batch(uint32_t max_rows, uint32_t dest_size, std::string_view prefix = {}) {
+         auto r = run(batch_op::read_batch, packer().u32(max_rows).u32(dest_size).raw(prefix).buf);
+         read_batch_result res{read_at<int32_t>(r, 0), read_at<int32_t>(r, 4)};
+         const uint32_t key_size = read_at<uint32_t>(r, 8);
+         BOOST_REQUIRE_EQUAL(r.size(), 12 + dest_size + key_size);
+         res.current_key.assign(r.data() + 12 + dest_size, key_size);
+         size_t pos = 12;
+         for (int32_t i = 0; i < res.rows; ++i) {
+            const auto ks = read_at<uint32_t>(r, pos);
+            std::string k(r.data() + pos + 4, ks);
+            pos += 4 + ks;
+            const auto vs = read_at<uint32_t>(r, pos);
+            std::string v(r.data() + pos + 4, vs);
+            pos += 4 + vs;
+            res.copied.emplace_back(std::move(k), std::move(v));
+         }
+         BOOST_REQUIRE_LE(pos, 12 + dest_size);
+         return res;
+      }
+
+      int64_t ram_usage() {
+         return control->get_resource_limits_manager().get_account_ram_usage(batch_account);
+      }
+   };
+}
+
+BOOST_AUTO_TEST_SUITE(kv_batch_tests)
+
+// kv_get_many writes whole entries up to the first that does not fit and always reports the full size
+BOOST_FIXTURE_TEST_CASE(get_many_short_dest, kv_batch_tester) try {
+   run_delta(batch_op::set_many, packer().row(key(1), "aa").row(key(2), "bbbb"));
+   const packer keys = packer().field(key(1)).field(key(3)).field(key(2));
+   const uint32_t required = (4 + 2) + 4 + (4 + 4);
+
+   auto get_many = [&](uint32_t dest_size) {
+      auto r = run(batch_op::get_many, packer().u32(dest_size).raw({keys.buf.data(), keys.buf.size()}).buf);
+      BOOST_REQUIRE_EQUAL(r.size(), 4 + dest_size);
+      BOOST_TEST(read_at<int32_t>(r, 0) == static_cast<int32_t>(required));
+      return bytes(r.begin() + 4, r.end());
+   };
+
+   auto full = get_many(required);
+   BOOST_TEST(read_at<int32_t>(full, 0) == 2);
+   BOOST_TEST(std::string(full.data() + 4, 2) == "aa");
+   BOOST_TEST(read_at<int32_t>(full, 6) == -1);
+   BOOST_TEST(read_at<int32_t>(full, 10) == 4);
+   BOOST_TEST(std::string(full.data() + 14, 4) == "bbbb");
+
+   // room for the first entry and part of the second: only the first is written
+   auto partial = get_many(8);
+   BOOST_TEST(read_at<int32_t>(partial, 0) == 2);
+   BOOST_TEST(std::string(partial.data() + 4, 2) == "aa");
+   BOOST_TEST(read_at<uint16_t>(partial, 6) == 0u);
+
+   // sizing call
+   get_many(0);
+} FC_LOG_AND_RETHROW()
+
+// a batch that is not a whole number of well-formed fields aborts the action and changes nothing
+BOOST_FIXTURE_TEST_CASE(malformed_batches_throw, kv_batch_tester) try {
+   run_delta(batch_op::set_many, packer().row(key(1), "v"));
+
+   // a key without its value
+   BOOST_CHECK_THROW(run(batch_op::set_many, packer().row(key(2), "v").field(key(3)).buf), kv_batch_malformed);
+   // a length prefix cut short
+   BOOST_CHECK_THROW(run(batch_op::set_many, packer().row(key(2), "v").raw(std::string_view("\x01\x00", 2)).buf), kv_batch_malformed);
+   // a field longer than what remains
+   BOOST_CHECK_THROW(run(batch_op::erase_many, packer().u32(10).raw("abc").buf), kv_batch_malformed);
+   BOOST_CHECK_THROW(run(batch_op::get_many, packer().u32(64).u32(5).raw(key(1)).buf), kv_batch_malformed);
+
+   // rows before the malformed one were rolled back with the action
+   auto r = run(batch_op::get_many, packer().u32(8).field(key(2)).buf);
+   BOOST_TEST(read_at<int32_t>(r, 4) == -1);
+
+   // erasing a missing key fails the whole batch
+   BOOST_CHECK_THROW(run(batch_op::erase_many, packer().field(key(1)).field(key(9)).buf), kv_key_not_found);
+   r = run(batch_op::get_many, packer().u32(8).field(key(1)).buf);
+   BOOST_TEST(read_at<int32_t>(r, 4) == 1);
+} FC_LOG_AND_RETHROW()
+
+// one call handles at most config::max_kv_batch_rows rows
+BOOST_FIXTURE_TEST_CASE(row_cap, kv_batch_tester) try {
+   const uint32_t cap = config::max_kv_batch_rows;
+   auto rows = [](uint32_t first, uint32_t n) {
+      packer p;
+      for (uint32_t i = first; i < first + n; ++i)
+         p.row(key(i), "");
+      return p;
+   };
+   auto keys = [](uint32_t first, uint32_t n) {
+      packer p;
+      for (uint32_t i = first; i < first + n; ++i)
+         p.field(key(i));
+      return p;
+   };
+
+   BOOST_CHECK_THROW(run(batch_op::set_many, rows(0, cap + 1).buf), kv_batch_malformed);
+   run_delta(batch_op::set_many, rows(0, cap));
+   run_delta(batch_op::set_many, rows(cap, 100));
+
+   const packer too_many_keys = keys(0, cap + 1);
+   BOOST_CHECK_THROW(run(batch_op::get_many, packer().u32(0).raw({too_many_keys.buf.data(), too_many_keys.buf.size()}).buf),
+                     kv_batch_malformed);
+   BOOST_CHECK_THROW(run(batch_op::erase_many, too_many_keys.buf), kv_batch_malformed);
+
+   // max_rows above the cap is clamped to it
+   auto r = run(batch_op::read_batch_count, packer().u32(cap * 2).u32(16 * 1024).buf);
+   BOOST_REQUIRE_EQUAL(r.size(), 12u);
+   BOOST_TEST(read_at<int32_t>(r, 0) == static_cast<int32_t>(cap));
+   BOOST_TEST(read_at<int32_t>(r, 4) == static_cast<int32_t>(kv_it_stat::iterator_ok));
+} FC_LOG_AND_RETHROW()
+
+// kv_set_many / kv_erase_many bill and refund exactly what the single-row intrinsics do
+BOOST_FIXTURE_TEST_CASE(billing_matches_single_row, kv_batch_tester) try {
+   const std::string v100(100, 'x'), v50(50, 'y'), v200(200, 'z'), v10(10, 'w');
+   const int64_t baseline = ram_usage();
+
+   // create
+   int64_t before = ram_usage();
+   const int64_t single_create = set(key(1), v100) + set(key(2), v50);
+   BOOST_TEST(ram_usage() - before == single_create);
+   BOOST_TEST(single_create == (4 + 100 + KV_OVERHEAD) + (4 + 50 + KV_OVERHEAD));
+
+   before = ram_usage();
+   const int64_t batch_create = run_delta(batch_op::set_many, packer().row(key(3), v100).row(key(4), v50));
+   BOOST_TEST(ram_usage() - before == batch_create);
+   BOOST_TEST(batch_create == single_create);
+
+   // grow one row and shrink the other
+   before = ram_usage();
+   const int64_t single_update = set(key(1), v200) + set(key(2), v10);
+   BOOST_TEST(ram_usage() - before == single_update);
+   BOOST_TEST(single_update == (200 - 100) + (10 - 50));
+
+   before = ram_usage();
+   const int64_t batch_update = run_delta(batch_op::set_many, packer().row(key(3), v200).row(key(4), v10));
+   BOOST_TEST(ram_usage() - before == batch_update);
+   BOOST_TEST(batch_update == single_update);
+
+   // erase
+   before = ram_usage();
+   const int64_t single_erase = erase(key(1)) + erase(key(2));
+   BOOST_TEST(ram_usage() - before == single_erase);
+
+   before = ram_usage();
+   const int64_t batch_erase = run_delta(batch_op::erase_many, packer().field(key(3)).field(key(4)));
+   BOOST_TEST(ram_usage() - before == batch_erase);
+   BOOST_TEST(batch_erase == single_erase);
+
+   BOOST_TEST(ram_usage() == baseline);
+} FC_LOG_AND_RETHROW()
+
+// kv_it_read_batch leaves the iterator on the first row it did not copy, or at the end of the prefix
+BOOST_FIXTURE_TEST_CASE(read_batch_positions_iterator, kv_batch_tester) try {
+   packer p;
+   for (uint32_t i = 1; i <= 5; ++i)
+      p.row(key(0x01000000 + i), "v" + std::to_string(i));
+   p.row(key(0x02000001), "w1");
+   run_delta(batch_op::set_many, p);
+   const uint32_t row_size = 4 + 4 + 4 + 2;
+
+   // stopped by max_rows
+   auto r = read_batch(2, 100);
+   BOOST_TEST(r.rows == 2);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_ok));
+   BOOST_REQUIRE_EQUAL(r.copied.size(), 2u);
+   BOOST_TEST(r.copied[0].first == key(0x01000001));
+   BOOST_TEST(r.copied[0].second == "v1");
+   BOOST_TEST(r.copied[1].first == key(0x01000002));
+   BOOST_TEST(r.current_key == key(0x01000003));
+
+   // stopped by dest: a row that does not fit whole is left for the next read
+   r = read_batch(10, 2 * row_size + 5);
+   BOOST_TEST(r.rows == 2);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_ok));
+   BOOST_TEST(r.current_key == key(0x01000003));
+
+   // max_rows == 0 copies nothing and leaves the iterator where it was
+   r = read_batch(0, 100);
+   BOOST_TEST(r.rows == 0);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_ok));
+   BOOST_TEST(r.current_key == key(0x01000001));
+
+   // the end of the prefix range puts the iterator in the end state
+   r = read_batch(10, 200, std::string(1, '\x01'));
+   BOOST_TEST(r.rows == 5);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_end));
+   BOOST_TEST(r.current_key.empty());
+   BOOST_TEST(r.copied.back().first == key(0x01000005));
+
+   // the end of the table too
+   r = read_batch(10, 200);
+   BOOST_TEST(r.rows == 6);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_end));
+
+   // an iterator that is not on a row copies nothing
+   r = read_batch(10, 200, std::string(1, '\x03'));
+   BOOST_TEST(r.rows == 0);
+   BOOST_TEST(r.status == static_cast<int32_t>(kv_it_stat::iterator_end));
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,207 @@
+#include <sysio/chain/kv_cold_store.hpp>
+#include <sysio/chain/exceptions.hpp>
+
+#include <chainbase/chainbase.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fc/filesystem.hpp>
+
+#include <string>
+
+using namespace sysio::chain;
+
+namespace {
+   constexpr uint32_t threshold = 64;
+
+   kv_cold_config test_config() {
+      kv_cold_config cfg;
+      cfg.value_threshold = threshold;
+      cfg.min_age_blocks  = 2;
+      cfg.spills_per_lib  = 16;
+      cfg.max_size        = 1024 * 1024;
+      return cfg;
+   }
+
+   struct cold_fixture {
+      fc::temp_directory  tmp_dir;
+      chainbase::database db{tmp_dir.path(), chainbase::database::read_write, 8 * 1024 * 1024, false,
+                             chainbase::pinnable_mapped_file::map_mode::heap};
+      kv_cold_store       store{db};
+
+      cold_fixture() {
+         db.add_index<kv_index>();
+         db.add_index<kv_cold_index>();
+         store.open(tmp_dir.path(), test_config(), false);
+      }
+
+      const kv_object& create(char k, const std::string& value) {
+         const auto& o = db.create<kv_object>([&](kv_object& r) {
+            r.code = "alice"_n;
+            r.key.assign(&k, 1);
+            r.value.assign(value.data(), value.size());
+         });
+         store.on_write(o, value.size());
+         return o;
+      }
+
+      // a block that changes nothing, to age the rows written so far
+      void empty_block() {
+         db.start_undo_session(true).push();
+      }
+   };
+}
+
+BOOST_AUTO_TEST_SUITE(kv_cold_store_tests)
+
+// large rows move to the file and read back unchanged; small and recently written rows stay in state
+BOOST_FIXTURE_TEST_CASE(spill_and_read_back, cold_fixture) {
+   const std::string big(200, 'b'), small(threshold - 1, 's');
+   const auto& big_row   = create('a', big);
+   const auto& small_row = create('b', small);
+   empty_block();
+
+   // not old enough yet
+   BOOST_TEST(store.spill(db.revision()) == 0u);
+
+   empty_block();
+   empty_block();
+   const auto& fresh_row = create('c', big);
+   BOOST_TEST(store.spill(db.revision()) == 1u);
+
+   BOOST_TEST(big_row.value.empty());
+   BOOST_TEST(kv_value(db, big_row) == big);
+   BOOST_TEST(kv_value_size(db, big_row) == big.size());
+   BOOST_TEST(kv_value(db, small_row) == small);
+   BOOST_TEST(fresh_row.value.size() == big.size());
+   BOOST_TEST(db.get_index<kv_cold_index>().indices().size() == 1u);
+}
+
+// spilling is undone with the block it happened in; writing a cold row brings its value back
+BOOST_FIXTURE_TEST_CASE(undo_and_rewrite, cold_fixture) {
+   const std::string big(200, 'b'), updated(100, 'u');
+   const auto& row = create('a', big);
+   for (int i = 0; i < 3; ++i)
+      empty_block();
+
+   {
+      auto block = db.start_undo_session(true);
+      BOOST_TEST(store.spill(db.revision()) == 1u);
+      block.push();
+   }
+   BOOST_TEST(row.value.empty());
+   db.undo();
+   BOOST_TEST(row.value.size() == big.size());
+   BOOST_TEST(db.get_index<kv_cold_index>().indices().empty());
+
+   BOOST_TEST(store.spill(db.revision()) == 1u);
+   {
+      auto trx = db.start_undo_session(true);
+      store.on_write(row, updated.size());
+      db.modify(row, [&](kv_object& r) { r.value.assign(updated.data(), updated.size()); });
+      BOOST_TEST(kv_value(db, row) == updated);
+      BOOST_TEST(db.get_index<kv_cold_index>().indices().empty());
+      trx.undo();
+   }
+   BOOST_TEST(kv_value(db, row) == big);
+
+   // written at the current block, so it is not spilled again until it ages
+   store.on_write(row, updated.size());
+   db.modify(row, [&](kv_object& r) { r.value.assign(updated.data(), updated.size()); });
+   BOOST_TEST(store.spill(db.revision()) == 0u);
+}
+
+// a removed row keeps its locator until the next spill; the file starts over once nothing is cold
+BOOST_FIXTURE_TEST_CASE(reap_and_reset, cold_fixture) {
+   const std::string big(200, 'b');
+   const auto& row = create('a', big);
+   for (int i = 0; i < 3; ++i)
+      empty_block();
+   BOOST_TEST(store.spill(db.revision()) == 1u);
+
+   // reopening keeps the values of the rows that are cold
+   store.close();
+   store.open(tmp_dir.path(), test_config(), false);
+   BOOST_TEST(kv_value(db, row) == big);
+   const auto cold_file = tmp_dir.path() / config::kv_cold_store_filename;
+   BOOST_TEST(std::filesystem::file_size(cold_file) > big.size());
+
+   db.remove(row);
+   BOOST_TEST(db.get_index<kv_cold_index>().indices().size() == 1u);
+   store.spill(db.revision());
+   BOOST_TEST(db.get_index<kv_cold_index>().indices().empty());
+
+   store.close();
+   store.open(tmp_dir.path(), test_config(), false);
+   BOOST_TEST(std::filesystem::file_size(cold_file) < big.size());
+}
+
+// rewritten values stay in the file as dead bytes; a full file stops spilling
+BOOST_FIXTURE_TEST_CASE(stats_report_dead_space, cold_fixture) {
+   const std::string big(200, 'b'), updated(threshold - 1, 'u');
+   const auto& row = create('a', big);
+   create('b', big);
+   for (int i = 0; i < 3; ++i)
+      empty_block();
+   BOOST_TEST(store.spill(db.revision()) == 2u);
+
+   auto st = store.stats();
+   BOOST_TEST(st.spilling);
+   BOOST_TEST(st.cold_rows == 2u);
+   BOOST_TEST(st.live_bytes == 2 * big.size());
+   BOOST_TEST(st.dead_bytes == 0u);
+
+   store.on_write(row, updated.size());
+   db.modify(row, [&](kv_object& r) { r.value.assign(updated.data(), updated.size()); });
+   st = store.stats();
+   BOOST_TEST(st.cold_rows == 1u);
+   BOOST_TEST(st.dead_bytes == big.size());
+
+   auto cfg = test_config();
+   cfg.max_size = st.file_size + big.size() / 2;
+   store.close();
+   store.open(tmp_dir.path(), cfg, false);
+   create('c', big);
+   for (int i = 0; i < 3; ++i)
+      empty_block();
+   BOOST_TEST(store.spill(db.revision()) == 0u);
+   st = store.stats();
+   BOOST_TEST(!st.spilling);
+   BOOST_TEST(st.dead_bytes == big.size());
+}
+
+// a file that does not hold the values the state refers to is refused
+BOOST_FIXTURE_TEST_CASE(foreign_file_is_refused, cold_fixture) {
+   create('a', std::string(200, 'b'));
+   for (int i = 0; i < 3; ++i)
+      empty_block();
+   BOOST_TEST(store.spill(db.revision()) == 1u);
+   store.close();
+
+   std::filesystem::resize_file(tmp_dir.path() / config::kv_cold_store_filename, 32);
+   BOOST_CHECK_THROW(store.open(tmp_dir.path(), test_config(), false), database_exception);
+   BOOST_TEST(!store.is_open());
+}
+
+// with spilling disabled and nothing cold the file is never created, and rows still read without a store
+BOOST_AUTO_TEST_CASE(disabled_store_stays_closed) {
+   fc::temp_directory  tmp_dir;
+   chainbase::database db{tmp_dir.path(), chainbase::database::read_write, 8 * 1024 * 1024, false,
+                          chainbase::pinnable_mapped_file::map_mode::heap};
+   db.add_index<kv_index>();
+   db.add_index<kv_cold_index>();
+   kv_cold_store store{db};
+   store.open(tmp_dir.path(), kv_cold_config{}, false);
+   BOOST_TEST(!store.is_open());
+   BOOST_TEST(!std::filesystem::exists(tmp_dir.path() / config::kv_cold_store_filename));
+
+   const auto& row = db.create<kv_object>([&](kv_object& r) {
+      r.code = "alice"_n;
+      r.key.assign("a", 1);
+   });
+   store.on_write(row, 0);
+   BOOST_TEST(kv_value(db, row).empty());
+   BOOST_TEST(kv_value_size(db, row) == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -438,11 +438,11 @@ BOOST_AUTO_TEST_CASE(kv_secondary_iterator_pool_invalidate_cache) {
    const int64_t target_id = 42;
    const int64_t other_id  = 99;
 
-   auto seed = [](kv_secondary_slot& s, int64_t id) {
+   auto seed = [&](kv_secondary_slot& s, int64_t id) {
       s.status = kv_it_stat::iterator_ok;
       s.current_sec_key.assign({'a','l','i','c','e'});
       s.current_pri_key.assign({'\x00','\x01'});
-      s.cached_id = id;
+      pool.set_cached_id(s, id);
    };
 
    seed(pool.get(h_sec),          target_id);
@@ -467,4 +467,99 @@ BOOST_AUTO_TEST_CASE(kv_secondary_iterator_pool_invalidate_cache) {
    BOOST_CHECK_EQUAL(pool.get(h_other_id).cached_id,    other_id);
 }
 
+// Several slots caching the same id, interleaved with releases and re-caching: invalidation must reach every live
+// match and nothing else, whatever the order the reverse-map links were built in.
+BOOST_AUTO_TEST_CASE(kv_secondary_iterator_pool_invalidate_shared_id) {
+   kv_secondary_iterator_pool pool;
+   const uint16_t tid = compute_table_id("users.byname");
+
+   std::vector<uint32_t> handles;
+   for (int i = 0; i < 6; ++i) {
+      handles.push_back(pool.allocate("test"_n, tid));
+      pool.set_cached_id(pool.get(handles.back()), 42);
+   }
+   pool.release(handles[0]);                          // list head
+   pool.release(handles[3]);                          // list middle
+   pool.set_cached_id(pool.get(handles[5]), 7);       // moved to another id
+   pool.set_cached_id(pool.get(handles[5]), 42);      // and back
+
+   pool.invalidate_cache("test"_n, tid, 42);
+   for (uint32_t h : {handles[1], handles[2], handles[4], handles[5]})
+      BOOST_CHECK_EQUAL(pool.get(h).cached_id, -1);
+
+   // The reverse map is empty again: re-caching and invalidating works from scratch.
+   pool.set_cached_id(pool.get(handles[1]), 42);
+   pool.invalidate_cache("test"_n, tid, 42);
+   BOOST_CHECK_EQUAL(pool.get(handles[1]).cached_id, -1);
+}
+
+// Handles are consensus-observable: allocation must always return the lowest free slot.
+BOOST_AUTO_TEST_CASE(kv_iterator_pool_allocates_lowest_free_slot) {
+   kv_primary_iterator_pool pool;
+   for (uint32_t i = 0; i < 200; ++i)
+      BOOST_CHECK_EQUAL(pool.allocate(uint16_t(0), "test"_n, "", 0), i);
+
+   pool.release(150);
+   pool.release(3);
+   pool.release(64);
+   BOOST_CHECK_EQUAL(pool.allocate(uint16_t(0), "test"_n, "", 0), 3u);
+   BOOST_CHECK_EQUAL(pool.allocate(uint16_t(0), "test"_n, "", 0), 64u);
+   BOOST_CHECK_EQUAL(pool.allocate(uint16_t(0), "test"_n, "", 0), 150u);
+   BOOST_CHECK_EQUAL(pool.allocate(uint16_t(0), "test"_n, "", 0), 200u);
+}
+
+// kv_lookup_cache only ever returns rows it was handed, and only for the exact (code, table_id, key) they carry.
+BOOST_AUTO_TEST_CASE(kv_lookup_cache_store_find_erase) {
+   validating_tester t( flat_set<account_name>(), nullptr, setup_policy::none );
+   auto& db = const_cast<chainbase::database&>(t.control->db());
+
+   auto session = db.start_undo_session(true);
+
+   auto make = [&](name code, uint16_t table_id, std::string_view key) -> const kv_object& {
+      return db.create<kv_object>([&](auto& o) {
+         o.code     = code;
+         o.table_id = table_id;
+         o.key.assign(key.data(), key.size());
+         o.value.assign("v", 1);
+      });
+   };
+   const auto& a = make("test"_n, 1, "alice");
+   const auto& b = make("test"_n, 2, "alice");
+   const auto& c = make("alt"_n,  1, "alice");
+
+   kv_lookup_cache cache;
+   BOOST_CHECK(!cache.find("test"_n, 1, "alice"));
+
+   cache.store(a);
+   cache.store(b);
+   BOOST_CHECK(cache.find("test"_n, 1, "alice") == &a);
+   BOOST_CHECK(cache.find("test"_n, 2, "alice") == &b);
+   BOOST_CHECK(!cache.find("alt"_n, 1, "alice"));
+   BOOST_CHECK(!cache.find("test"_n, 1, "alic"));
+
+   cache.store(c);
+   cache.store(a); // re-store is idempotent
+   BOOST_CHECK(cache.find("alt"_n, 1, "alice") == &c);
+
+   cache.erase(a);
+   BOOST_CHECK(!cache.find("test"_n, 1, "alice"));
+   BOOST_CHECK(cache.find("test"_n, 2, "alice") == &b);
+
+   // Overfill: evicted rows turn into misses, never into wrong rows.
+   std::vector<const kv_object*> rows;
+   for (uint32_t i = 0; i < kv_lookup_cache::capacity * 2; ++i) {
+      rows.push_back(&make("fill"_n, 0, std::to_string(i)));
+      cache.store(*rows.back());
+   }
+   for (uint32_t i = 0; i < rows.size(); ++i) {
+      const kv_object* hit = cache.find("fill"_n, 0, std::to_string(i));
+      BOOST_CHECK(!hit || hit == rows[i]);
+   }
+
+   cache.clear();
+   BOOST_CHECK(!cache.find("test"_n, 2, "alice"));
+
+   session.undo();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
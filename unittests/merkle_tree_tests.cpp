@@ -146,4 +146,38 @@ BOOST_AUTO_TEST_CASE(async_matches_sequential_and_is_reproducible) {
    }
 }
 
+// merkle_chunk_precompute hashes aligned chunks while the sequence grows; its
+// root must be byte-identical to calculate_merkle over the final sequence for
+// every length, including after truncation (block restore points) drops chunks.
+BOOST_AUTO_TEST_CASE(chunk_precompute_matches_calculate_merkle) {
+   constexpr size_t chunk = merkle_chunk_precompute::chunk_size;
+   const std::vector<digest_type> all = create_test_digests(5 * chunk + 3);
+
+   const std::vector<size_t> sizes = {
+      0, 1, 2, 3, chunk - 1, chunk, chunk + 1, 2 * chunk, 2 * chunk + 1, 3 * chunk, 4 * chunk - 1, 5 * chunk + 3
+   };
+   for (size_t n : sizes) {
+      digests_t digests;
+      merkle_chunk_precompute pre;
+      for (size_t i = 0; i < n; ++i) {
+         digests.push_back(all[i]);
+         if (i % 100 == 0 || i + 1 == n)
+            pre.update(digests);
+      }
+      BOOST_CHECK_MESSAGE(pre.root(digests) == calculate_merkle(digests),
+         "chunk precompute diverged from calculate_merkle at size " << n);
+   }
+
+   // grow past several chunks, roll back into the middle of a chunk, then grow with different digests
+   digests_t digests(all.begin(), all.begin() + 3 * chunk + 10);
+   merkle_chunk_precompute pre;
+   pre.update(digests);
+   digests.resize(chunk + 5);
+   pre.truncate(digests.size());
+   for (size_t i = 0; i < 2 * chunk; ++i)
+      digests.push_back(fc::sha256::hash(std::string{"Other"} + std::to_string(i)));
+   pre.update(digests);
+   BOOST_CHECK(pre.root(digests) == calculate_merkle(digests));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,3 +1,4 @@
+#include <fstream>
 #include <sstream>
 
 #include <sysio/chain/block_log.hpp>
@@ -615,4 +616,35 @@ BOOST_AUTO_TEST_CASE(test_blocklog_split_then_merge) {
    BOOST_CHECK(std::filesystem::exists(dest_dir.path() / "blocks-101-150.index"));
 }
 
+BOOST_AUTO_TEST_CASE(test_blocklog_full_validate) {
+   sysio::testing::tester chain;
+   chain.produce_blocks(100-chain.last_irreversible_block_num());
+   chain.close();
+
+   fc::temp_directory temp_dir;
+   std::filesystem::copy(chain.get_config().blocks_dir / "blocks.log", temp_dir.path() / "blocks.log");
+   std::filesystem::copy(chain.get_config().blocks_dir / "blocks.index", temp_dir.path() / "blocks.index");
+
+   const auto num_blocks = std::filesystem::file_size(temp_dir.path() / "blocks.index") / sizeof(uint64_t);
+   // single range, several ranges, and more threads than blocks
+   for (uint32_t threads : {1u, 4u, 1000u})
+      BOOST_CHECK_EQUAL(signed_block_log::full_validate(temp_dir.path(), threads), num_blocks);
+
+   // corrupt the trailing position of a block in the middle of the log
+   uint64_t next_pos = 0;
+   {
+      std::ifstream index(temp_dir.path() / "blocks.index", std::ios::binary);
+      index.seekg((num_blocks / 2) * sizeof(uint64_t));
+      index.read(reinterpret_cast<char*>(&next_pos), sizeof(next_pos));
+   }
+   {
+      std::fstream log(temp_dir.path() / "blocks.log", std::ios::binary | std::ios::in | std::ios::out);
+      const uint64_t bogus = 1;
+      log.seekp(next_pos - sizeof(uint64_t));
+      log.write(reinterpret_cast<const char*>(&bogus), sizeof(bogus));
+   }
+   BOOST_CHECK_THROW(signed_block_log::full_validate(temp_dir.path(), 4), sysio::chain::block_log_exception);
+   BOOST_CHECK_NO_THROW(signed_block_log::smoke_test(temp_dir.path(), 1)); // sampling only reads block numbers
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,7 @@
 #include <sysio/chain/abi_serializer.hpp>
 #include <sysio/chain/global_property_object.hpp>
+#include <sysio/chain/protocol_state_object.hpp>
+#include <sysio/chain/whitelisted_intrinsics.hpp>
 #include <sysio/chain/resource_limits.hpp>
 #include <sysio/testing/tester.hpp>
 
@@ -96,6 +98,32 @@ BOOST_AUTO_TEST_CASE( activate_protocol_feature ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_AUTO_TEST_CASE( activate_kv_batch_intrinsics ) try {
+   tester c( setup_policy::none );
+   const auto& pfm = c.control->get_protocol_feature_manager();
+
+   auto d = pfm.get_builtin_digest( builtin_protocol_feature_t::kv_batch_intrinsics );
+   BOOST_REQUIRE( d );
+
+   c.set_bios_contract();
+   c.produce_block();
+
+   const std::vector<std::string_view> batch_intrinsics = { "kv_get_many", "kv_set_many", "kv_erase_many", "kv_it_read_batch" };
+   auto whitelisted = [&]() -> const whitelisted_intrinsics_type& {
+      return c.control->db().get<protocol_state_object>().whitelisted_intrinsics;
+   };
+   for( auto n : batch_intrinsics )
+      BOOST_CHECK( !is_intrinsic_whitelisted( whitelisted(), n ) );
+
+   c.preactivate_protocol_features( {*d} );
+   c.produce_block();
+
+   BOOST_CHECK( c.control->is_builtin_activated( builtin_protocol_feature_t::kv_batch_intrinsics ) );
+   for( auto n : batch_intrinsics )
+      BOOST_CHECK( is_intrinsic_whitelisted( whitelisted(), n ) );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_CASE( activate_and_restart ) try {
    tester c( setup_policy::none );
    const auto& pfm = c.control->get_protocol_feature_manager();
@@ -5,6 +5,8 @@
 #include <sysio/chain/global_property_object.hpp>
 #include <sysio/chain/permission_object.hpp>
 #include <sysio/chain/snapshot.hpp>
+#include <sysio/chain/snapshot_diff.hpp>
+#include <sysio/chain/streaming_snapshot.hpp>
 #include <sysio/chain/s_root_extension.hpp>
 #include <sysio/chain/contract_table_objects.hpp>
 #include <sysio/testing/tester.hpp>
@@ -186,6 +188,119 @@ BOOST_AUTO_TEST_CASE(threaded_snapshot_requires_full_section_consumption)
    }
 }
 
+// A differential snapshot applied to its base must reproduce a snapshot with the target's root hash
+// (the reconstructed file lays sections out in index order, so only the hashes are comparable), and
+// must refuse any other base.
+BOOST_AUTO_TEST_CASE(differential_snapshot_roundtrip)
+{
+   fc::temp_directory tmp_dir;
+   const auto dir = tmp_dir.path();
+   tester chain;
+
+   auto write_full = [&](const std::filesystem::path& p) {
+      chain.control->abort_block();
+      auto writer = std::make_shared<threaded_snapshot_writer>(p);
+      chain.control->write_snapshot(writer);
+      writer->finalize();
+      return writer->get_root_hash();
+   };
+
+   chain.create_accounts({"alice"_n, "bob"_n});
+   chain.produce_block();
+   const auto base_hash = write_full(dir / "base.bin");
+
+   chain.create_accounts({"carol"_n});
+   chain.produce_block();
+   const auto mid_hash = write_full(dir / "mid.bin");
+
+   chain.create_accounts({"dave"_n});
+   chain.produce_block();
+   const auto target_hash = write_full(dir / "target.bin");
+
+   // written straight from the controller against the base
+   {
+      chain.control->abort_block();
+      auto writer = std::make_shared<differential_snapshot_writer>(dir / "mid.diff",
+                                                                   std::make_shared<threaded_snapshot_reader>(dir / "base.bin"));
+      chain.control->write_snapshot(writer);
+      writer->finalize();
+      BOOST_CHECK_EQUAL(writer->get_base_root_hash().str(), base_hash.str());
+      BOOST_CHECK_GT(writer->copied_bytes(), 0u);
+   }
+   BOOST_CHECK_EQUAL(create_snapshot_diff(dir / "mid.bin", dir / "target.bin", dir / "target.diff").str(), target_hash.str());
+
+   BOOST_CHECK_EQUAL(apply_snapshot_diff(dir / "base.bin", dir / "mid.diff", dir / "mid_applied.bin").str(), mid_hash.str());
+
+   BOOST_CHECK_EQUAL(apply_snapshot_diffs(dir / "base.bin", {dir / "mid.diff", dir / "target.diff"}, dir / "target_applied.bin").str(),
+                     target_hash.str());
+   threaded_snapshot_reader applied(dir / "target_applied.bin"); // validates every section hash
+   BOOST_CHECK_EQUAL(applied.get_root_hash().str(), target_hash.str());
+
+   BOOST_CHECK_THROW(apply_snapshot_diff(dir / "mid.bin", dir / "mid.diff", dir / "wrong_base.bin"), snapshot_exception);
+   BOOST_CHECK_THROW(apply_snapshot_diffs(dir / "base.bin", {dir / "target.diff"}, dir / "wrong_chain.bin"), snapshot_exception);
+}
+
+// A snapshot loaded while its sections are still being fetched (small chunks, several threads) must
+// produce the same state as the source chain, and a corrupted section or wrong root hash must fail.
+BOOST_AUTO_TEST_CASE(streaming_snapshot_load)
+{
+   fc::temp_directory tmp_dir;
+   const auto dir = tmp_dir.path();
+   tester chain;
+   chain.create_accounts({"alice"_n, "bob"_n});
+   chain.produce_block();
+   chain.control->abort_block();
+
+   fc::crypto::blake3 root_hash;
+   {
+      auto writer = std::make_shared<threaded_snapshot_writer>(dir / "source.bin");
+      chain.control->write_snapshot(writer);
+      writer->finalize();
+      root_hash = writer->get_root_hash();
+   }
+
+   {
+      streaming_snapshot_fetcher fetcher(std::make_shared<file_snapshot_range_source>(dir / "source.bin"),
+                                         dir / "streamed.bin", root_hash, 4, 4096);
+      fetcher.start();
+      snapshotted_tester snap_chain(chain.get_config(), fetcher.reader(), 0);
+      BOOST_REQUIRE_EQUAL(chain.control->calculate_integrity_hash().str(), snap_chain.control->calculate_integrity_hash().str());
+      fetcher.wait_all();
+      BOOST_CHECK_EQUAL(fetcher.fetched_bytes(), std::filesystem::file_size(dir / "source.bin"));
+   }
+   BOOST_CHECK_EQUAL(threaded_snapshot_reader(dir / "streamed.bin").get_root_hash().str(), root_hash.str());
+
+   // wrong expected root hash: rejected from the index alone, and the partial file is removed
+   {
+      streaming_snapshot_fetcher fetcher(std::make_shared<file_snapshot_range_source>(dir / "source.bin"),
+                                         dir / "wrong_root.bin", blake3_encoder::hash("x", 1), 4, 4096);
+      BOOST_CHECK_THROW(fetcher.start(), snapshot_exception);
+      BOOST_CHECK(!fetcher.reader());
+      BOOST_CHECK(!std::filesystem::exists(dir / "wrong_root.bin"));
+   }
+   BOOST_CHECK(!std::filesystem::exists(dir / "wrong_root.bin"));
+
+   // flip a byte inside the largest section of a copy
+   std::filesystem::copy_file(dir / "source.bin", dir / "corrupt.bin");
+   {
+      threaded_snapshot_reader reader(dir / "source.bin");
+      auto largest = std::ranges::max_element(reader.sections(), {}, &snapshot_section_entry::data_size);
+      std::fstream f(dir / "corrupt.bin", std::ios::in | std::ios::out | std::ios::binary);
+      f.seekg(largest->data_offset);
+      char c = 0;
+      f.read(&c, 1);
+      c = static_cast<char>(c ^ 0xff);
+      f.seekp(largest->data_offset);
+      f.write(&c, 1);
+   }
+   {
+      streaming_snapshot_fetcher fetcher(std::make_shared<file_snapshot_range_source>(dir / "corrupt.bin"),
+                                         dir / "corrupt_streamed.bin", root_hash, 4, 4096);
+      fetcher.start();
+      BOOST_CHECK_THROW(fetcher.wait_all(), snapshot_exception);
+   }
+}
+
 template<typename TESTER, typename SNAPSHOT_SUITE>
 void exhaustive_snapshot_test()
 {
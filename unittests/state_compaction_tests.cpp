@@ -0,0 +1,49 @@
+#include <sysio/chain/state_compaction.hpp>
+#include <sysio/testing/tester.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(state_compaction_tests)
+
+using namespace sysio::testing;
+using namespace sysio::chain;
+
+BOOST_AUTO_TEST_CASE(compact_existing_state) try {
+   tester chain;
+   chain.create_accounts({"compact1"_n, "compact2"_n, "compact3"_n});
+   chain.produce_blocks(10);
+   // rows created in a reversible block, which compaction pops and the restarted node applies again
+   chain.create_accounts({"compact5"_n});
+   chain.produce_block();
+
+   const auto head_block_num = chain.head().block_num();
+   const auto lib_block_num  = chain.last_irreversible_block_num();
+   BOOST_REQUIRE(head_block_num > lib_block_num);
+   const auto integrity_hash = chain.control->calculate_integrity_hash();
+   chain.close();
+
+   const controller::config cfg = chain.get_config();
+   const auto chain_id = controller::extract_chain_id_from_db(cfg.state_dir);
+   BOOST_REQUIRE(chain_id);
+
+   fc::temp_directory protocol_features_dir;
+   const auto result = compact_chain_state(cfg, protocol_features_dir.path(), *chain_id);
+
+   // the snapshot is taken at the fork database root, reversible blocks are applied again on load
+   BOOST_TEST(result.head_block_num == lib_block_num);
+   BOOST_TEST(result.after.row_count == result.before.row_count);
+   BOOST_TEST(result.after.row_count > 0u);
+   BOOST_TEST(result.after.reclaimable_bytes <= result.before.reclaimable_bytes);
+   BOOST_TEST(!std::filesystem::exists(cfg.state_dir.parent_path() / (cfg.state_dir.filename().string() + ".compact")));
+
+   chain.open();
+   BOOST_TEST(chain.head().block_num() == head_block_num);
+   BOOST_TEST(chain.control->calculate_integrity_hash() == integrity_hash);
+   BOOST_REQUIRE_NO_THROW(chain.get_account("compact5"_n));
+
+   chain.create_account("compact4"_n);
+   chain.produce_blocks(2);
+   BOOST_REQUIRE_NO_THROW(chain.get_account("compact4"_n));
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1081,4 +1081,76 @@ static const char small_memcpy_high_wast[] = R"=====(
       (drop (call $memcpy (i32.const 4294967295) (i32.const 4294967200) (i32.const 8)))
    )
 )
-)=====";
\ No newline at end of file
+)=====";
+// Drives the KV_BATCH_INTRINSICS host functions. Action data is [u8 op][payload], read to offset 256; results
+// are returned through set_action_return_value from offset 32768. Table 1 of the receiver, billed to it.
+//   0 kv_set         [u32 klen][key][u32 vlen][value]       -> i64 RAM delta
+//   1 kv_set_many    packed rows                            -> i64 RAM delta
+//   2 kv_erase       [u32 klen][key]                        -> i64 RAM delta
+//   3 kv_erase_many  packed keys                            -> i64 RAM delta
+//   4 kv_get_many    [u32 dest size][packed keys]           -> [i32 result][dest]
+//   5 kv_it_read_batch [u32 max rows][u32 dest size][prefix] -> [i32 rows][i32 status][u32 key size][dest][key]
+//   6 as 5, returning only [i32 rows][i32 status][u32 key size]
+static const char kv_batch_wast[] = R"=====(
+(module
+ (import "env" "action_data_size" (func $action_data_size (result i32)))
+ (import "env" "read_action_data" (func $read_action_data (param i32 i32) (result i32)))
+ (import "env" "set_action_return_value" (func $set_action_return_value (param i32 i32)))
+ (import "env" "kv_set" (func $kv_set (param i32 i64 i32 i32 i32 i32) (result i64)))
+ (import "env" "kv_erase" (func $kv_erase (param i32 i32 i32) (result i64)))
+ (import "env" "kv_set_many" (func $kv_set_many (param i32 i64 i32 i32) (result i64)))
+ (import "env" "kv_erase_many" (func $kv_erase_many (param i32 i32 i32) (result i64)))
+ (import "env" "kv_get_many" (func $kv_get_many (param i32 i64 i32 i32 i32 i32) (result i32)))
+ (import "env" "kv_it_create" (func $kv_it_create (param i32 i64 i32 i32) (result i32)))
+ (import "env" "kv_it_status" (func $kv_it_status (param i32) (result i32)))
+ (import "env" "kv_it_key" (func $kv_it_key (param i32 i32 i32 i32 i32) (result i32)))
+ (import "env" "kv_it_read_batch" (func $kv_it_read_batch (param i32 i32 i32 i32) (result i32)))
+ (memory 2)
+ (export "apply" (func $apply))
+ (func $apply (param $receiver i64) (param $code i64) (param $action i64)
+  (local $len i32) (local $op i32) (local $klen i32) (local $dest_size i32) (local $it i32)
+  (set_local $len (i32.sub (call $action_data_size) (i32.const 1)))
+  (drop (call $read_action_data (i32.const 256) (i32.add (get_local $len) (i32.const 1))))
+  (set_local $op (i32.load8_u (i32.const 256)))
+  (if (i32.eq (get_local $op) (i32.const 0)) (then
+   (set_local $klen (i32.load (i32.const 257)))
+   (i64.store (i32.const 32768)
+    (call $kv_set (i32.const 1) (get_local $receiver) (i32.const 261) (get_local $klen)
+                  (i32.add (i32.const 265) (get_local $klen)) (i32.load (i32.add (i32.const 261) (get_local $klen)))))
+   (call $set_action_return_value (i32.const 32768) (i32.const 8))
+  ))
+  (if (i32.eq (get_local $op) (i32.const 1)) (then
+   (i64.store (i32.const 32768) (call $kv_set_many (i32.const 1) (get_local $receiver) (i32.const 257) (get_local $len)))
+   (call $set_action_return_value (i32.const 32768) (i32.const 8))
+  ))
+  (if (i32.eq (get_local $op) (i32.const 2)) (then
+   (i64.store (i32.const 32768) (call $kv_erase (i32.const 1) (i32.const 261) (i32.load (i32.const 257))))
+   (call $set_action_return_value (i32.const 32768) (i32.const 8))
+  ))
+  (if (i32.eq (get_local $op) (i32.const 3)) (then
+   (i64.store (i32.const 32768) (call $kv_erase_many (i32.const 1) (i32.const 257) (get_local $len)))
+   (call $set_action_return_value (i32.const 32768) (i32.const 8))
+  ))
+  (if (i32.eq (get_local $op) (i32.const 4)) (then
+   (set_local $dest_size (i32.load (i32.const 257)))
+   (i32.store (i32.const 32768)
+    (call $kv_get_many (i32.const 1) (get_local $receiver) (i32.const 261) (i32.sub (get_local $len) (i32.const 4))
+                       (i32.const 32772) (get_local $dest_size)))
+   (call $set_action_return_value (i32.const 32768) (i32.add (i32.const 4) (get_local $dest_size)))
+  ))
+  (if (i32.ge_u (get_local $op) (i32.const 5)) (then
+   (set_local $dest_size (i32.load (i32.const 261)))
+   (set_local $it (call $kv_it_create (i32.const 1) (get_local $receiver) (i32.const 265) (i32.sub (get_local $len) (i32.const 8))))
+   (i32.store (i32.const 32768)
+    (call $kv_it_read_batch (get_local $it) (i32.load (i32.const 257)) (i32.const 32780) (get_local $dest_size)))
+   (i32.store (i32.const 32772) (call $kv_it_status (get_local $it)))
+   (drop (call $kv_it_key (get_local $it) (i32.const 0) (i32.add (i32.const 32780) (get_local $dest_size))
+                          (i32.const 256) (i32.const 32776)))
+   (call $set_action_return_value (i32.const 32768)
+    (select (i32.add (i32.add (i32.const 12) (get_local $dest_size)) (i32.load (i32.const 32776)))
+            (i32.const 12)
+            (i32.eq (get_local $op) (i32.const 5))))
+  ))
+ )
+)
+)=====";
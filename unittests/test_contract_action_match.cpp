@@ -147,4 +147,52 @@ BOOST_AUTO_TEST_CASE(malformed_contract_names) {
       BOOST_CHECK(matcher.is_action_match("aaaaaaaaaaaaa"_n));
    }
 
+BOOST_AUTO_TEST_CASE(compiled_matcher) {
+   using mt = contract_action_match::match_type;
+   std::vector<contract_action_match> matches;
+   matches.emplace_back("r1"_n, "sysio"_n, mt::exact);
+   matches.back().add_action("newaccount"_n, mt::exact);
+   matches.emplace_back("r2"_n, "sysio"_n, mt::prefix);
+   matches.back().add_action("set"_n, mt::prefix);
+   matches.emplace_back("r3"_n, "token"_n, mt::suffix);
+   matches.back().add_action(""_n, mt::any);
+   matches.emplace_back("r4"_n, "sysio"_n, mt::exact);
+   matches.back().add_action(""_n, mt::any);
+
+   const std::vector<contract_action_match> linear = matches;
+   contract_action_matcher matcher(std::move(matches));
+
+   const std::vector<name> contracts = { "sysio"_n, "sysio.token"_n, "sysio.msig"_n, "a.token"_n, "token"_n, "other"_n, "tokens"_n };
+   const std::vector<name> actions   = { "newaccount"_n, "setcode"_n, "set.abi"_n, "transfer"_n, ""_n };
+   // every pair twice, so the second lookup is served from the memo
+   for (int pass = 0; pass < 2; ++pass) {
+      for (const auto& c : contracts) {
+         for (const auto& a : actions) {
+            const contract_action_match* expected = nullptr;
+            for (const auto& m : linear) {
+               if (m.is_contract_match(c) && m.is_action_match(a)) {
+                  expected = &m;
+                  break;
+               }
+            }
+            const auto* found = matcher.find(c, a);
+            BOOST_TEST_CONTEXT(c.to_string() << "::" << a.to_string()) {
+               BOOST_REQUIRE_EQUAL(!!found, !!expected);
+               if (found)
+                  BOOST_CHECK_EQUAL(found->root_name, expected->root_name);
+            }
+         }
+      }
+   }
+
+   BOOST_CHECK_EQUAL(matcher.find("sysio"_n, "newaccount"_n)->root_name, "r1"_n);
+   BOOST_CHECK_EQUAL(matcher.find("sysio"_n, "transfer"_n)->root_name, "r4"_n);
+   BOOST_CHECK_EQUAL(matcher.find("sysio.msig"_n, "set.abi"_n)->root_name, "r2"_n);
+   BOOST_CHECK_EQUAL(matcher.find("a.token"_n, "transfer"_n)->root_name, "r3"_n);
+   BOOST_CHECK(!matcher.find("tokens"_n, "transfer"_n));
+
+   contract_action_matcher empty(std::vector<contract_action_match>{});
+   BOOST_CHECK(!empty.find("sysio"_n, "newaccount"_n));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -96,7 +96,7 @@ auto create_test_block_state(const block_state_ptr& prev) {
 
    auto bsp = std::make_shared<block_state>(bhs,
       deque<transaction_metadata_ptr>{},
-      deque<transaction_receipt>{},
+      vector<transaction_receipt>{},
       std::optional<valid_t>{},
       std::optional<qc_t>{},
       signer,
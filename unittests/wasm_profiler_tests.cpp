@@ -0,0 +1,128 @@
+#include <sysio/chain/wasm_profiler.hpp>
+#include <sysio/testing/tester.hpp>
+#ifdef SYSIO_SYS_VM_OC_RUNTIME_ENABLED
+#include <sysio/chain/webassembly/sys-vm-oc/ipc_helpers.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+using namespace sysio::chain;
+using namespace sysio::testing;
+
+namespace {
+   // (module
+   //   (import "env" "f" (func))
+   //   (func $apply) (func $helper (call 0))
+   //   + "name" section naming function 1 "apply" and 2 "helper")
+   const std::vector<char> named_module = {
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+      0x01, 0x04, 0x01, 0x60, 0x00, 0x00,                                     // type
+      0x02, 0x09, 0x01, 0x03, 'e', 'n', 'v', 0x01, 'f', 0x00, 0x00,           // import
+      0x03, 0x03, 0x02, 0x00, 0x00,                                           // function
+      0x0a, 0x09, 0x02, 0x02, 0x00, 0x0b, 0x04, 0x00, 0x10, 0x00, 0x0b,       // code
+      0x00, 0x17, 0x04, 'n', 'a', 'm', 'e', 0x01, 0x10, 0x02,                 // name
+      0x01, 0x05, 'a', 'p', 'p', 'l', 'y', 0x02, 0x06, 'h', 'e', 'l', 'p', 'e', 'r'
+   };
+
+   // a contract of function_count functions whose apply calls the last one
+   std::string many_functions_wast(uint32_t function_count) {
+      std::string wast = "(module\n"
+                         " (export \"apply\" (func $apply))\n"
+                         " (func $apply (param i64 i64 i64) (call $f" + std::to_string(function_count - 2) + "))\n";
+      for (uint32_t i = 0; i + 1 < function_count; ++i)
+         wast += " (func $f" + std::to_string(i) + ")\n";
+      return wast + ")";
+   }
+}
+
+BOOST_AUTO_TEST_SUITE(wasm_profiler_tests)
+
+BOOST_AUTO_TEST_CASE(function_table_parse) {
+   auto table = wasm_profiler::function_table::parse(named_module);
+   BOOST_TEST(table.imported_functions == 1u);
+   BOOST_REQUIRE_EQUAL(table.bodies.size(), 2u);
+
+   // first body is bytes [34, 36), second [37, 41)
+   BOOST_TEST(table.function_at(34) == std::optional<uint32_t>(0));
+   BOOST_TEST(table.function_at(35) == std::optional<uint32_t>(0));
+   BOOST_TEST(!table.function_at(36)); // size byte of the second body
+   BOOST_TEST(table.function_at(38) == std::optional<uint32_t>(1));
+   BOOST_TEST(!table.function_at(41));
+   BOOST_TEST(!table.function_at(0));
+
+   BOOST_TEST(table.name_of(0) == "apply");
+   BOOST_TEST(table.name_of(1) == "helper");
+   BOOST_TEST(table.name_of(5) == "f6");
+}
+
+BOOST_AUTO_TEST_CASE(function_table_parse_truncated) {
+   // cut inside the name section: bodies are known, names are not
+   std::vector<char> truncated(named_module.begin(), named_module.end() - 10);
+   auto table = wasm_profiler::function_table::parse(truncated);
+   BOOST_TEST(table.bodies.size() == 2u);
+   BOOST_TEST(table.name_of(1) == "f2");
+
+   // cut inside the header
+   auto empty = wasm_profiler::function_table::parse(std::span<const char>(named_module.data(), 6));
+   BOOST_TEST(empty.bodies.empty());
+   BOOST_TEST(!empty.function_at(34));
+}
+
+BOOST_AUTO_TEST_CASE(collapsed_output) {
+   wasm_profiler::code_entry code;
+   code.code_hash    = digest_type::hash(std::string("code"));
+   code.accounts     = {"alice"_n, "bob"_n};
+   code.samples      = 10;
+   code.host_samples = 3;
+   code.functions    = {{1, "apply", 5}, {2, "ns::f(int, char)", 2}};
+
+   const std::string hash = code.code_hash.str().substr(0, 16);
+   BOOST_TEST(wasm_profiler::collapsed({code}) ==
+              "alice,bob@" + hash + ";apply 5\n" +
+              "alice,bob@" + hash + ";ns::f(int,_char) 2\n" +
+              "alice,bob@" + hash + ";[host] 3\n");
+   BOOST_TEST(wasm_profiler::collapsed({}).empty());
+}
+
+// Compiling, running and profiling a contract far larger than the offsets of its functions would fit in an
+// OC datagram; the offsets are passed to the compile monitor as an fd.
+BOOST_AUTO_TEST_CASE(profiled_module_with_many_functions) { try {
+   constexpr uint32_t function_count = 5000;
+   const name account = "manyfuncs"_n;
+   fc::temp_directory tempdir;
+   validating_tester chain(tempdir, [&](controller::config& cfg) { cfg.wasm_profile_accounts = {account}; }, true);
+   chain.create_accounts({account});
+   chain.set_code(account, many_functions_wast(function_count).c_str());
+   chain.produce_block();
+
+   signed_transaction trx;
+   trx.actions.emplace_back(std::vector<permission_level>{{account, config::active_name}}, account, "run"_n, bytes{});
+   chain.set_transaction_headers(trx);
+   trx.sign(chain.get_private_key(account, "active"), chain.control->get_chain_id());
+   chain.push_transaction(trx);
+   chain.produce_block();
+
+   wasm_profiler* profiler = chain.control->get_wasm_profiler();
+   BOOST_REQUIRE(profiler);
+   for (const auto& code : profiler->report(chain.control->db()))
+      for (const auto& f : code.functions)
+         BOOST_TEST(f.function_index < function_count);
+} FC_LOG_AND_RETHROW() }
+
+#ifdef SYSIO_SYS_VM_OC_RUNTIME_ENABLED
+// OC messages carry no per-function data, so a compile result and a full eviction batch fit a datagram
+BOOST_AUTO_TEST_CASE(oc_messages_fit_a_datagram) {
+   sysvmoc::code_descriptor cd{};
+   cd.start = sysvmoc::code_offset{};
+   cd.function_count = 5000;
+
+   sysvmoc::wasm_compilation_result_message result{.result = cd};
+   BOOST_TEST(fc::raw::pack_size(sysvmoc::sysvmoc_message{result}) <= sysvmoc::max_message_size);
+
+   // as many descriptors as code_cache_base::run_eviction_round() sends at once
+   sysvmoc::evict_wasms_message evict{std::vector<sysvmoc::code_descriptor>(25, cd)};
+   BOOST_TEST(fc::raw::pack_size(sysvmoc::sysvmoc_message{evict}) <= sysvmoc::max_message_size);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()